@@ -1,3 +1,5 @@
 option(TACTMON_BUILD "Compile tactmon" OFF)
+option(TACTMON_BUILD_TOOLS "Compile development tools (tactmon-fakecdn, tactmon-mkfixtures, tactmon-load)" OFF)
+option(TACTMON_BUILD_BENCHMARKS "Compile the libtactmon benchmarks (libtactmon-bench)" OFF)
 option(TACTMON_ENABLE_ADDRESS_SANITIZER "Enable ASan" OFF)
 option(BUILD_SHARED_LIBS "Builds libtactmon as a shared library." OFF)
@@ -10,6 +10,8 @@ message("")
 
 message("* Install to               : ${CMAKE_INSTALL_PREFIX}")
 message("* Build tactmon            : ${TACTMON_BUILD}")
+message("* Build tools              : ${TACTMON_BUILD_TOOLS}")
+message("* Build benchmarks         : ${TACTMON_BUILD_BENCHMARKS}")
 if (BUILD_SHARED_LIBS)
   message("* Build type for libtactmon: SHARED")
 else ()
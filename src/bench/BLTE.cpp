@@ -0,0 +1,81 @@
+#include "Fixtures.hpp"
+#include "Memory.hpp"
+
+#include <algorithm>
+#include <span>
+
+#include <benchmark/benchmark.h>
+
+#include <fixtures/BLTEWriter.hpp>
+
+#include <libtactmon/io/MemoryStream.hpp>
+#include <libtactmon/tact/BLTE.hpp>
+#include <libtactmon/tact/BLTEDecoder.hpp>
+
+namespace bench {
+    namespace {
+        constexpr const std::size_t ContentSize = 4 * 1024 * 1024;
+
+        //! Size of the pieces fed to the streaming decoder; that of a typical network read.
+        constexpr const std::size_t FeedSize = 64 * 1024;
+
+        fixtures::EncodedFile const& Archive(int64_t mode, int64_t chunkSize) {
+            return Cached([](int64_t mode, int64_t chunkSize) {
+                return fixtures::BLTEWriter::Encode(Contents(ContentSize), fixtures::BLTEOptions {
+                    .ChunkSize = static_cast<std::size_t>(chunkSize),
+                    .Mode = static_cast<fixtures::ChunkMode>(mode)
+                });
+            }, mode, chunkSize);
+        }
+
+        void Arguments(benchmark::internal::Benchmark* benchmark) {
+            benchmark->ArgNames({ "mode", "chunk" })
+                ->ArgsProduct({
+                    { static_cast<int64_t>(fixtures::ChunkMode::None), static_cast<int64_t>(fixtures::ChunkMode::Zlib) },
+                    { 4 << 10, 64 << 10, 256 << 10, 1 << 20 }
+                });
+        }
+    }
+
+    void BM_BLTE_Parse(benchmark::State& state) {
+        fixtures::EncodedFile const& archive = Archive(state.range(0), state.range(1));
+
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            libtactmon::io::SpanStream stream { AsBytes(archive.Data) };
+            std::optional<libtactmon::tact::BLTE> blte = libtactmon::tact::BLTE::Parse(stream);
+            if (!blte.has_value())
+                state.SkipWithError("BLTE::Parse failed");
+
+            benchmark::DoNotOptimize(blte);
+        }
+
+        state.SetBytesProcessed(state.iterations() * ContentSize);
+    }
+    BENCHMARK(BM_BLTE_Parse)->Apply(Arguments);
+
+    void BM_BLTEDecoder_Feed(benchmark::State& state) {
+        fixtures::EncodedFile const& archive = Archive(state.range(0), state.range(1));
+        std::span<const std::byte> data = AsBytes(archive.Data);
+
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            std::size_t decodedSize = 0;
+            libtactmon::tact::BLTEDecoder decoder { [&](std::span<const uint8_t> output) {
+                decodedSize += output.size();
+                return true;
+            } };
+
+            for (std::size_t offset = 0; offset < data.size(); offset += FeedSize)
+                decoder.Feed(data.subspan(offset, std::min(FeedSize, data.size() - offset)));
+
+            if (!decoder.Finish())
+                state.SkipWithError("BLTEDecoder::Finish failed");
+
+            benchmark::DoNotOptimize(decodedSize);
+        }
+
+        state.SetBytesProcessed(state.iterations() * ContentSize);
+    }
+    BENCHMARK(BM_BLTEDecoder_Feed)->Apply(Arguments);
+}
@@ -0,0 +1,79 @@
+#include "Fixtures.hpp"
+#include "Memory.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <fixtures/EncodingWriter.hpp>
+
+#include <libtactmon/io/MemoryStream.hpp>
+#include <libtactmon/tact/CKey.hpp>
+#include <libtactmon/tact/data/Encoding.hpp>
+
+namespace bench {
+    namespace {
+        /**
+         * A decoded encoding manifest, and the content keys it lists.
+         */
+        struct EncodingFixture {
+            std::vector<uint8_t> Data;
+            std::vector<fixtures::Key> ContentKeys;
+        };
+
+        EncodingFixture const& Manifest(int64_t entryCount) {
+            return Cached([](int64_t entryCount) {
+                EncodingFixture fixture;
+                fixture.ContentKeys = Keys(entryCount, 1);
+
+                std::vector<fixtures::Key> encodingKeys = Keys(entryCount, 2);
+
+                fixtures::EncodingWriter writer;
+                writer.AddSpec("z");
+                writer.Reserve(entryCount);
+                for (std::size_t i = 0; i < fixture.ContentKeys.size(); ++i)
+                    writer.Add({ fixture.ContentKeys[i], encodingKeys[i], 4096 + i, 2048 + i, 0 });
+
+                fixture.Data = writer.Write();
+                return fixture;
+            }, entryCount);
+        }
+    }
+
+    void BM_Encoding_Construct(benchmark::State& state) {
+        EncodingFixture const& fixture = Manifest(state.range(0));
+
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            libtactmon::io::SpanStream stream { AsBytes(fixture.Data) };
+            libtactmon::tact::data::Encoding encoding { stream };
+            benchmark::DoNotOptimize(encoding);
+        }
+
+        state.SetBytesProcessed(state.iterations() * fixture.Data.size());
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_Encoding_Construct)->ArgName("entries")->Arg(10'000)->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+
+    void BM_Encoding_FindFile(benchmark::State& state) {
+        EncodingFixture const& fixture = Manifest(state.range(0));
+
+        libtactmon::io::SpanStream stream { AsBytes(fixture.Data) };
+        libtactmon::tact::data::Encoding encoding { stream };
+
+        std::vector<libtactmon::tact::CKey> needles;
+        for (std::size_t i = 0; i < 1024; ++i)
+            needles.emplace_back(fixture.ContentKeys[(i * 7919) % fixture.ContentKeys.size()]);
+
+        std::size_t i = 0;
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            auto location = encoding.FindFile(needles[i++ % needles.size()]);
+            if (!location.has_value())
+                state.SkipWithError("Encoding::FindFile failed");
+
+            benchmark::DoNotOptimize(location);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_Encoding_FindFile)->ArgName("entries")->Arg(10'000)->Arg(100'000)->Arg(1'000'000);
+}
@@ -0,0 +1,30 @@
+#include "Fixtures.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace bench {
+    std::vector<uint8_t> Contents(std::size_t size, uint64_t seed) {
+        std::vector<uint8_t> data(size);
+
+        std::mt19937_64 engine { seed };
+        for (std::size_t i = 0; i < data.size(); i += sizeof(uint64_t)) {
+            uint64_t word = engine() & 0x0F0F0F0F0F0F0F0FuLL;
+            std::memcpy(data.data() + i, &word, std::min(sizeof(uint64_t), data.size() - i));
+        }
+
+        return data;
+    }
+
+    std::vector<fixtures::Key> Keys(std::size_t count, uint64_t seed) {
+        std::vector<fixtures::Key> keys(count);
+
+        std::mt19937_64 engine { seed };
+        for (std::size_t i = 0; i < count; ++i) {
+            uint64_t words[2] = { engine(), engine() };
+            std::memcpy(keys[i].data(), words, sizeof(words));
+        }
+
+        return keys;
+    }
+}
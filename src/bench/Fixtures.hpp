@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <random>
+#include <span>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <fixtures/Types.hpp>
+
+namespace bench {
+    /**
+     * Builds an input once per set of arguments, and keeps it for every later run of the benchmark.
+     *
+     * Every call site has its own cache, because every lambda has its own type.
+     */
+    template <typename Factory, typename... Args>
+    auto const& Cached(Factory factory, Args... args) {
+        using T = std::invoke_result_t<Factory, Args...>;
+
+        static std::map<std::tuple<Args...>, T> cache;
+        auto [itr, inserted] = cache.try_emplace(std::tuple { args... });
+        if (inserted)
+            itr->second = factory(args...);
+
+        return itr->second;
+    }
+
+    /**
+     * Returns deterministic bytes that deflate to roughly half their size.
+     */
+    std::vector<uint8_t> Contents(std::size_t size, uint64_t seed = 0);
+
+    /**
+     * Returns deterministic random keys.
+     */
+    std::vector<fixtures::Key> Keys(std::size_t count, uint64_t seed = 0);
+
+    inline std::span<const std::byte> AsBytes(std::vector<uint8_t> const& data) {
+        return std::as_bytes(std::span { data });
+    }
+}
@@ -0,0 +1,181 @@
+#include "Fixtures.hpp"
+#include "Memory.hpp"
+
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <boost/asio/thread_pool.hpp>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+#include <spdlog/logger.h>
+
+#include <fixtures/Generator.hpp>
+#include <fixtures/IndexWriter.hpp>
+
+#include <libtactmon/io/MemoryStream.hpp>
+#include <libtactmon/ribbit/types/CDNs.hpp>
+#include <libtactmon/tact/Cache.hpp>
+#include <libtactmon/tact/EKey.hpp>
+#include <libtactmon/tact/data/Index.hpp>
+#include <libtactmon/tact/data/product/wow/Product.hpp>
+
+namespace bench {
+    namespace {
+        //! Amount of files of each archive, when benchmarking lookups over several archives.
+        constexpr const std::size_t ArchiveEntryCount = 1'000;
+
+        /**
+         * An encoded archive index, and the encoding keys it lists.
+         */
+        struct IndexFixture {
+            fixtures::NamedFile File;
+            std::vector<fixtures::Key> EncodingKeys;
+        };
+
+        IndexFixture const& ArchiveIndex(int64_t entryCount) {
+            return Cached([](int64_t entryCount) {
+                IndexFixture fixture;
+                fixture.EncodingKeys = Keys(entryCount, 3);
+
+                fixtures::IndexWriter writer;
+                writer.Reserve(entryCount);
+
+                uint64_t offset = 0;
+                for (fixtures::Key const& encodingKey : fixture.EncodingKeys) {
+                    writer.Add(encodingKey, 4096, offset);
+                    offset += 4096;
+                }
+
+                fixture.File = writer.Write();
+                return fixture;
+            }, entryCount);
+        }
+
+        /**
+         * A product loaded offline from a generated build, and the encoding keys of archived files of that build.
+         */
+        struct ProductFixture {
+            explicit ProductFixture(std::filesystem::path const& root)
+                : Cache(root), Product("wow", Cache, ThreadPool.get_executor(), nullptr)
+            { }
+
+            boost::asio::thread_pool ThreadPool { 2 };
+            libtactmon::tact::Cache Cache;
+            libtactmon::tact::data::product::wow::Product Product;
+
+            std::vector<libtactmon::tact::EKey> EncodingKeys;
+        };
+
+        std::unique_ptr<ProductFixture> const& Build(int64_t archiveCount) {
+            return Cached([](int64_t archiveCount) -> std::unique_ptr<ProductFixture> {
+                std::filesystem::path root = std::filesystem::temp_directory_path() / fmt::format("libtactmon-bench-{}", archiveCount);
+                std::filesystem::remove_all(root);
+
+                // Files are spread over archives in turn; four of them per archive are sampled.
+                std::size_t sampleCount = archiveCount * 4;
+
+                spdlog::logger logger { "bench" };
+                std::optional<fixtures::Generator::Result> result = fixtures::Generator::Generate(libtactmon::tact::Cache { root }, fixtures::Generator::Options {
+                    .FileCount = archiveCount * ArchiveEntryCount,
+                    .MaterializedFileCount = sampleCount,
+                    .LooseFileCount = 0,
+                    .ArchiveCount = static_cast<std::size_t>(archiveCount),
+                    .InstallFileCount = 0,
+                    .MinFileSize = 64,
+                    .MaxFileSize = 256,
+                    .LookupCount = sampleCount
+                }, logger);
+
+                auto fixture = std::make_unique<ProductFixture>(root);
+                fixture->Product.SetCDNs({ libtactmon::ribbit::types::cdns::Record { .Name = "us", .Path = "tpr/wow" } });
+                if (!result.has_value() || !fixture->Product.Load(result->BuildConfig, result->CDNConfig))
+                    return nullptr;
+
+                for (std::string_view lookup : result->Lookups) {
+                    libtactmon::tact::EKey encodingKey;
+                    if (lookup.starts_with("ekey ") && libtactmon::tact::EKey::TryParse(lookup.substr(5), encodingKey))
+                        fixture->EncodingKeys.push_back(std::move(encodingKey));
+                }
+
+                // Everything the benchmark needs is in memory.
+                std::filesystem::remove_all(root);
+                return fixture;
+            }, archiveCount);
+        }
+
+        libtactmon::tact::data::Index Load(fixtures::NamedFile const& file) {
+            libtactmon::io::SpanStream stream { AsBytes(file.Data) };
+            return libtactmon::tact::data::Index { file.Name, stream };
+        }
+
+        /**
+         * Returns a sample of the keys of an index, visited in an order unrelated to that of the index.
+         */
+        std::vector<libtactmon::tact::EKey> Needles(IndexFixture const& fixture) {
+            std::vector<libtactmon::tact::EKey> needles;
+            for (std::size_t i = 0; i < 1024; ++i)
+                needles.emplace_back(fixture.EncodingKeys[(i * 7919) % fixture.EncodingKeys.size()]);
+
+            return needles;
+        }
+    }
+
+    void BM_Index_Construct(benchmark::State& state) {
+        fixtures::NamedFile const& file = ArchiveIndex(state.range(0)).File;
+
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            libtactmon::tact::data::Index index = Load(file);
+            benchmark::DoNotOptimize(index);
+        }
+
+        state.SetBytesProcessed(state.iterations() * file.Data.size());
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_Index_Construct)->ArgName("entries")->Arg(1'000)->Arg(10'000)->Arg(100'000);
+
+    void BM_Index_Find(benchmark::State& state) {
+        IndexFixture const& fixture = ArchiveIndex(state.range(0));
+        libtactmon::tact::data::Index index = Load(fixture.File);
+        std::vector<libtactmon::tact::EKey> needles = Needles(fixture);
+
+        std::size_t i = 0;
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            libtactmon::tact::data::Index::Entry const* entry = index[needles[i++ % needles.size()]];
+            if (entry == nullptr)
+                state.SkipWithError("Index::operator[] failed");
+
+            benchmark::DoNotOptimize(entry);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_Index_Find)->ArgName("entries")->Arg(1'000)->Arg(10'000)->Arg(100'000);
+
+    void BM_FindArchive(benchmark::State& state) {
+        std::unique_ptr<ProductFixture> const& fixture = Build(state.range(0));
+        if (fixture == nullptr) {
+            state.SkipWithError("Unable to load the generated build");
+            return;
+        }
+
+        std::size_t i = 0;
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            auto location = fixture->Product.FindArchive(fixture->EncodingKeys[i++ % fixture->EncodingKeys.size()]);
+            if (!location.has_value())
+                state.SkipWithError("Product::FindArchive failed");
+
+            benchmark::DoNotOptimize(location);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_FindArchive)->ArgName("archives")->Arg(16)->Arg(256)->Arg(2048);
+}
@@ -0,0 +1,95 @@
+#include "Fixtures.hpp"
+#include "Memory.hpp"
+
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <fixtures/InstallWriter.hpp>
+
+#include <libtactmon/io/MemoryStream.hpp>
+#include <libtactmon/tact/data/Install.hpp>
+
+namespace bench {
+    namespace {
+        /**
+         * An encoded install manifest, with tags of three types like those of the clients: platforms, architectures
+         * and locales.
+         */
+        struct InstallFixture {
+            std::vector<uint8_t> Data;
+            std::vector<std::string> Paths;
+        };
+
+        InstallFixture const& Manifest(int64_t fileCount) {
+            return Cached([](int64_t fileCount) {
+                constexpr const std::pair<std::string_view, uint16_t> Tags[] = {
+                    { "Windows", 1 }, { "OSX", 1 },
+                    { "x86_32", 2 }, { "x86_64", 2 }, { "arm64", 2 },
+                    { "enUS", 3 }, { "deDE", 3 }, { "frFR", 3 }
+                };
+
+                fixtures::InstallWriter writer;
+                for (auto [name, type] : Tags)
+                    writer.AddTag(std::string { name }, type);
+
+                std::vector<fixtures::Key> contentKeys = Keys(fileCount, 5);
+
+                InstallFixture fixture;
+                for (int64_t i = 0; i < fileCount; ++i) {
+                    std::string& path = fixture.Paths.emplace_back(fmt::format("Data\\Install\\File{:06}.dat", i));
+
+                    std::size_t file = writer.AddFile(path, contentKeys[i], static_cast<uint32_t>(1024 + i));
+                    writer.Tag(i % 2, file);
+                    writer.Tag(2 + i % 3, file);
+                    writer.Tag(5 + i % 3, file);
+                }
+
+                fixture.Data = writer.Write();
+                return fixture;
+            }, fileCount);
+        }
+    }
+
+    void BM_Install_Parse(benchmark::State& state) {
+        InstallFixture const& fixture = Manifest(state.range(0));
+
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            libtactmon::io::SpanStream stream { AsBytes(fixture.Data) };
+            std::optional<libtactmon::tact::data::Install> install = libtactmon::tact::data::Install::Parse(stream);
+            if (!install.has_value())
+                state.SkipWithError("Install::Parse failed");
+
+            benchmark::DoNotOptimize(install);
+        }
+
+        state.SetBytesProcessed(state.iterations() * fixture.Data.size());
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_Install_Parse)->ArgName("files")->Arg(1'000)->Arg(10'000);
+
+    void BM_Install_FindFile(benchmark::State& state) {
+        InstallFixture const& fixture = Manifest(state.range(0));
+
+        libtactmon::io::SpanStream stream { AsBytes(fixture.Data) };
+        libtactmon::tact::data::Install install = libtactmon::tact::data::Install::Parse(stream).value();
+
+        std::size_t i = 0;
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            auto contentKey = install.FindFile(fixture.Paths[(i++ * 7919) % fixture.Paths.size()]);
+            if (!contentKey.has_value())
+                state.SkipWithError("Install::FindFile failed");
+
+            benchmark::DoNotOptimize(contentKey);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_Install_FindFile)->ArgName("files")->Arg(1'000)->Arg(10'000);
+}
@@ -0,0 +1,16 @@
+#include "Memory.hpp"
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+        return 1;
+
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+
+    fmt::print("Peak resident set size: {:.1f} MiB\n", bench::PeakResidentSetSize() / (1024.0 * 1024.0));
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include "Memory.hpp"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+#if defined(_WIN32)
+# include <Windows.h>
+# include <Psapi.h>
+#else
+# include <sys/resource.h>
+#endif
+
+namespace {
+    std::atomic<uint64_t> Allocations { 0 };
+
+    void* Allocate(std::size_t size) {
+        Allocations.fetch_add(1, std::memory_order_relaxed);
+
+        if (void* pointer = std::malloc(size == 0 ? 1 : size); pointer != nullptr)
+            return pointer;
+
+        throw std::bad_alloc { };
+    }
+
+    void* AllocateAligned(std::size_t size, std::align_val_t alignment) {
+        Allocations.fetch_add(1, std::memory_order_relaxed);
+
+        std::size_t align = static_cast<std::size_t>(alignment);
+#if defined(_WIN32)
+        void* pointer = _aligned_malloc(size == 0 ? 1 : size, align);
+#else
+        // aligned_alloc requires the size to be a multiple of the alignment.
+        void* pointer = std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+        if (pointer != nullptr)
+            return pointer;
+
+        throw std::bad_alloc { };
+    }
+
+    void FreeAligned(void* pointer) noexcept {
+#if defined(_WIN32)
+        _aligned_free(pointer);
+#else
+        std::free(pointer);
+#endif
+    }
+}
+
+// Every allocation of the process, libtactmon's included, goes through these.
+void* operator new(std::size_t size) { return Allocate(size); }
+void* operator new[](std::size_t size) { return Allocate(size); }
+void* operator new(std::size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return AllocateAligned(size, alignment); }
+
+void* operator new(std::size_t size, std::nothrow_t const&) noexcept {
+    try { return Allocate(size); } catch (std::bad_alloc const&) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, std::nothrow_t const&) noexcept {
+    try { return Allocate(size); } catch (std::bad_alloc const&) { return nullptr; }
+}
+
+void operator delete(void* pointer) noexcept { std::free(pointer); }
+void operator delete[](void* pointer) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete[](void* pointer, std::size_t) noexcept { std::free(pointer); }
+void operator delete(void* pointer, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete[](void* pointer, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete(void* pointer, std::size_t, std::align_val_t) noexcept { FreeAligned(pointer); }
+void operator delete[](void* pointer, std::size_t, std::align_val_t) noexcept { FreeAligned(pointer); }
+
+namespace bench {
+    uint64_t AllocationCount() {
+        return Allocations.load(std::memory_order_relaxed);
+    }
+
+    uint64_t PeakResidentSetSize() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters { };
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return 0;
+
+        return counters.PeakWorkingSetSize;
+#else
+        rusage usage { };
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+
+# if defined(__APPLE__)
+        return static_cast<uint64_t>(usage.ru_maxrss);
+# else
+        return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+# endif
+#endif
+    }
+
+    MemoryCounters::MemoryCounters(benchmark::State& state) : _state(state), _allocationCount(AllocationCount()) { }
+
+    MemoryCounters::~MemoryCounters() {
+        _state.counters["allocs/op"] = benchmark::Counter(static_cast<double>(AllocationCount() - _allocationCount),
+            benchmark::Counter::kAvgIterations);
+        _state.counters["peak_rss"] = benchmark::Counter(static_cast<double>(PeakResidentSetSize()),
+            benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+    }
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstdint>
+
+#include <benchmark/benchmark.h>
+
+namespace bench {
+    /**
+     * Returns the amount of heap allocations made by the process so far.
+     */
+    uint64_t AllocationCount();
+
+    /**
+     * Returns the peak resident set size of the process, in bytes.
+     */
+    uint64_t PeakResidentSetSize();
+
+    /**
+     * Reports the amount of heap allocations per iteration, and the peak resident set size of the process, once the
+     * benchmark loop completed.
+     *
+     * Construct it right before the loop so that allocations made during setup are not accounted for.
+     */
+    struct MemoryCounters final {
+        explicit MemoryCounters(benchmark::State& state);
+        ~MemoryCounters();
+
+        MemoryCounters(MemoryCounters const&) = delete;
+        MemoryCounters& operator = (MemoryCounters const&) = delete;
+
+    private:
+        benchmark::State& _state;
+        uint64_t _allocationCount;
+    };
+}
@@ -0,0 +1,88 @@
+#include "Memory.hpp"
+
+#include <optional>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <libtactmon/ribbit/Commands.hpp>
+#include <libtactmon/ribbit/PSV.hpp>
+
+namespace bench {
+    namespace {
+        namespace ribbit = libtactmon::ribbit;
+
+        /**
+         * Returns a versions table with the given amount of regions.
+         */
+        std::string VersionsTable(int64_t rowCount) {
+            std::string table = "Region!STRING:0|BuildConfig!HEX:16|CDNConfig!HEX:16|KeyRing!HEX:16|BuildId!DEC:4|VersionsName!String:0|ProductConfig!HEX:16\n"
+                "## seqn = 2241282\n";
+
+            for (int64_t i = 0; i < rowCount; ++i)
+                fmt::format_to(std::back_inserter(table), "r{0}|{1:032x}|{2:032x}||{0}|10.2.0.{0}|{3:032x}\n", i, i * 3, i * 5, i * 7);
+
+            return table;
+        }
+
+        /**
+         * Wraps a table in a MIME message, the way Ribbit's first version of the protocol serves it.
+         */
+        std::string VersionsMessage(int64_t rowCount) {
+            return fmt::format(
+                "Subject: wow versions\r\n"
+                "From: Global/ribbit\r\n"
+                "MIME-Version: 1.0\r\n"
+                "Content-Type: multipart/alternative; boundary=\"boundary\"\r\n"
+                "\r\n"
+                "--boundary\r\n"
+                "Content-Type: text/plain\r\n"
+                "Content-Disposition: wow versions\r\n"
+                "\r\n"
+                "{}"
+                "--boundary--\r\n"
+                "Checksum: 0000000000000000000000000000000000000000000000000000000000000000\r\n", VersionsTable(rowCount));
+        }
+    }
+
+    void BM_PSV(benchmark::State& state) {
+        std::string table = VersionsTable(state.range(0));
+
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            ribbit::PSV document { table };
+
+            std::size_t fieldCount = 0;
+            for (ribbit::PSV::Row const& row : document)
+                fieldCount += row.size();
+
+            benchmark::DoNotOptimize(fieldCount);
+        }
+
+        state.SetBytesProcessed(state.iterations() * table.size());
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_PSV)->ArgName("rows")->Arg(8)->Arg(1'000);
+
+    template <ribbit::Version V>
+    void BM_Versions(benchmark::State& state) {
+        std::string payload = V == ribbit::Version::V1
+            ? VersionsMessage(state.range(0))
+            : VersionsTable(state.range(0));
+
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            auto versions = ribbit::detail::VersionTraits<V>::template Parse<ribbit::detail::CommandTraits<ribbit::Command::ProductVersions>>(payload, nullptr);
+            if (!versions.has_value())
+                state.SkipWithError("Versions parsing failed");
+
+            benchmark::DoNotOptimize(versions);
+        }
+
+        state.SetBytesProcessed(state.iterations() * payload.size());
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK_TEMPLATE(BM_Versions, ribbit::Version::V1)->ArgName("rows")->Arg(8)->Arg(1'000);
+    BENCHMARK_TEMPLATE(BM_Versions, ribbit::Version::V2)->ArgName("rows")->Arg(8)->Arg(1'000);
+}
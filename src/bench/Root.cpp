@@ -0,0 +1,109 @@
+#include "Fixtures.hpp"
+#include "Memory.hpp"
+
+#include <optional>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <fixtures/RootWriter.hpp>
+
+#include <libtactmon/io/MemoryStream.hpp>
+#include <libtactmon/tact/data/product/wow/Root.hpp>
+
+namespace bench {
+    namespace {
+        using Root = libtactmon::tact::data::product::wow::Root;
+
+        /**
+         * An encoded root manifest, where every file is named.
+         */
+        struct RootFixture {
+            std::vector<uint8_t> Data;
+            std::vector<std::string> Paths;
+        };
+
+        std::string PathOf(uint32_t fileDataID) {
+            return fmt::format("world/maps/azeroth/azeroth_{}_{}.adt", fileDataID / 64, fileDataID % 64);
+        }
+
+        RootFixture const& Manifest(int64_t entryCount) {
+            return Cached([](int64_t entryCount) {
+                std::vector<fixtures::Key> contentKeys = Keys(entryCount, 4);
+
+                RootFixture fixture;
+                fixture.Paths.reserve(entryCount);
+
+                fixtures::RootWriter writer;
+                writer.Reserve(entryCount);
+                for (int64_t i = 0; i < entryCount; ++i) {
+                    std::string& path = fixture.Paths.emplace_back(PathOf(static_cast<uint32_t>(i)));
+                    writer.Add(static_cast<uint32_t>(i), contentKeys[i], path, Root::ContentFlags::LoadOnWindows, Root::LocaleFlags::enUS);
+                }
+
+                fixture.Data = writer.Write();
+                return fixture;
+            }, entryCount);
+        }
+
+        Root Parse(RootFixture const& fixture) {
+            libtactmon::io::SpanStream stream { AsBytes(fixture.Data) };
+            std::optional<Root> root = Root::Parse(stream, 16);
+            return std::move(root).value();
+        }
+    }
+
+    void BM_Root_Parse(benchmark::State& state) {
+        RootFixture const& fixture = Manifest(state.range(0));
+
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            libtactmon::io::SpanStream stream { AsBytes(fixture.Data) };
+            std::optional<Root> root = Root::Parse(stream, 16);
+            if (!root.has_value())
+                state.SkipWithError("Root::Parse failed");
+
+            benchmark::DoNotOptimize(root);
+        }
+
+        state.SetBytesProcessed(state.iterations() * fixture.Data.size());
+        state.SetItemsProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_Root_Parse)->ArgName("entries")->Arg(100'000)->Arg(1'000'000)->Unit(benchmark::kMillisecond);
+
+    void BM_Root_FindFileDataID(benchmark::State& state) {
+        Root root = Parse(Manifest(state.range(0)));
+
+        uint32_t i = 0;
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            auto contentKey = root.FindFile(static_cast<uint32_t>((i++ * 7919) % state.range(0)));
+            if (!contentKey.has_value())
+                state.SkipWithError("Root::FindFile failed");
+
+            benchmark::DoNotOptimize(contentKey);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_Root_FindFileDataID)->ArgName("entries")->Arg(100'000)->Arg(1'000'000);
+
+    void BM_Root_FindFilePath(benchmark::State& state) {
+        RootFixture const& fixture = Manifest(state.range(0));
+        Root root = Parse(fixture);
+
+        std::size_t i = 0;
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            auto contentKey = root.FindFile(std::string_view { fixture.Paths[(i++ * 7919) % fixture.Paths.size()] });
+            if (!contentKey.has_value())
+                state.SkipWithError("Root::FindFile failed");
+
+            benchmark::DoNotOptimize(contentKey);
+        }
+
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_Root_FindFilePath)->ArgName("entries")->Arg(100'000)->Arg(1'000'000);
+}
@@ -0,0 +1,103 @@
+#include "Fixtures.hpp"
+#include "Memory.hpp"
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+#include <fmt/format.h>
+
+#include <libtactmon/crypto/Jenkins.hpp>
+#include <libtactmon/crypto/lookup3.hpp>
+#include <libtactmon/utility/Hex.hpp>
+
+namespace bench {
+    namespace {
+        /**
+         * Fixtures and the reader share the name hash of roots, so loading generated builds can not tell whether it matches
+         * the one of real roots. This checks the underlying hashlittle2 against the reference vectors of lookup3.c.
+         */
+        bool CheckNameHash() {
+            struct Vector {
+                std::string_view Input;
+                uint32_t SeedC, SeedB;
+                uint32_t C, B;
+            };
+
+            constexpr const Vector vectors[] = {
+                { "",                               0,          0,          0xDEADBEEF, 0xDEADBEEF },
+                { "",                               0,          0xDEADBEEF, 0xBD5B7DDE, 0xDEADBEEF },
+                { "",                               0xDEADBEEF, 0xDEADBEEF, 0x9C093CCD, 0xBD5B7DDE },
+                { "Four score and seven years ago", 0,          0,          0x17770551, 0xCE7226E6 },
+                { "Four score and seven years ago", 0,          1,          0xE3607CAE, 0xBD371DE4 },
+                { "Four score and seven years ago", 1,          0,          0xCD628161, 0x6CBEA4B3 },
+            };
+
+            for (Vector const& vector : vectors) {
+                uint32_t pc = vector.SeedC;
+                uint32_t pb = vector.SeedB;
+                hashlittle2(vector.Input.data(), vector.Input.size(), &pc, &pb);
+                if (pc != vector.C || pb != vector.B)
+                    return false;
+            }
+
+            return true;
+        }
+    }
+
+    void BM_JenkinsHash(benchmark::State& state) {
+        if (!CheckNameHash()) {
+            state.SkipWithError("hashlittle2 does not match the reference vectors of lookup3");
+            return;
+        }
+
+        std::vector<std::string> paths;
+        for (std::size_t i = 0; i < 1024; ++i)
+            paths.push_back(fmt::format("Interface\\AddOns\\Blizzard_Module{}\\Textures\\Frame{:04}.blp", i % 32, i));
+
+        std::size_t i = 0;
+        std::size_t byteCount = 0;
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            std::string const& path = paths[i++ % paths.size()];
+            benchmark::DoNotOptimize(libtactmon::crypto::JenkinsHash(path));
+
+            byteCount += path.size();
+        }
+
+        state.SetBytesProcessed(byteCount);
+        state.SetItemsProcessed(state.iterations());
+    }
+    BENCHMARK(BM_JenkinsHash);
+
+    void BM_Hex(benchmark::State& state) {
+        std::vector<uint8_t> data = Contents(state.range(0));
+
+        std::string output;
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            output.clear();
+            libtactmon::utility::hex(output, data);
+            benchmark::DoNotOptimize(output);
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_Hex)->ArgName("bytes")->Arg(16)->Arg(4096);
+
+    void BM_Unhex(benchmark::State& state) {
+        std::string input = libtactmon::utility::hex(Contents(state.range(0)));
+        std::vector<uint8_t> data(state.range(0));
+
+        MemoryCounters counters { state };
+        for (auto _ : state) {
+            libtactmon::utility::unhex(input, data);
+            benchmark::DoNotOptimize(data);
+        }
+
+        state.SetBytesProcessed(state.iterations() * state.range(0));
+    }
+    BENCHMARK(BM_Unhex)->ArgName("bytes")->Arg(16)->Arg(4096);
+}
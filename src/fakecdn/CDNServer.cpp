@@ -0,0 +1,260 @@
+#include "CDNServer.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <string>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/http/read.hpp>
+#include <boost/beast/http/serializer.hpp>
+#include <boost/beast/http/string_body.hpp>
+#include <boost/beast/http/write.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <fmt/format.h>
+
+#include <libtactmon/detail/Tokenizer.hpp>
+
+namespace fakecdn {
+    namespace asio = boost::asio;
+    namespace beast = boost::beast;
+    namespace http = beast::http;
+    namespace fs = std::filesystem;
+    using tcp = asio::ip::tcp;
+
+    namespace {
+        //! Size of the reads from disk, and of the writes to the socket.
+        constexpr const std::size_t ChunkSize = 64 * 1024;
+
+        enum class RangeKind { Full, Partial, Unsatisfiable };
+
+        std::optional<std::uint64_t> ParseInteger(std::string_view value) {
+            std::uint64_t result = 0;
+            auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), result);
+            if (ec != std::errc { } || ptr != value.data() + value.size())
+                return std::nullopt;
+
+            return result;
+        }
+
+        /**
+         * Parses a Range header. Only single ranges are honored; anything else gets the entire file, which is allowed
+         * by RFC 9110. The unit is optional, because tactmon's proxy omits it and Blizzard's CDNs accept that.
+         */
+        RangeKind ParseRange(std::string_view value, std::uint64_t size, std::uint64_t& offset, std::uint64_t& length) {
+            if (value.starts_with("bytes="))
+                value.remove_prefix(6);
+
+            std::size_t separator = value.find('-');
+            if (value.find(',') != std::string_view::npos || separator == std::string_view::npos)
+                return RangeKind::Full;
+
+            std::string_view first = value.substr(0, separator);
+            std::string_view last = value.substr(separator + 1);
+
+            if (first.empty()) {
+                // Suffix range: the last N bytes.
+                std::optional<std::uint64_t> suffix = ParseInteger(last);
+                if (!suffix.has_value())
+                    return RangeKind::Full;
+
+                if (*suffix == 0 || size == 0)
+                    return RangeKind::Unsatisfiable;
+
+                length = std::min(*suffix, size);
+                offset = size - length;
+                return RangeKind::Partial;
+            }
+
+            std::optional<std::uint64_t> start = ParseInteger(first);
+            if (!start.has_value())
+                return RangeKind::Full;
+
+            if (*start >= size)
+                return RangeKind::Unsatisfiable;
+
+            std::uint64_t end = size - 1;
+            if (!last.empty()) {
+                std::optional<std::uint64_t> lastByte = ParseInteger(last);
+                if (!lastByte.has_value() || *lastByte < *start)
+                    return RangeKind::Full;
+
+                end = std::min(end, *lastByte);
+            }
+
+            offset = *start;
+            length = end - *start + 1;
+            return RangeKind::Partial;
+        }
+    }
+
+    CDNServer::CDNServer(asio::any_io_executor executor, tcp::endpoint endpoint, fs::path root, Faults& faults, spdlog::logger& logger)
+        : _acceptor(executor, endpoint), _root(std::move(root)), _faults(faults), _logger(logger)
+    { }
+
+    asio::awaitable<void> CDNServer::Run() {
+        for (;;) {
+            boost::system::error_code ec;
+
+            // Every connection runs on its own strand.
+            tcp::socket socket = co_await _acceptor.async_accept(asio::make_strand(_acceptor.get_executor()),
+                asio::redirect_error(asio::use_awaitable, ec));
+            if (ec == asio::error::operation_aborted)
+                co_return;
+
+            if (!ec.failed())
+                asio::co_spawn(socket.get_executor(), Serve(std::move(socket)), asio::detached);
+        }
+    }
+
+    asio::awaitable<void> CDNServer::Serve(tcp::socket socket) {
+        beast::flat_buffer buffer;
+
+        for (;;) {
+            boost::system::error_code ec;
+
+            // Pipelined requests are read from the buffer as the previous response completes.
+            Request request;
+            co_await http::async_read(socket, buffer, request, asio::redirect_error(asio::use_awaitable, ec));
+            if (ec.failed())
+                break;
+
+            if (!co_await Handle(socket, request))
+                break;
+        }
+
+        boost::system::error_code ec;
+        socket.shutdown(tcp::socket::shutdown_both, ec);
+    }
+
+    std::optional<fs::path> CDNServer::Resolve(std::string_view target) const {
+        target = target.substr(0, target.find('?'));
+
+        fs::path path = _root;
+        for (std::string_view component : libtactmon::detail::Split(target, '/', true)) {
+            if (component == "." || component == ".." || component.find('\\') != std::string_view::npos)
+                return std::nullopt;
+
+            path /= component;
+        }
+
+        return path;
+    }
+
+    asio::awaitable<bool> CDNServer::Handle(tcp::socket& socket, Request const& request) {
+        boost::system::error_code ec;
+
+        std::string_view method { request.method_string().data(), request.method_string().size() };
+        std::string_view target { request.target().data(), request.target().size() };
+
+        auto respond = [&](http::status status, std::string_view reason) -> asio::awaitable<bool> {
+            _logger.debug("[http] {} {} -> {} ({})", method, target, static_cast<unsigned>(status), reason);
+
+            http::response<http::string_body> response { status, request.version() };
+            response.set(http::field::server, "tactmon-fakecdn");
+            response.keep_alive(request.keep_alive());
+            response.prepare_payload();
+
+            co_await http::async_write(socket, response, asio::redirect_error(asio::use_awaitable, ec));
+            co_return !ec.failed() && response.keep_alive();
+        };
+
+        co_await _faults.Delay();
+
+        if (request.method() != http::verb::get && request.method() != http::verb::head)
+            co_return co_await respond(http::status::method_not_allowed, "method");
+
+        if (_faults.ShouldFail())
+            co_return co_await respond(http::status::service_unavailable, "injected failure");
+
+        std::optional<fs::path> path = Resolve(target);
+        std::error_code fsError;
+        if (!path.has_value() || !fs::is_regular_file(*path, fsError))
+            co_return co_await respond(http::status::not_found, "not found");
+
+        std::uint64_t size = fs::file_size(*path, fsError);
+        std::ifstream file { *path, std::ios::binary };
+        if (fsError || !file)
+            co_return co_await respond(http::status::internal_server_error, "unreadable");
+
+        http::response<http::empty_body> response { http::status::ok, request.version() };
+        response.set(http::field::server, "tactmon-fakecdn");
+        response.set(http::field::content_type, "application/octet-stream");
+        response.set(http::field::accept_ranges, "bytes");
+        response.keep_alive(request.keep_alive());
+
+        std::uint64_t offset = 0;
+        std::uint64_t length = size;
+        if (auto range = request.find(http::field::range); range != request.end() && !_faults.IgnoresRanges()) {
+            switch (ParseRange(std::string_view { range->value().data(), range->value().size() }, size, offset, length)) {
+                case RangeKind::Unsatisfiable:
+                {
+                    _logger.debug("[http] {} {} -> 416", method, target);
+
+                    http::response<http::string_body> error { http::status::range_not_satisfiable, request.version() };
+                    error.set(http::field::server, "tactmon-fakecdn");
+                    error.set(http::field::content_range, fmt::format("bytes */{}", size));
+                    error.keep_alive(request.keep_alive());
+                    error.prepare_payload();
+
+                    co_await http::async_write(socket, error, asio::redirect_error(asio::use_awaitable, ec));
+                    co_return !ec.failed() && error.keep_alive();
+                }
+                case RangeKind::Partial:
+                    response.result(http::status::partial_content);
+                    response.set(http::field::content_range, fmt::format("bytes {}-{}/{}", offset, offset + length - 1, size));
+                    break;
+                case RangeKind::Full:
+                    offset = 0;
+                    length = size;
+                    break;
+            }
+        }
+
+        response.content_length(length);
+
+        _logger.debug("[http] {} {} -> {} ({} bytes at {})", method, target,
+            response.result_int(), length, offset);
+
+        // The body is written separately, so that it can be throttled and cut short.
+        http::response_serializer<http::empty_body> serializer { response };
+        co_await http::async_write_header(socket, serializer, asio::redirect_error(asio::use_awaitable, ec));
+        if (ec.failed())
+            co_return false;
+
+        if (request.method() == http::verb::head)
+            co_return response.keep_alive();
+
+        std::optional<std::uint64_t> dropAfter = _faults.DropAfter(length);
+        std::uint64_t remaining = dropAfter.value_or(length);
+
+        file.seekg(static_cast<std::streamoff>(offset));
+        std::vector<char> chunk(ChunkSize);
+        while (remaining != 0) {
+            std::size_t chunkSize = static_cast<std::size_t>(std::min<std::uint64_t>(remaining, chunk.size()));
+            if (!file.read(chunk.data(), static_cast<std::streamsize>(chunkSize)))
+                co_return false;
+
+            if (!co_await _faults.Write(socket, std::span<const char> { chunk.data(), chunkSize }))
+                co_return false;
+
+            remaining -= chunkSize;
+        }
+
+        if (dropAfter.has_value()) {
+            _logger.debug("[http] {} {} -> dropped after {} bytes", method, target, *dropAfter);
+            co_return false;
+        }
+
+        co_return response.keep_alive();
+    }
+}
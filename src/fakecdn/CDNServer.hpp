@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Faults.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/http/empty_body.hpp>
+#include <boost/beast/http/message.hpp>
+
+#include <spdlog/logger.h>
+
+namespace fakecdn {
+    /**
+     * Serves files over HTTP/1.1 from a directory laid out like a CDN, which is also the layout of @c tact::Cache: a
+     * request for @c /tpr/wow/config/ab/cd/abcd... is answered with @c <root>/tpr/wow/config/ab/cd/abcd....
+     *
+     * Connections are kept alive and requests may be pipelined. Single byte ranges are honored.
+     */
+    struct CDNServer final {
+        CDNServer(boost::asio::any_io_executor executor, boost::asio::ip::tcp::endpoint endpoint, std::filesystem::path root,
+            Faults& faults, spdlog::logger& logger);
+
+        /**
+         * Accepts connections until the executor stops.
+         */
+        boost::asio::awaitable<void> Run();
+
+        /**
+         * Returns the endpoint connections are accepted on; useful when the server was bound to port 0.
+         */
+        [[nodiscard]] boost::asio::ip::tcp::endpoint endpoint() const { return _acceptor.local_endpoint(); }
+
+    private:
+        using Request = boost::beast::http::request<boost::beast::http::empty_body>;
+
+        boost::asio::awaitable<void> Serve(boost::asio::ip::tcp::socket socket);
+
+        /**
+         * Answers a request.
+         *
+         * @returns true if the connection can be reused for further requests.
+         */
+        boost::asio::awaitable<bool> Handle(boost::asio::ip::tcp::socket& socket, Request const& request);
+
+        /**
+         * Maps a request target to a file under the root, rejecting targets that would escape it.
+         */
+        std::optional<std::filesystem::path> Resolve(std::string_view target) const;
+
+        boost::asio::ip::tcp::acceptor _acceptor;
+        std::filesystem::path _root;
+
+        Faults& _faults;
+        spdlog::logger& _logger;
+    };
+}
@@ -0,0 +1,76 @@
+#include "Faults.hpp"
+
+#include <algorithm>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/system/error_code.hpp>
+
+namespace fakecdn {
+    namespace asio = boost::asio;
+
+    Faults::Faults(Options options) : _options(options), _engine(options.Seed) { }
+
+    double Faults::Roll() {
+        std::lock_guard<std::mutex> guard { _lock };
+        return std::uniform_real_distribution<double> { 0.0, 1.0 }(_engine);
+    }
+
+    bool Faults::ShouldFail() {
+        return _options.ErrorRate > 0.0 && Roll() < _options.ErrorRate;
+    }
+
+    std::optional<std::uint64_t> Faults::DropAfter(std::uint64_t size) {
+        if (_options.DropRate <= 0.0 || Roll() >= _options.DropRate)
+            return std::nullopt;
+
+        return static_cast<std::uint64_t>(Roll() * static_cast<double>(size));
+    }
+
+    asio::awaitable<void> Faults::Delay() {
+        auto delay = std::chrono::duration_cast<std::chrono::steady_clock::duration>(_options.Latency);
+        if (_options.Jitter.count() > 0)
+            delay += std::chrono::duration_cast<std::chrono::steady_clock::duration>(_options.Jitter * Roll());
+
+        if (delay.count() <= 0)
+            co_return;
+
+        asio::steady_timer timer { co_await asio::this_coro::executor, delay };
+        boost::system::error_code ec;
+        co_await timer.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+    }
+
+    asio::awaitable<bool> Faults::Write(asio::ip::tcp::socket& socket, std::span<const char> data) {
+        boost::system::error_code ec;
+
+        if (_options.Bandwidth == 0) {
+            co_await asio::async_write(socket, asio::buffer(data.data(), data.size()), asio::redirect_error(asio::use_awaitable, ec));
+            co_return !ec.failed();
+        }
+
+        // Write slices worth 50 milliseconds of transfer, waiting after each of them until the transfer rate is met.
+        std::size_t sliceSize = std::max<std::size_t>(1024, _options.Bandwidth / 20);
+        auto start = std::chrono::steady_clock::now();
+        std::uint64_t written = 0;
+
+        asio::steady_timer timer { co_await asio::this_coro::executor };
+        while (written < data.size()) {
+            std::size_t size = std::min<std::size_t>(sliceSize, data.size() - written);
+            co_await asio::async_write(socket, asio::buffer(data.data() + written, size), asio::redirect_error(asio::use_awaitable, ec));
+            if (ec.failed())
+                co_return false;
+
+            written += size;
+
+            timer.expires_at(start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double> { static_cast<double>(written) / static_cast<double>(_options.Bandwidth) }));
+            co_await timer.async_wait(asio::redirect_error(asio::use_awaitable, ec));
+        }
+
+        co_return true;
+    }
+}
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <span>
+#include <utility>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+namespace fakecdn {
+    /**
+     * Degrades the service, so that the timeout, retry and hedging paths of clients can be exercised.
+     *
+     * Shared by every connection; safe to use from several threads.
+     */
+    struct Faults final {
+        struct Options {
+            //! Delay before every response.
+            std::chrono::milliseconds Latency { 0 };
+
+            //! Additional delay, uniformly distributed between zero and this amount.
+            std::chrono::milliseconds Jitter { 0 };
+
+            //! Maximum transfer rate of a response, in bytes per second. Zero means unlimited.
+            std::uint64_t Bandwidth = 0;
+
+            //! Probability that a request fails: HTTP requests are answered with a 503, Ribbit connections are closed.
+            double ErrorRate = 0.0;
+
+            //! Probability that a response is cut short by closing the connection partway through.
+            double DropRate = 0.0;
+
+            //! If set, range requests are answered with the entire file, as some CDN hosts do.
+            bool IgnoreRanges = false;
+
+            std::uint64_t Seed = 0;
+        };
+
+        explicit Faults(Options options);
+
+        /**
+         * Returns true if the current request should fail.
+         */
+        bool ShouldFail();
+
+        /**
+         * Returns the amount of bytes of a response after which the connection should be closed, or an empty optional
+         * if the response should be sent in full.
+         */
+        std::optional<std::uint64_t> DropAfter(std::uint64_t size);
+
+        /**
+         * Returns true if range requests should be answered with the entire file.
+         */
+        [[nodiscard]] bool IgnoresRanges() const { return _options.IgnoreRanges; }
+
+        /**
+         * Waits for the configured latency.
+         */
+        boost::asio::awaitable<void> Delay();
+
+        /**
+         * Writes data to a socket, no faster than the configured bandwidth allows.
+         *
+         * @returns false if the write failed.
+         */
+        boost::asio::awaitable<bool> Write(boost::asio::ip::tcp::socket& socket, std::span<const char> data);
+
+    private:
+        double Roll();
+
+        Options _options;
+
+        std::mutex _lock;
+        std::mt19937_64 _engine;
+    };
+}
@@ -0,0 +1,176 @@
+#include "CDNServer.hpp"
+#include "Faults.hpp"
+#include "RibbitServer.hpp"
+
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/signal_set.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/program_options.hpp>
+#include <boost/system/system_error.hpp>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+namespace po = boost::program_options;
+namespace asio = boost::asio;
+namespace fs = std::filesystem;
+
+int main(int argc, char** argv) {
+    po::options_description desc("Options");
+    desc.add_options()
+        ("help,h", "This help prompt.")
+
+        ("root",          po::value<std::string>()->required(),              "Directory served, laid out like tactmon's cache. Ribbit tables are read "
+                                                                             "from <root>/ribbit/<product>/{versions,cdns,bgdl}.")
+        ("bind",          po::value<std::string>()->default_value("127.0.0.1"), "Address both servers listen on.")
+        ("ribbit-port",   po::value<uint16_t>()->default_value(1119),        "Port of the Ribbit server.")
+        ("http-port",     po::value<uint16_t>()->default_value(8080),        "Port of the HTTP (CDN) server.")
+        ("advertise",     po::value<std::string>(),                          "Host written to generated cdns tables. Defaults to the bound address.")
+        ("thread-count",  po::value<uint16_t>()->default_value(1),           "Amount of threads serving requests.")
+
+        ("seqn",          po::value<uint64_t>()->default_value(1),           "Initial Ribbit sequence number.")
+        ("seqn-interval", po::value<uint32_t>()->default_value(0),           "Seconds between increments of the sequence number; zero disables them. "
+                                                                             "SIGUSR1 also increments it.")
+
+        ("latency",       po::value<uint32_t>()->default_value(0),           "Delay before every response, in milliseconds.")
+        ("jitter",        po::value<uint32_t>()->default_value(0),           "Maximum random additional delay, in milliseconds.")
+        ("bandwidth",     po::value<uint64_t>()->default_value(0),           "Maximum transfer rate of a response, in bytes per second; zero is unlimited.")
+        ("error-rate",    po::value<double>()->default_value(0.0),           "Probability that a request fails (HTTP 503, or a closed Ribbit connection).")
+        ("drop-rate",     po::value<double>()->default_value(0.0),           "Probability that a response is cut short.")
+        ("ignore-ranges",                                                    "Answer range requests with the entire file, as some CDN hosts do.")
+        ("seed",          po::value<uint64_t>(),                             "Seed of the fault injection; random by default.")
+
+        ("verbose,v",                                                        "Log every request.")
+        ;
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        if (vm.count("help") != 0) {
+            std::cout << desc << '\n';
+            return EXIT_SUCCESS;
+        }
+
+        po::notify(vm);
+    } catch (po::error const& ex) {
+        std::cerr << ex.what() << '\n';
+        std::cout << desc << '\n';
+
+        return EXIT_FAILURE;
+    }
+
+    auto logger = spdlog::stdout_color_mt("fakecdn");
+    logger->set_level(vm.count("verbose") != 0 ? spdlog::level::debug : spdlog::level::info);
+
+    fs::path root = vm["root"].as<std::string>();
+    if (!fs::is_directory(root)) {
+        logger->error("'{}' is not a directory.", root.string());
+        return EXIT_FAILURE;
+    }
+
+    fakecdn::Faults faults { fakecdn::Faults::Options {
+        .Latency = std::chrono::milliseconds { vm["latency"].as<uint32_t>() },
+        .Jitter = std::chrono::milliseconds { vm["jitter"].as<uint32_t>() },
+        .Bandwidth = vm["bandwidth"].as<uint64_t>(),
+        .ErrorRate = vm["error-rate"].as<double>(),
+        .DropRate = vm["drop-rate"].as<double>(),
+        .IgnoreRanges = vm.count("ignore-ranges") != 0,
+        .Seed = vm.count("seed") != 0 ? vm["seed"].as<uint64_t>() : std::random_device { }(),
+    } };
+
+    asio::io_context context;
+
+    std::string bind = vm["bind"].as<std::string>();
+    std::string advertisedHost = vm.count("advertise") != 0 ? vm["advertise"].as<std::string>() : bind;
+
+    std::unique_ptr<fakecdn::RibbitServer> ribbit;
+    std::unique_ptr<fakecdn::CDNServer> cdn;
+    try {
+        asio::ip::address address = asio::ip::make_address(bind);
+
+        ribbit = std::make_unique<fakecdn::RibbitServer>(context.get_executor(),
+            asio::ip::tcp::endpoint { address, vm["ribbit-port"].as<uint16_t>() },
+            root, advertisedHost, vm["seqn"].as<uint64_t>(), faults, *logger);
+
+        cdn = std::make_unique<fakecdn::CDNServer>(context.get_executor(),
+            asio::ip::tcp::endpoint { address, vm["http-port"].as<uint16_t>() },
+            root, faults, *logger);
+    } catch (boost::system::system_error const& ex) {
+        logger->error("Unable to listen on {}: {}.", bind, ex.what());
+        return EXIT_FAILURE;
+    }
+
+    asio::co_spawn(context, ribbit->Run(), asio::detached);
+    asio::co_spawn(context, cdn->Run(), asio::detached);
+
+    // Periodic updates.
+    asio::steady_timer updateTimer { context };
+    std::chrono::seconds updateInterval { vm["seqn-interval"].as<uint32_t>() };
+    std::function<void(boost::system::error_code)> scheduleUpdate = [&](boost::system::error_code ec) {
+        if (ec)
+            return;
+
+        updateTimer.expires_after(updateInterval);
+        updateTimer.async_wait([&](boost::system::error_code ec) {
+            if (!ec)
+                ribbit->Advance();
+
+            scheduleUpdate(ec);
+        });
+    };
+
+    if (updateInterval.count() != 0)
+        scheduleUpdate({ });
+
+    // On-demand updates, and interruption.
+#if !defined(WIN32)
+    asio::signal_set updateSignals { context, SIGUSR1 };
+    std::function<void()> waitForUpdate = [&]() {
+        updateSignals.async_wait([&](boost::system::error_code ec, int) {
+            if (ec)
+                return;
+
+            ribbit->Advance();
+            waitForUpdate();
+        });
+    };
+    waitForUpdate();
+#endif
+
+    asio::signal_set stopSignals { context, SIGINT, SIGTERM };
+    stopSignals.async_wait([&](boost::system::error_code, int) { context.stop(); });
+
+    logger->info("Serving '{}'; Ribbit on {}:{}, CDN on {}:{}, sequence number {}.", root.string(),
+        bind, vm["ribbit-port"].as<uint16_t>(), bind, vm["http-port"].as<uint16_t>(), ribbit->SequenceID());
+    logger->info("Point tactmon at this server with --host-override *:1119={0}:{1} --host-override *:80={0}:{2}",
+        bind, vm["ribbit-port"].as<uint16_t>(), vm["http-port"].as<uint16_t>());
+
+    std::vector<std::thread> threads;
+    for (std::size_t i = 1; i < vm["thread-count"].as<uint16_t>(); ++i)
+        threads.emplace_back([&context]() { context.run(); });
+
+    context.run();
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    return EXIT_SUCCESS;
+}
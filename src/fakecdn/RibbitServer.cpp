@@ -0,0 +1,243 @@
+#include "RibbitServer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <fstream>
+#include <iterator>
+#include <ranges>
+#include <span>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/read_until.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <fmt/format.h>
+
+#include <libtactmon/crypto/Hash.hpp>
+#include <libtactmon/detail/Tokenizer.hpp>
+#include <libtactmon/utility/Hex.hpp>
+
+namespace fakecdn {
+    namespace asio = boost::asio;
+    namespace fs = std::filesystem;
+    using tcp = asio::ip::tcp;
+
+    namespace {
+        constexpr const std::string_view Boundary = "tactmon-fakecdn";
+
+        std::optional<std::string> ReadFile(fs::path const& path) {
+            std::ifstream stream { path, std::ios::binary };
+            if (!stream)
+                return std::nullopt;
+
+            return std::string { std::istreambuf_iterator<char> { stream }, std::istreambuf_iterator<char> { } };
+        }
+
+        /**
+         * Rewrites a table so that it carries the given sequence number, right after its header.
+         */
+        std::string WithSequenceID(std::string_view table, std::uint64_t sequenceID) {
+            std::string result;
+            result.reserve(table.size() + 32);
+
+            bool header = true;
+            for (std::string_view line : libtactmon::detail::Split(table, '\n', false)) {
+                if (!line.empty() && line.back() == '\r')
+                    line.remove_suffix(1);
+
+                if (line.starts_with("##") && line.find("seqn") != std::string_view::npos)
+                    continue;
+
+                result.append(line);
+                result.push_back('\n');
+
+                if (header && !line.empty() && !line.starts_with('#')) {
+                    fmt::format_to(std::back_inserter(result), "## seqn = {}\n", sequenceID);
+                    header = false;
+                }
+            }
+
+            return result;
+        }
+
+        /**
+         * Wraps a table in a MIME message, as done by version 1 of the protocol.
+         */
+        std::string MakeMessage(std::string_view subject, std::string_view table) {
+            std::string message = fmt::format(
+                "Subject: {0}\r\n"
+                "From: Global/tactmon-fakecdn\r\n"
+                "MIME-Version: 1.0\r\n"
+                "Content-Type: multipart/alternative; boundary=\"{1}\"\r\n"
+                "\r\n"
+                "--{1}\r\n"
+                "Content-Type: text/plain\r\n"
+                "Content-Disposition: {0}\r\n"
+                "\r\n"
+                "{2}"
+                "--{1}--\r\n", subject, Boundary, table);
+
+            auto checksum = libtactmon::crypto::SHA256::Of(std::string_view { message });
+            fmt::format_to(std::back_inserter(message), "Checksum: {}\r\n", libtactmon::utility::hex(checksum));
+            return message;
+        }
+
+        bool IsValidProduct(std::string_view product) {
+            return !product.empty() && !product.starts_with('.') && product.find_first_of("/\\") == std::string_view::npos;
+        }
+    }
+
+    RibbitServer::RibbitServer(asio::any_io_executor executor, tcp::endpoint endpoint, fs::path root, std::string advertisedHost,
+        std::uint64_t sequenceID, Faults& faults, spdlog::logger& logger)
+        : _acceptor(executor, endpoint), _root(std::move(root)), _advertisedHost(std::move(advertisedHost)), _sequenceID(sequenceID),
+        _faults(faults), _logger(logger)
+    { }
+
+    std::uint64_t RibbitServer::Advance() {
+        std::uint64_t sequenceID = _sequenceID.fetch_add(1, std::memory_order_relaxed) + 1;
+        _logger.info("Ribbit sequence number is now {}.", sequenceID);
+        return sequenceID;
+    }
+
+    asio::awaitable<void> RibbitServer::Run() {
+        for (;;) {
+            boost::system::error_code ec;
+
+            // Every connection runs on its own strand.
+            tcp::socket socket = co_await _acceptor.async_accept(asio::make_strand(_acceptor.get_executor()),
+                asio::redirect_error(asio::use_awaitable, ec));
+            if (ec == asio::error::operation_aborted)
+                co_return;
+
+            if (!ec.failed())
+                asio::co_spawn(socket.get_executor(), Serve(std::move(socket)), asio::detached);
+        }
+    }
+
+    asio::awaitable<void> RibbitServer::Serve(tcp::socket socket) {
+        boost::system::error_code ec;
+
+        // Clients send a single line, then wait for the server to close the connection.
+        std::string command;
+        boost::beast::tcp_stream stream { std::move(socket) };
+        stream.expires_after(std::chrono::seconds { 10 });
+        co_await asio::async_read_until(stream, asio::dynamic_buffer(command, 1024), '\n', asio::redirect_error(asio::use_awaitable, ec));
+        stream.expires_never();
+        if (ec.failed())
+            co_return;
+
+        command.resize(command.find_first_of("\r\n"));
+        co_await _faults.Delay();
+
+        if (_faults.ShouldFail()) {
+            _logger.debug("[ribbit] {} -> injected failure", command);
+            co_return;
+        }
+
+        std::optional<std::string> response = Respond(command);
+        if (!response.has_value()) {
+            _logger.debug("[ribbit] {} -> unknown", command);
+            co_return;
+        }
+
+        _logger.debug("[ribbit] {} -> {} bytes", command, response->size());
+
+        std::span<const char> data { *response };
+        if (std::optional<std::uint64_t> dropAfter = _faults.DropAfter(data.size()); dropAfter.has_value())
+            data = data.first(*dropAfter);
+
+        co_await _faults.Write(stream.socket(), data);
+
+        stream.socket().shutdown(tcp::socket::shutdown_both, ec);
+    }
+
+    std::optional<std::string> RibbitServer::Respond(std::string_view command) const {
+        // v1/summary, v1/products/<product>/<table>
+        std::array<std::string_view, 4> tokens;
+        std::size_t count = 0;
+        for (std::string_view token : libtactmon::detail::Split(command, '/', false)) {
+            if (count == tokens.size())
+                return std::nullopt;
+
+            tokens[count++] = token;
+        }
+
+        if (count < 2 || (tokens[0] != "v1" && tokens[0] != "v2"))
+            return std::nullopt;
+
+        bool mime = tokens[0] == "v1";
+        std::uint64_t sequenceID = SequenceID();
+
+        std::optional<std::string> table;
+        std::string_view subject = tokens[1];
+        if (count == 2 && tokens[1] == "summary")
+            table = Summary(sequenceID);
+        else if (count == 4 && tokens[1] == "products" && IsValidProduct(tokens[2])) {
+            constexpr static const std::string_view Tables[] = { "versions", "cdns", "bgdl" };
+            if (std::ranges::find(Tables, tokens[3]) != std::end(Tables)) {
+                table = Table(tokens[2], tokens[3], sequenceID);
+                subject = tokens[3];
+            }
+        }
+
+        if (!table.has_value())
+            return std::nullopt;
+
+        if (!mime)
+            return table;
+
+        return MakeMessage(subject, *table);
+    }
+
+    std::optional<std::string> RibbitServer::Summary(std::uint64_t sequenceID) const {
+        std::vector<std::string> products;
+
+        std::error_code ec;
+        for (fs::directory_entry const& entry : fs::directory_iterator { _root / "ribbit", ec }) {
+            if (entry.is_directory(ec))
+                products.push_back(entry.path().filename().string());
+        }
+
+        if (ec)
+            return std::nullopt;
+
+        std::ranges::sort(products);
+
+        std::string table = fmt::format("Product!STRING:0|Seqn!DEC:4|Flags!STRING:0\n## seqn = {}\n", sequenceID);
+        for (std::string const& product : products) {
+            fmt::format_to(std::back_inserter(table), "{0}|{1}|\n{0}|{1}|cdn\n", product, sequenceID);
+            if (fs::is_regular_file(_root / "ribbit" / product / "bgdl", ec))
+                fmt::format_to(std::back_inserter(table), "{}|{}|bgdl\n", product, sequenceID);
+        }
+
+        return table;
+    }
+
+    std::optional<std::string> RibbitServer::Table(std::string_view product, std::string_view name, std::uint64_t sequenceID) const {
+        std::optional<std::string> table = ReadFile(_root / "ribbit" / product / name);
+        if (table.has_value())
+            return WithSequenceID(*table, sequenceID);
+
+        if (name != "cdns" || !fs::is_directory(_root / "ribbit" / product))
+            return std::nullopt;
+
+        // Every region downloads from this server.
+        std::string generated = fmt::format("Name!STRING:0|Path!STRING:0|Hosts!STRING:0|Servers!STRING:0|ConfigPath!STRING:0\n## seqn = {}\n", sequenceID);
+        for (std::string_view region : { "us", "eu", "kr", "tw", "cn" }) {
+            fmt::format_to(std::back_inserter(generated), "{0}|tpr/{1}|{2}|http://{2}/?maxhosts=4|tpr/configs/data\n",
+                region, product, _advertisedHost);
+        }
+
+        return generated;
+    }
+}
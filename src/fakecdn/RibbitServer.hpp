@@ -0,0 +1,61 @@
+#pragma once
+
+#include "Faults.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/ip/tcp.hpp>
+
+#include <spdlog/logger.h>
+
+namespace fakecdn {
+    /**
+     * Answers Ribbit commands (summary, versions, cdns and bgdl, both v1 and v2) over TCP.
+     *
+     * Tables are read from @c <root>/ribbit/<product>/<command> on every request, so that they can be edited while the
+     * server runs. Every table is served with the current sequence number, which replaces any @c "## seqn" comment in
+     * the file. If a product has no @c cdns table, one is generated that points at @p advertisedHost.
+     */
+    struct RibbitServer final {
+        RibbitServer(boost::asio::any_io_executor executor, boost::asio::ip::tcp::endpoint endpoint, std::filesystem::path root,
+            std::string advertisedHost, std::uint64_t sequenceID, Faults& faults, spdlog::logger& logger);
+
+        /**
+         * Accepts connections until the executor stops.
+         */
+        boost::asio::awaitable<void> Run();
+
+        [[nodiscard]] std::uint64_t SequenceID() const { return _sequenceID.load(std::memory_order_relaxed); }
+
+        /**
+         * Increments the sequence number, which makes every client believe that every product was updated.
+         */
+        std::uint64_t Advance();
+
+    private:
+        boost::asio::awaitable<void> Serve(boost::asio::ip::tcp::socket socket);
+
+        /**
+         * Returns the response to a command, or an empty optional if the command is unknown.
+         */
+        std::optional<std::string> Respond(std::string_view command) const;
+
+        std::optional<std::string> Summary(std::uint64_t sequenceID) const;
+        std::optional<std::string> Table(std::string_view product, std::string_view name, std::uint64_t sequenceID) const;
+
+        boost::asio::ip::tcp::acceptor _acceptor;
+        std::filesystem::path _root;
+        std::string _advertisedHost;
+        std::atomic<std::uint64_t> _sequenceID;
+
+        Faults& _faults;
+        spdlog::logger& _logger;
+    };
+}
@@ -0,0 +1,111 @@
+#include "CDNServer.hpp"
+#include "Faults.hpp"
+
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <optional>
+#include <random>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/address.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/thread_pool.hpp>
+
+#include <fmt/format.h>
+
+#include <spdlog/logger.h>
+#include <spdlog/sinks/null_sink.h>
+
+#include <libtactmon/io/FileStream.hpp>
+#include <libtactmon/net/HostOverrides.hpp>
+#include <libtactmon/net/SegmentedDownload.hpp>
+#include <libtactmon/tact/Cache.hpp>
+
+namespace asio = boost::asio;
+namespace fs = std::filesystem;
+
+/**
+ * Serves a file from two hosts that both ignore ranges, one of which drops every response partway through its body, and
+ * checks that a segmented download only ever commits the complete file to the cache.
+ */
+int main() {
+    fs::path root = fs::temp_directory_path() / fmt::format("tactmon-fakecdn-tests-{}", std::random_device { }());
+    fs::path served = root / "served";
+    fs::path cache = root / "cache";
+
+    std::string resourcePath = "/tpr/wow/data/ab/cd/abcdef0123456789abcdef0123456789";
+
+    std::vector<char> contents(256 * 1024);
+    std::mt19937 engine { 0 };
+    for (char& byte : contents)
+        byte = static_cast<char>(engine());
+
+    {
+        fs::path filePath = served / resourcePath.substr(1);
+        fs::create_directories(filePath.parent_path());
+
+        std::ofstream file { filePath, std::ios::binary };
+        file.write(contents.data(), static_cast<std::streamsize>(contents.size()));
+    }
+
+    spdlog::logger logger { "fakecdn", std::make_shared<spdlog::sinks::null_sink_mt>() };
+
+    fakecdn::Faults healthyFaults { fakecdn::Faults::Options { .IgnoreRanges = true } };
+    fakecdn::Faults droppingFaults { fakecdn::Faults::Options { .DropRate = 1.0, .IgnoreRanges = true, .Seed = 0 } };
+
+    asio::io_context serverContext;
+    asio::ip::tcp::endpoint loopback { asio::ip::make_address("127.0.0.1"), 0 };
+    fakecdn::CDNServer healthy { serverContext.get_executor(), loopback, served, healthyFaults, logger };
+    fakecdn::CDNServer dropping { serverContext.get_executor(), loopback, served, droppingFaults, logger };
+
+    asio::co_spawn(serverContext, healthy.Run(), asio::detached);
+    asio::co_spawn(serverContext, dropping.Run(), asio::detached);
+    std::thread serverThread { [&]() { serverContext.run(); } };
+
+    libtactmon::net::HostOverrides::Default().Add("healthy", "*", { "127.0.0.1", std::to_string(healthy.endpoint().port()) });
+    libtactmon::net::HostOverrides::Default().Add("dropping", "*", { "127.0.0.1", std::to_string(dropping.endpoint().port()) });
+
+    int status = EXIT_SUCCESS;
+    {
+        libtactmon::tact::Cache localCache { cache };
+        asio::thread_pool clientPool { 2 };
+        fs::path committedPath = localCache.GetAbsolutePath(resourcePath);
+
+        libtactmon::net::SegmentedDownload::Options options { .MaxAttempts = 1 };
+
+        std::vector<std::string> droppingHosts { "dropping" };
+        libtactmon::net::SegmentedDownload truncated { resourcePath, localCache, options };
+        if (truncated.Run(clientPool.get_executor(), droppingHosts, nullptr).has_value() || fs::exists(committedPath)) {
+            fmt::print(stderr, "A response dropped partway through its body was committed to the cache.\n");
+            status = EXIT_FAILURE;
+        }
+
+        // The same download from a host that completes its responses goes through, so the failure above is not an accident.
+        std::vector<std::string> healthyHosts { "healthy" };
+        libtactmon::net::SegmentedDownload complete { resourcePath, localCache, options };
+        std::optional<libtactmon::io::FileStream> stream = complete.Run(clientPool.get_executor(), healthyHosts, nullptr);
+        std::error_code ec;
+        if (!stream.has_value() || fs::file_size(committedPath, ec) != contents.size()) {
+            fmt::print(stderr, "A complete response was not committed to the cache.\n");
+            status = EXIT_FAILURE;
+        }
+
+        clientPool.join();
+    }
+
+    serverContext.stop();
+    serverThread.join();
+
+    std::error_code ec;
+    fs::remove_all(root, ec);
+    return status;
+}
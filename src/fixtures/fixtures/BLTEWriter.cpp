@@ -0,0 +1,104 @@
+#include "fixtures/BLTEWriter.hpp"
+#include "fixtures/detail/ByteWriter.hpp"
+
+#include <algorithm>
+
+#include <zlib.h>
+
+namespace fixtures {
+    namespace {
+        std::vector<uint8_t> Deflate(std::span<const uint8_t> data, int level) {
+            uLongf size = compressBound(static_cast<uLong>(data.size()));
+            std::vector<uint8_t> compressed(size);
+            compress2(compressed.data(), &size, data.data(), static_cast<uLong>(data.size()), level);
+
+            compressed.resize(size);
+            return compressed;
+        }
+
+        std::vector<uint8_t> EncodeChunk(std::span<const uint8_t> data, ChunkMode mode, BLTEOptions const& options) {
+            std::vector<uint8_t> chunk;
+            switch (mode) {
+                case ChunkMode::None:
+                    chunk.reserve(data.size() + 1);
+                    chunk.push_back('N');
+                    chunk.insert(chunk.end(), data.begin(), data.end());
+                    break;
+                case ChunkMode::Zlib:
+                {
+                    std::vector<uint8_t> compressed = Deflate(data, options.CompressionLevel);
+
+                    chunk.reserve(compressed.size() + 1);
+                    chunk.push_back('Z');
+                    chunk.insert(chunk.end(), compressed.begin(), compressed.end());
+                    break;
+                }
+                case ChunkMode::Frame:
+                case ChunkMode::Mixed:
+                {
+                    // The nested archive splits the chunk further so that it has a chunk table of its own.
+                    BLTEOptions nestedOptions {
+                        .ChunkSize = std::max<std::size_t>(data.size() / 4, 1),
+                        .Mode = ChunkMode::Zlib,
+                        .CompressionLevel = options.CompressionLevel
+                    };
+
+                    EncodedFile nested = BLTEWriter::Encode(data, nestedOptions);
+
+                    chunk.reserve(nested.Data.size() + 1);
+                    chunk.push_back('F');
+                    chunk.insert(chunk.end(), nested.Data.begin(), nested.Data.end());
+                    break;
+                }
+            }
+
+            return chunk;
+        }
+    }
+
+    /* static */ EncodedFile BLTEWriter::Encode(std::span<const uint8_t> content, BLTEOptions const& options) {
+        std::size_t chunkSize = options.ChunkSize == 0 ? content.size() : options.ChunkSize;
+
+        std::vector<std::vector<uint8_t>> chunks;
+        std::vector<std::size_t> chunkSizes;
+        for (std::size_t offset = 0; offset < content.size(); offset += chunkSize) {
+            std::span<const uint8_t> data = content.subspan(offset, std::min(chunkSize, content.size() - offset));
+
+            ChunkMode mode = options.Mode;
+            if (mode == ChunkMode::Mixed)
+                mode = static_cast<ChunkMode>(chunks.size() % 3);
+
+            chunks.push_back(EncodeChunk(data, mode, options));
+            chunkSizes.push_back(data.size());
+        }
+
+        EncodedFile file;
+        file.ContentKey = libtactmon::crypto::MD5::Of(content);
+        file.ContentSize = content.size();
+
+        // u32 magic, u32 headerSize, u8 flags, u24 chunkCount, then u32 encodedSize, u32 decodedSize, u8 checksum[16] per chunk.
+        std::size_t headerSize = 4 + 4 + 4 + chunks.size() * (4 + 4 + 16);
+        std::size_t encodedSize = headerSize;
+        for (std::vector<uint8_t> const& chunk : chunks)
+            encodedSize += chunk.size();
+
+        file.Data.reserve(encodedSize);
+
+        detail::ByteWriter writer { file.Data };
+        writer.Write<uint32_t, std::endian::big>('BLTE');
+        writer.Write<uint32_t, std::endian::big>(static_cast<uint32_t>(headerSize));
+        writer.Write<uint32_t, std::endian::big>(0x0F000000u | static_cast<uint32_t>(chunks.size()));
+        for (std::size_t i = 0; i < chunks.size(); ++i) {
+            writer.Write<uint32_t, std::endian::big>(static_cast<uint32_t>(chunks[i].size()));
+            writer.Write<uint32_t, std::endian::big>(static_cast<uint32_t>(chunkSizes[i]));
+            writer.Write(libtactmon::crypto::MD5::Of(std::span<const uint8_t> { chunks[i] }));
+        }
+
+        file.EncodingKey = libtactmon::crypto::MD5::Of(std::span<const uint8_t> { file.Data });
+
+        for (std::vector<uint8_t> const& chunk : chunks)
+            writer.Write(chunk);
+
+        return file;
+    }
+}
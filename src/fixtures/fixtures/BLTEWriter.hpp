@@ -0,0 +1,52 @@
+#pragma once
+
+#include "fixtures/Types.hpp"
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace fixtures {
+    /**
+     * Encoding of the chunks of a BLTE archive.
+     */
+    enum class ChunkMode {
+        None,  //!< 'N': stored as is.
+        Zlib,  //!< 'Z': deflated.
+        Frame, //!< 'F': a nested BLTE archive, itself made of deflated chunks.
+        Mixed  //!< Cycles through 'N', 'Z' and 'F', starting with 'N'.
+    };
+
+    struct BLTEOptions {
+        //! Size of every chunk but the last, before encoding. Zero stores everything in a single chunk.
+        std::size_t ChunkSize = 256 * 1024;
+
+        ChunkMode Mode = ChunkMode::Zlib;
+
+        //! Compression level of deflated chunks, from 0 to 9.
+        int CompressionLevel = 6;
+    };
+
+    /**
+     * A file encoded as a BLTE archive, along with the keys that identify it.
+     */
+    struct EncodedFile {
+        //! MD5 of the decoded contents.
+        Key ContentKey;
+
+        //! MD5 of the BLTE header.
+        Key EncodingKey;
+
+        std::size_t ContentSize = 0;
+
+        //! The archive itself.
+        std::vector<uint8_t> Data;
+    };
+
+    struct BLTEWriter final {
+        /**
+         * Encodes data as a BLTE archive. Every chunk carries a checksum, as does the header through the encoding key.
+         */
+        static EncodedFile Encode(std::span<const uint8_t> content, BLTEOptions const& options);
+    };
+}
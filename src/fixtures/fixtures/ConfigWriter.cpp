@@ -0,0 +1,27 @@
+#include "fixtures/ConfigWriter.hpp"
+
+#include <iterator>
+#include <span>
+
+#include <fmt/format.h>
+
+#include <libtactmon/utility/Hex.hpp>
+
+namespace fixtures {
+    ConfigWriter::ConfigWriter(std::string title) : _title(std::move(title)) { }
+
+    void ConfigWriter::Set(std::string key, std::string value) {
+        _values.emplace_back(std::move(key), std::move(value));
+    }
+
+    NamedFile ConfigWriter::Write() const {
+        std::string contents = fmt::format("# {}\n\n", _title);
+        for (auto&& [key, value] : _values)
+            fmt::format_to(std::back_inserter(contents), "{} = {}\n", key, value);
+
+        NamedFile config;
+        config.Data.assign(contents.begin(), contents.end());
+        config.Name = libtactmon::utility::hex(libtactmon::crypto::MD5::Of(std::span<const uint8_t> { config.Data }));
+        return config;
+    }
+}
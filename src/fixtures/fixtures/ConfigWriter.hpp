@@ -0,0 +1,36 @@
+#pragma once
+
+#include "fixtures/Types.hpp"
+
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace fixtures {
+    /**
+     * Produces configuration files, such as build and CDN configurations: lines of space-separated values, keyed by name.
+     */
+    struct ConfigWriter final {
+        /**
+         * @param[in] title Written as a comment on the first line, e.g. "Build Configuration".
+         */
+        explicit ConfigWriter(std::string title);
+
+        /**
+         * Appends a line; values are written in the order they were set.
+         */
+        void Set(std::string key, std::string value);
+
+        /**
+         * Serializes the configuration.
+         *
+         * @returns The configuration, along with its name: the MD5 of its contents.
+         */
+        NamedFile Write() const;
+
+    private:
+        std::string _title;
+        std::vector<std::pair<std::string, std::string>> _values;
+    };
+}
@@ -0,0 +1,123 @@
+#include "fixtures/EncodingWriter.hpp"
+#include "fixtures/detail/ByteWriter.hpp"
+
+#include <algorithm>
+#include <span>
+#include <tuple>
+
+namespace fixtures {
+    namespace {
+        /**
+         * Lays out fixed-size records in pages, which records never straddle, and builds the page index.
+         */
+        struct PageBuilder {
+            explicit PageBuilder(std::size_t pageSize) : _pageSize(pageSize), _writer(_pages) { }
+
+            /**
+             * Prepares room for a record, starting a new page if needed.
+             */
+            detail::ByteWriter& Begin(Key const& key, std::size_t recordSize) {
+                if (_firstKeys.empty() || _pages.size() + recordSize > _firstKeys.size() * _pageSize) {
+                    _writer.PadTo(_firstKeys.size() * _pageSize);
+                    _firstKeys.push_back(key);
+                }
+
+                return _writer;
+            }
+
+            /**
+             * Pads the last page, then appends the page index followed by the pages.
+             */
+            void WriteTo(detail::ByteWriter& writer) {
+                _writer.PadTo(_firstKeys.size() * _pageSize);
+
+                for (std::size_t i = 0; i < _firstKeys.size(); ++i) {
+                    writer.Write(_firstKeys[i]);
+                    writer.Write(libtactmon::crypto::MD5::Of(std::span<const uint8_t> { _pages }.subspan(i * _pageSize, _pageSize)));
+                }
+
+                writer.Write(_pages);
+            }
+
+            [[nodiscard]] std::size_t pageCount() const { return _firstKeys.size(); }
+
+        private:
+            std::size_t _pageSize;
+
+            std::vector<Key> _firstKeys;
+            std::vector<uint8_t> _pages;
+            detail::ByteWriter _writer;
+        };
+    }
+
+    EncodingWriter::EncodingWriter(uint16_t pageSizeKB) : _pageSize(pageSizeKB * std::size_t { 1024 }) { }
+
+    uint32_t EncodingWriter::AddSpec(std::string spec) {
+        _specs.push_back(std::move(spec));
+        return static_cast<uint32_t>(_specs.size() - 1);
+    }
+
+    void EncodingWriter::Add(Entry const& entry) {
+        _entries.push_back(entry);
+    }
+
+    std::vector<uint8_t> EncodingWriter::Write() {
+        // Content key pages: u8 keyCount, u40 fileSize, u8 ckey[16], u8 ekey[16][keyCount].
+        std::ranges::sort(_entries, [](Entry const& left, Entry const& right) {
+            return std::tie(left.ContentKey, left.EncodingKey) < std::tie(right.ContentKey, right.EncodingKey);
+        });
+
+        PageBuilder contentPages { _pageSize };
+        for (auto itr = _entries.begin(); itr != _entries.end(); ) {
+            auto last = std::find_if(itr, _entries.end(), [&](Entry const& entry) { return entry.ContentKey != itr->ContentKey; });
+            std::size_t keyCount = std::min<std::size_t>(std::distance(itr, last), 0xFF);
+
+            detail::ByteWriter& page = contentPages.Begin(itr->ContentKey, 1 + 5 + 16 + 16 * keyCount);
+            page.Write<uint8_t, std::endian::big>(static_cast<uint8_t>(keyCount));
+            page.WriteUInt<std::endian::big>(itr->ContentSize, 5);
+            page.Write(itr->ContentKey);
+            for (std::size_t i = 0; i < keyCount; ++i)
+                page.Write(itr[i].EncodingKey);
+
+            itr = last;
+        }
+
+        // Encoding key pages: u8 ekey[16], u32 specIndex, u40 encodedSize.
+        std::ranges::sort(_entries, [](Entry const& left, Entry const& right) { return left.EncodingKey < right.EncodingKey; });
+
+        PageBuilder specPages { _pageSize };
+        for (auto itr = _entries.begin(); itr != _entries.end(); ++itr) {
+            if (itr != _entries.begin() && std::prev(itr)->EncodingKey == itr->EncodingKey)
+                continue;
+
+            detail::ByteWriter& page = specPages.Begin(itr->EncodingKey, 16 + 4 + 5);
+            page.Write(itr->EncodingKey);
+            page.Write<uint32_t, std::endian::big>(itr->SpecIndex);
+            page.WriteUInt<std::endian::big>(itr->EncodedSize, 5);
+        }
+
+        std::size_t specBlockSize = 0;
+        for (std::string const& spec : _specs)
+            specBlockSize += spec.size() + 1;
+
+        std::vector<uint8_t> data;
+        detail::ByteWriter writer { data };
+        writer.Write<uint16_t, std::endian::big>(0x454E); // 'EN'
+        writer.Write<uint8_t, std::endian::big>(1);       // Version
+        writer.Write<uint8_t, std::endian::big>(16);      // Encoding key size
+        writer.Write<uint8_t, std::endian::big>(16);      // Content key size
+        writer.Write<uint16_t, std::endian::big>(static_cast<uint16_t>(_pageSize / 1024));
+        writer.Write<uint16_t, std::endian::big>(static_cast<uint16_t>(_pageSize / 1024));
+        writer.Write<uint32_t, std::endian::big>(static_cast<uint32_t>(contentPages.pageCount()));
+        writer.Write<uint32_t, std::endian::big>(static_cast<uint32_t>(specPages.pageCount()));
+        writer.Write<uint8_t, std::endian::big>(0);
+        writer.Write<uint32_t, std::endian::big>(static_cast<uint32_t>(specBlockSize));
+
+        for (std::string const& spec : _specs)
+            writer.WriteCString(spec);
+
+        contentPages.WriteTo(writer);
+        specPages.WriteTo(writer);
+        return data;
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include "fixtures/Types.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fixtures {
+    /**
+     * Produces encoding manifests, which map content keys to encoding keys.
+     */
+    struct EncodingWriter final {
+        struct Entry {
+            Key ContentKey;
+            Key EncodingKey;
+
+            uint64_t ContentSize = 0;
+            uint64_t EncodedSize = 0;
+
+            //! Index of the encoding specification of this file, as returned by @ref AddSpec.
+            uint32_t SpecIndex = 0;
+        };
+
+        /**
+         * @param[in] pageSizeKB Size of the pages of both key tables, in kilobytes.
+         */
+        explicit EncodingWriter(uint16_t pageSizeKB = 4);
+
+        /**
+         * Declares an encoding specification string.
+         *
+         * @returns The index of this specification.
+         */
+        uint32_t AddSpec(std::string spec);
+
+        /**
+         * Adds a file. A content key added several times maps to every encoding key it was added with.
+         */
+        void Add(Entry const& entry);
+
+        void Reserve(std::size_t entryCount) { _entries.reserve(entryCount); }
+
+        /**
+         * Serializes the manifest. Entries are sorted in the process.
+         */
+        std::vector<uint8_t> Write();
+
+    private:
+        std::size_t _pageSize;
+
+        std::vector<std::string> _specs;
+        std::vector<Entry> _entries;
+    };
+}
@@ -0,0 +1,324 @@
+#include "fixtures/ConfigWriter.hpp"
+#include "fixtures/EncodingWriter.hpp"
+#include "fixtures/Generator.hpp"
+#include "fixtures/IndexWriter.hpp"
+#include "fixtures/InstallWriter.hpp"
+#include "fixtures/RootWriter.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <random>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include <libtactmon/utility/Hex.hpp>
+
+namespace fixtures {
+    namespace {
+        using ContentFlags = RootWriter::ContentFlags;
+        using LocaleFlags = RootWriter::LocaleFlags;
+
+        //! Root blocks files are spread over; the first entry of each table is the most common.
+        constexpr const uint32_t Platforms[] = {
+            static_cast<uint32_t>(ContentFlags::LoadOnWindows) | static_cast<uint32_t>(ContentFlags::LoadOnMacOS),
+            static_cast<uint32_t>(ContentFlags::LoadOnWindows) | static_cast<uint32_t>(ContentFlags::LoadOnMacOS),
+            static_cast<uint32_t>(ContentFlags::LoadOnWindows),
+            static_cast<uint32_t>(ContentFlags::LoadOnMacOS),
+        };
+
+        constexpr const uint32_t Locales[] = {
+            0x0001FFF6, // Every locale
+            0x0001FFF6,
+            static_cast<uint32_t>(LocaleFlags::enUS),
+            static_cast<uint32_t>(LocaleFlags::frFR),
+            static_cast<uint32_t>(LocaleFlags::deDE),
+        };
+
+        constexpr const std::pair<std::string_view, uint16_t> InstallTags[] = {
+            { "Windows", 1 }, { "OSX", 1 },
+            { "x86_64", 2 }, { "arm64", 2 },
+            { "enUS", 3 }, { "deDE", 3 }, { "frFR", 3 },
+        };
+
+        constexpr const std::string_view Regions[] = { "us", "eu", "kr", "tw", "cn" };
+
+        /**
+         * Writes files to the cache, keeping track of what was written.
+         */
+        struct Storage {
+            Storage(libtactmon::tact::Cache const& cache, spdlog::logger& logger) : _cache(cache), _logger(logger) { }
+
+            bool Store(std::string_view relativePath, std::span<const uint8_t> data) {
+                std::filesystem::path path = _cache.GetAbsolutePath(relativePath);
+
+                std::error_code ec;
+                std::filesystem::create_directories(path.parent_path(), ec);
+
+                std::ofstream stream { path, std::ios::binary | std::ios::trunc };
+                if (!stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()))) {
+                    _logger.error("Unable to write '{}'.", path.string());
+                    _failed = true;
+                    return false;
+                }
+
+                ++FileCount;
+                ByteCount += data.size();
+                return true;
+            }
+
+            [[nodiscard]] bool failed() const { return _failed; }
+
+            std::size_t FileCount = 0;
+            uint64_t ByteCount = 0;
+
+        private:
+            libtactmon::tact::Cache const& _cache;
+            spdlog::logger& _logger;
+            bool _failed = false;
+        };
+
+        std::string ResourcePath(std::string_view product, std::string_view kind, std::string_view name) {
+            return fmt::format("/tpr/{}/{}/{}/{}/{}", product, kind, name.substr(0, 2), name.substr(2, 2), name);
+        }
+
+        /**
+         * Fills a buffer with bytes that deflate to roughly half their size.
+         */
+        void FillContents(std::span<uint8_t> data, uint64_t seed) {
+            std::mt19937_64 engine { seed };
+            for (std::size_t i = 0; i < data.size(); i += sizeof(uint64_t)) {
+                uint64_t word = engine() & 0x0F0F0F0F0F0F0F0FuLL;
+                std::memcpy(data.data() + i, &word, std::min(sizeof(uint64_t), data.size() - i));
+            }
+        }
+
+        Key RandomKey(std::mt19937_64& engine) {
+            Key key;
+            for (std::size_t i = 0; i < key.size(); i += sizeof(uint64_t)) {
+                uint64_t word = engine();
+                std::memcpy(key.data() + i, &word, sizeof(uint64_t));
+            }
+
+            return key;
+        }
+
+        /**
+         * Describes how files are encoded. libtactmon does not interpret these, so this only approximates the options.
+         */
+        std::string ESpec(BLTEOptions const& options) {
+            char mode = options.Mode == ChunkMode::None ? 'n' : 'z';
+            if (options.ChunkSize == 0)
+                return std::string(1, mode);
+
+            if (options.ChunkSize % 1024 == 0)
+                return fmt::format("b:{{{}K*={}}}", options.ChunkSize / 1024, mode);
+
+            return fmt::format("b:{{{}*={}}}", options.ChunkSize, mode);
+        }
+
+        struct Archive {
+            IndexWriter Index;
+            std::vector<uint8_t> Data;
+
+            //! Offset of the next file, which runs past the data written once files are no longer materialized.
+            uint64_t Size = 0;
+        };
+    }
+
+    /* static */ std::optional<Generator::Result> Generator::Generate(libtactmon::tact::Cache const& cache, Options const& options, spdlog::logger& logger) {
+        using libtactmon::utility::hex;
+
+        std::mt19937_64 engine { options.Seed };
+        Storage storage { cache, logger };
+        Result result;
+
+        EncodingWriter encoding { options.EncodingPageSizeKB };
+        uint32_t fileSpec = encoding.AddSpec(ESpec(options.Files));
+        uint32_t manifestSpec = encoding.AddSpec(ESpec(options.Manifests));
+        encoding.Reserve(options.FileCount + 2);
+
+        RootWriter root { options.RootBlockSize };
+        root.Reserve(options.FileCount);
+
+        InstallWriter install;
+        for (auto&& [name, type] : InstallTags)
+            install.AddTag(std::string { name }, type);
+
+        IndexWriter fileIndex { IndexWriter::Options { .OffsetBytes = 0 } };
+
+        std::vector<Archive> archives(options.ArchiveCount);
+        std::size_t archivedCount = 0;
+
+        std::size_t lookupStride = std::max<std::size_t>(1, std::min(options.MaterializedFileCount, options.FileCount) / std::max<std::size_t>(options.LookupCount, 1));
+
+        // Files.
+        uint32_t fileDataID = 0;
+        for (std::size_t i = 0; i < options.FileCount; ++i) {
+            fileDataID += 1 + static_cast<uint32_t>(engine() % 4);
+
+            bool materialized = i < options.MaterializedFileCount;
+            bool installed = i < options.InstallFileCount;
+            bool named = installed || static_cast<double>(engine() % 1'000'000) < options.NamedRatio * 1'000'000.0;
+            std::string path = fmt::format("fixtures/{:04}/{:08}.dat", fileDataID / 10'000, fileDataID);
+
+            uint64_t contentSize = options.MinFileSize + engine() % (std::max(options.MaxFileSize, options.MinFileSize) - options.MinFileSize + 1);
+
+            EncodingWriter::Entry entry { .ContentSize = contentSize, .SpecIndex = fileSpec };
+            if (materialized) {
+                std::vector<uint8_t> contents(contentSize);
+                FillContents(contents, options.Seed ^ (0x9E3779B97F4A7C15uLL * (i + 1)));
+
+                EncodedFile file = BLTEWriter::Encode(contents, options.Files);
+                entry.ContentKey = file.ContentKey;
+                entry.EncodingKey = file.EncodingKey;
+                entry.EncodedSize = file.Data.size();
+
+                if (i < options.LooseFileCount || archives.empty()) {
+                    storage.Store(ResourcePath(options.Product, "data", hex(file.EncodingKey)), file.Data);
+                    fileIndex.Add(file.EncodingKey, file.Data.size(), 0);
+                }
+                else {
+                    Archive& archive = archives[archivedCount++ % archives.size()];
+                    archive.Index.Add(file.EncodingKey, file.Data.size(), archive.Size);
+                    archive.Data.insert(archive.Data.end(), file.Data.begin(), file.Data.end());
+                    archive.Size += file.Data.size();
+                }
+
+                if (i % lookupStride == 0 && result.Lookups.size() < options.LookupCount * 4) {
+                    result.Lookups.push_back(fmt::format("fdid {}", fileDataID));
+                    result.Lookups.push_back(fmt::format("ckey {}", hex(file.ContentKey)));
+                    result.Lookups.push_back(fmt::format("ekey {}", hex(file.EncodingKey)));
+                    if (named)
+                        result.Lookups.push_back(fmt::format("path {}", path));
+                }
+            }
+            else {
+                // Sizes are those of a file that deflates to 60% of its size, plus a BLTE header.
+                entry.ContentKey = RandomKey(engine);
+                entry.EncodingKey = RandomKey(engine);
+                entry.EncodedSize = contentSize * 3 / 5 + 36;
+
+                if (!archives.empty()) {
+                    Archive& archive = archives[archivedCount++ % archives.size()];
+                    archive.Index.Add(entry.EncodingKey, entry.EncodedSize, archive.Size);
+                    archive.Size += entry.EncodedSize;
+                }
+            }
+
+            encoding.Add(entry);
+
+            uint32_t platform = Platforms[engine() % std::size(Platforms)];
+            uint32_t locales = Locales[engine() % std::size(Locales)];
+            if (named)
+                root.Add(fileDataID, entry.ContentKey, path, static_cast<ContentFlags>(platform), static_cast<LocaleFlags>(locales));
+            else
+                root.Add(fileDataID, entry.ContentKey, std::nullopt, static_cast<ContentFlags>(platform), static_cast<LocaleFlags>(locales));
+
+            if (installed) {
+                std::size_t installIndex = install.AddFile(path, entry.ContentKey, static_cast<uint32_t>(contentSize));
+                for (std::size_t tag = 0; tag < std::size(InstallTags); ++tag)
+                    if ((engine() & 1) != 0)
+                        install.Tag(tag, installIndex);
+            }
+        }
+
+        logger.info("Generated {} files, {} of which were materialized.", options.FileCount, std::min(options.FileCount, options.MaterializedFileCount));
+
+        // Archives and their indices.
+        ConfigWriter cdnConfig { "CDN Configuration" };
+        {
+            std::string archiveNames;
+            std::string archiveSizes;
+            for (Archive& archive : archives) {
+                NamedFile index = archive.Index.Write();
+                storage.Store(ResourcePath(options.Product, "data", index.Name + ".index"), index.Data);
+                if (!archive.Data.empty())
+                    storage.Store(ResourcePath(options.Product, "data", index.Name), archive.Data);
+
+                fmt::format_to(std::back_inserter(archiveNames), "{}{}", archiveNames.empty() ? "" : " ", index.Name);
+                fmt::format_to(std::back_inserter(archiveSizes), "{}{}", archiveSizes.empty() ? "" : " ", index.Data.size());
+
+                archive = Archive { };
+            }
+
+            if (!archives.empty()) {
+                cdnConfig.Set("archives", std::move(archiveNames));
+                cdnConfig.Set("archives-index-size", std::move(archiveSizes));
+            }
+
+            logger.info("Wrote {} archive indices.", archives.size());
+        }
+
+        // Manifests, which are stored outside of archives.
+        auto storeManifest = [&](std::vector<uint8_t> const& contents) {
+            EncodedFile file = BLTEWriter::Encode(contents, options.Manifests);
+            storage.Store(ResourcePath(options.Product, "data", hex(file.EncodingKey)), file.Data);
+            fileIndex.Add(file.EncodingKey, file.Data.size(), 0);
+            return file;
+        };
+
+        ConfigWriter buildConfig { "Build Configuration" };
+        {
+            EncodedFile file = storeManifest(root.Write());
+            encoding.Add(EncodingWriter::Entry { file.ContentKey, file.EncodingKey, file.ContentSize, file.Data.size(), manifestSpec });
+            buildConfig.Set("root", hex(file.ContentKey));
+
+            logger.info("Wrote root manifest ({} bytes).", file.ContentSize);
+        }
+        {
+            EncodedFile file = storeManifest(install.Write());
+            encoding.Add(EncodingWriter::Entry { file.ContentKey, file.EncodingKey, file.ContentSize, file.Data.size(), manifestSpec });
+            buildConfig.Set("install", fmt::format("{} {}", hex(file.ContentKey), hex(file.EncodingKey)));
+            buildConfig.Set("install-size", fmt::format("{} {}", file.ContentSize, file.Data.size()));
+
+            logger.info("Wrote install manifest ({} bytes).", file.ContentSize);
+        }
+        {
+            EncodedFile file = storeManifest(encoding.Write());
+            buildConfig.Set("encoding", fmt::format("{} {}", hex(file.ContentKey), hex(file.EncodingKey)));
+            buildConfig.Set("encoding-size", fmt::format("{} {}", file.ContentSize, file.Data.size()));
+
+            logger.info("Wrote encoding manifest ({} bytes).", file.ContentSize);
+        }
+
+        buildConfig.Set("build-name", fmt::format("WOW-{}patch1.0.0_Fixture", options.BuildID));
+        buildConfig.Set("build-uid", options.Product);
+        buildConfig.Set("build-product", "WoW");
+
+        // File index, listing loose files and manifests.
+        NamedFile fileIndexFile = fileIndex.Write();
+        storage.Store(ResourcePath(options.Product, "data", fileIndexFile.Name + ".index"), fileIndexFile.Data);
+        cdnConfig.Set("file-index", fileIndexFile.Name);
+        cdnConfig.Set("file-index-size", fmt::format("{}", fileIndexFile.Data.size()));
+
+        // Configurations, and the Ribbit table that points at them.
+        NamedFile buildConfigFile = buildConfig.Write();
+        NamedFile cdnConfigFile = cdnConfig.Write();
+        storage.Store(ResourcePath(options.Product, "config", buildConfigFile.Name), buildConfigFile.Data);
+        storage.Store(ResourcePath(options.Product, "config", cdnConfigFile.Name), cdnConfigFile.Data);
+
+        std::string versions = "Region!STRING:0|BuildConfig!HEX:16|CDNConfig!HEX:16|KeyRing!HEX:16|BuildId!DEC:4|VersionsName!String:0|ProductConfig!HEX:16\n"
+            "## seqn = 1\n";
+        for (std::string_view region : Regions)
+            fmt::format_to(std::back_inserter(versions), "{}|{}|{}||{}|1.0.0.{}|\n", region, buildConfigFile.Name, cdnConfigFile.Name,
+                options.BuildID, options.BuildID);
+
+        storage.Store(fmt::format("/ribbit/{}/versions", options.Product),
+            std::span<const uint8_t> { reinterpret_cast<const uint8_t*>(versions.data()), versions.size() });
+
+        if (storage.failed())
+            return std::nullopt;
+
+        result.BuildConfig = buildConfigFile.Name;
+        result.CDNConfig = cdnConfigFile.Name;
+        result.FileCount = storage.FileCount;
+        result.ByteCount = storage.ByteCount;
+        return result;
+    }
+}
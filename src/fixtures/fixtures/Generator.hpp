@@ -0,0 +1,87 @@
+#pragma once
+
+#include "fixtures/BLTEWriter.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <spdlog/logger.h>
+
+#include <libtactmon/tact/Cache.hpp>
+
+namespace fixtures {
+    /**
+     * Generates a synthetic World of Warcraft build, laid out like a @c tact::Cache: configurations, encoding, install
+     * and root manifests, archives with their indices, and a file index. The output is a function of the options and
+     * nothing else, so that parsers can be benchmarked against the exact same inputs.
+     *
+     * Ribbit tables pointing at the build are written under @c ribbit/<product>, so that @c tactmon-fakecdn can serve the
+     * cache as is.
+     */
+    struct Generator final {
+        struct Options {
+            //! Files are written under tpr/<product>.
+            std::string Product = "wow";
+            uint32_t BuildID = 1;
+            uint64_t Seed = 0;
+
+            //! Amount of files listed by the encoding and root manifests.
+            std::size_t FileCount = 10'000;
+
+            //! Amount of files whose contents are generated and written to disk. Other files are only listed by manifests
+            //! and indices, with random keys; they can be located, but not opened.
+            std::size_t MaterializedFileCount = 1'000;
+
+            //! Amount of materialized files stored outside of archives, and listed by the file index.
+            std::size_t LooseFileCount = 16;
+
+            //! Amount of archives that files are spread over.
+            std::size_t ArchiveCount = 16;
+
+            //! Amount of files listed by the install manifest, starting with the first materialized file.
+            std::size_t InstallFileCount = 100;
+
+            //! Proportion of the files of the root manifest that have a name hash.
+            double NamedRatio = 0.75;
+
+            //! Bounds of the size of materialized files.
+            std::size_t MinFileSize = 64;
+            std::size_t MaxFileSize = 64 * 1024;
+
+            //! Maximum amount of files in a root block; zero is unbounded.
+            std::size_t RootBlockSize = 0;
+
+            uint16_t EncodingPageSizeKB = 4;
+
+            //! Amount of files sampled for @ref Result::Lookups.
+            std::size_t LookupCount = 100;
+
+            //! Encoding of materialized files.
+            BLTEOptions Files { .ChunkSize = 16 * 1024, .Mode = ChunkMode::Mixed };
+
+            //! Encoding of manifests.
+            BLTEOptions Manifests { .ChunkSize = 1024 * 1024, .Mode = ChunkMode::Zlib };
+        };
+
+        struct Result {
+            //! Names of the configuration files of the build.
+            std::string BuildConfig;
+            std::string CDNConfig;
+
+            //! A sample of materialized files, as "<kind> <value>" lines where kind is one of path, fdid, ckey and ekey.
+            std::vector<std::string> Lookups;
+
+            std::size_t FileCount = 0;
+            uint64_t ByteCount = 0;
+        };
+
+        /**
+         * Generates a build.
+         *
+         * @returns A summary of the build, or an empty optional if any file could not be written.
+         */
+        static std::optional<Result> Generate(libtactmon::tact::Cache const& cache, Options const& options, spdlog::logger& logger);
+    };
+}
@@ -0,0 +1,75 @@
+#include "fixtures/IndexWriter.hpp"
+#include "fixtures/detail/ByteWriter.hpp"
+
+#include <algorithm>
+#include <span>
+
+#include <libtactmon/utility/Hex.hpp>
+
+namespace fixtures {
+    IndexWriter::IndexWriter(Options options) : _options(options) { }
+
+    void IndexWriter::Add(Key const& encodingKey, uint64_t size, uint64_t offset) {
+        _entries.push_back(Entry { encodingKey, size, offset });
+    }
+
+    NamedFile IndexWriter::Write() {
+        std::ranges::sort(_entries, [](Entry const& left, Entry const& right) { return left.EncodingKey < right.EncodingKey; });
+
+        std::size_t checksumSize = _options.ChecksumSize;
+        std::size_t blockSize = _options.BlockSizeKB * std::size_t { 1024 };
+        std::size_t entrySize = 16 + _options.SizeBytes + _options.OffsetBytes;
+        std::size_t entriesPerBlock = blockSize / entrySize;
+        std::size_t blockCount = (_entries.size() + entriesPerBlock - 1) / entriesPerBlock;
+
+        NamedFile index;
+        index.Data.reserve(blockCount * (blockSize + 16 + checksumSize) + checksumSize * 2 + 12);
+
+        detail::ByteWriter writer { index.Data };
+
+        // Blocks, zero-padded.
+        for (std::size_t i = 0; i < _entries.size(); ++i) {
+            writer.Write(_entries[i].EncodingKey);
+            writer.WriteUInt<std::endian::big>(_entries[i].Size, _options.SizeBytes);
+            writer.WriteUInt<std::endian::big>(_entries[i].Offset, _options.OffsetBytes);
+
+            if ((i + 1) % entriesPerBlock == 0 || i + 1 == _entries.size())
+                writer.PadTo((i / entriesPerBlock + 1) * blockSize);
+        }
+
+        // Table of contents: the last key of every block, then the checksum of every block.
+        std::size_t tocOffset = writer.size();
+        for (std::size_t i = 0; i < blockCount; ++i)
+            writer.Write(_entries[std::min((i + 1) * entriesPerBlock, _entries.size()) - 1].EncodingKey);
+
+        for (std::size_t i = 0; i < blockCount; ++i) {
+            auto digest = libtactmon::crypto::MD5::Of(std::span<const uint8_t> { index.Data }.subspan(i * blockSize, blockSize));
+            writer.Write(std::span<const uint8_t> { digest }.first(checksumSize));
+        }
+
+        auto tocHash = libtactmon::crypto::MD5::Of(std::span<const uint8_t> { index.Data }.subspan(tocOffset));
+
+        // Footer.
+        std::size_t footerOffset = writer.size();
+        writer.Write(std::span<const uint8_t> { tocHash }.first(checksumSize));
+        writer.Write<uint8_t, std::endian::little>(1); // Version
+        writer.Write<uint8_t, std::endian::little>(0);
+        writer.Write<uint8_t, std::endian::little>(0);
+        writer.Write<uint8_t, std::endian::little>(_options.BlockSizeKB);
+        writer.Write<uint8_t, std::endian::little>(_options.OffsetBytes);
+        writer.Write<uint8_t, std::endian::little>(_options.SizeBytes);
+        writer.Write<uint8_t, std::endian::little>(16); // Key size
+        writer.Write<uint8_t, std::endian::little>(_options.ChecksumSize);
+        writer.Write<uint32_t, std::endian::little>(static_cast<uint32_t>(_entries.size()));
+
+        // The footer checksum covers the footer from its version onwards, with the checksum itself zeroed.
+        std::size_t footerChecksumOffset = writer.size();
+        writer.PadTo(footerChecksumOffset + checksumSize);
+
+        auto footerChecksum = libtactmon::crypto::MD5::Of(std::span<const uint8_t> { index.Data }.subspan(footerOffset + checksumSize));
+        std::copy_n(footerChecksum.begin(), checksumSize, index.Data.begin() + footerChecksumOffset);
+
+        index.Name = libtactmon::utility::hex(libtactmon::crypto::MD5::Of(std::span<const uint8_t> { index.Data }.subspan(footerOffset)));
+        return index;
+    }
+}
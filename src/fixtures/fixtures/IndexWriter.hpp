@@ -0,0 +1,52 @@
+#pragma once
+
+#include "fixtures/Types.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace fixtures {
+    /**
+     * Produces archive indices, which locate encoded files within an archive.
+     *
+     * File indices, which list files stored outside of archives, are indices with no offsets.
+     */
+    struct IndexWriter final {
+        struct Options {
+            uint8_t BlockSizeKB = 4;
+
+            //! Width of offsets, in bytes; zero for file indices.
+            uint8_t OffsetBytes = 4;
+
+            //! Width of sizes, in bytes.
+            uint8_t SizeBytes = 4;
+
+            //! Size of the truncated MD5 checksums of blocks, of the table of contents, and of the footer.
+            uint8_t ChecksumSize = 8;
+        };
+
+        IndexWriter() : IndexWriter(Options { }) { }
+        explicit IndexWriter(Options options);
+
+        void Add(Key const& encodingKey, uint64_t size, uint64_t offset);
+
+        void Reserve(std::size_t entryCount) { _entries.reserve(entryCount); }
+
+        /**
+         * Serializes the index. Entries are sorted in the process.
+         *
+         * @returns The index, along with its name: the MD5 of its footer, which is also the name of the archive.
+         */
+        NamedFile Write();
+
+    private:
+        struct Entry {
+            Key EncodingKey;
+            uint64_t Size;
+            uint64_t Offset;
+        };
+
+        Options _options;
+        std::vector<Entry> _entries;
+    };
+}
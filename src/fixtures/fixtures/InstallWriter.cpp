@@ -0,0 +1,51 @@
+#include "fixtures/InstallWriter.hpp"
+#include "fixtures/detail/ByteWriter.hpp"
+
+#include <algorithm>
+
+namespace fixtures {
+    std::size_t InstallWriter::AddTag(std::string name, uint16_t type) {
+        _tags.push_back(TagEntry { std::move(name), type, { } });
+        return _tags.size() - 1;
+    }
+
+    std::size_t InstallWriter::AddFile(std::string name, Key const& contentKey, uint32_t size) {
+        _files.push_back(FileEntry { std::move(name), contentKey, size });
+        return _files.size() - 1;
+    }
+
+    void InstallWriter::Tag(std::size_t tag, std::size_t file) {
+        _tags[tag].Files.push_back(file);
+    }
+
+    std::vector<uint8_t> InstallWriter::Write() const {
+        std::vector<uint8_t> data;
+        detail::ByteWriter writer { data };
+
+        writer.Write<uint16_t, std::endian::big>(0x494E); // 'IN'
+        writer.Write<uint8_t, std::endian::big>(1);       // Version
+        writer.Write<uint8_t, std::endian::big>(16);      // Content key size
+        writer.Write<uint16_t, std::endian::big>(static_cast<uint16_t>(_tags.size()));
+        writer.Write<uint32_t, std::endian::big>(static_cast<uint32_t>(_files.size()));
+
+        // The first file maps to the most significant bit of the first byte of a mask.
+        std::vector<uint8_t> mask((_files.size() + 7) / 8);
+        for (TagEntry const& tag : _tags) {
+            std::fill(mask.begin(), mask.end(), 0);
+            for (std::size_t file : tag.Files)
+                mask[file / 8] |= static_cast<uint8_t>(0x80 >> (file % 8));
+
+            writer.WriteCString(tag.Name);
+            writer.Write<uint16_t, std::endian::big>(tag.Type);
+            writer.Write(mask);
+        }
+
+        for (FileEntry const& file : _files) {
+            writer.WriteCString(file.Name);
+            writer.Write(file.ContentKey);
+            writer.Write<uint32_t, std::endian::big>(file.Size);
+        }
+
+        return data;
+    }
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include "fixtures/Types.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fixtures {
+    /**
+     * Produces install manifests, which list the files installed alongside the client and the tags that select them.
+     */
+    struct InstallWriter final {
+        /**
+         * Declares a tag.
+         *
+         * @returns The index of this tag.
+         */
+        std::size_t AddTag(std::string name, uint16_t type);
+
+        /**
+         * Adds a file.
+         *
+         * @returns The index of this file.
+         */
+        std::size_t AddFile(std::string name, Key const& contentKey, uint32_t size);
+
+        /**
+         * Selects a file for a tag.
+         */
+        void Tag(std::size_t tag, std::size_t file);
+
+        std::vector<uint8_t> Write() const;
+
+    private:
+        struct TagEntry {
+            std::string Name;
+            uint16_t Type;
+            std::vector<std::size_t> Files;
+        };
+
+        struct FileEntry {
+            std::string Name;
+            Key ContentKey;
+            uint32_t Size;
+        };
+
+        std::vector<TagEntry> _tags;
+        std::vector<FileEntry> _files;
+    };
+}
@@ -0,0 +1,76 @@
+#include "fixtures/RootWriter.hpp"
+#include "fixtures/detail/ByteWriter.hpp"
+
+#include <algorithm>
+#include <span>
+#include <tuple>
+
+#include <libtactmon/crypto/Jenkins.hpp>
+
+namespace fixtures {
+    RootWriter::RootWriter(std::size_t maxBlockSize) : _maxBlockSize(maxBlockSize) { }
+
+    void RootWriter::Add(uint32_t fileDataID, Key const& contentKey, std::string_view path, ContentFlags content, LocaleFlags locales) {
+        Add(fileDataID, contentKey, libtactmon::crypto::JenkinsHash(path), content, locales);
+    }
+
+    void RootWriter::Add(uint32_t fileDataID, Key const& contentKey, std::optional<uint64_t> nameHash, ContentFlags content, LocaleFlags locales) {
+        uint32_t contentFlags = static_cast<uint32_t>(content) & ~static_cast<uint32_t>(ContentFlags::NoNameHash);
+        if (!nameHash.has_value())
+            contentFlags |= static_cast<uint32_t>(ContentFlags::NoNameHash);
+        else
+            ++_namedCount;
+
+        _entries.push_back(Entry { contentFlags, static_cast<uint32_t>(locales), fileDataID, contentKey, nameHash.value_or(0) });
+    }
+
+    std::vector<uint8_t> RootWriter::Write() {
+        // Files sharing the same flags are grouped in blocks, in ascending file data ID order.
+        std::ranges::sort(_entries, [](Entry const& left, Entry const& right) {
+            return std::tie(left.Content, left.Locales, left.FileDataID) < std::tie(right.Content, right.Locales, right.FileDataID);
+        });
+
+        bool allNamed = _namedCount == _entries.size();
+
+        std::vector<uint8_t> data;
+        detail::ByteWriter writer { data };
+        writer.Write<uint32_t, std::endian::little>(0x4D465354); // 'MFST'
+        writer.Write<uint32_t, std::endian::little>(static_cast<uint32_t>(_entries.size()));
+        writer.Write<uint32_t, std::endian::little>(static_cast<uint32_t>(_namedCount));
+
+        for (auto first = _entries.begin(); first != _entries.end(); ) {
+            auto last = std::find_if(first, _entries.end(), [&](Entry const& entry) {
+                return entry.Content != first->Content || entry.Locales != first->Locales;
+            });
+
+            if (_maxBlockSize != 0 && static_cast<std::size_t>(std::distance(first, last)) > _maxBlockSize)
+                last = first + _maxBlockSize;
+
+            std::span<const Entry> block { first, last };
+
+            // u32 numRecords, u32 contentFlags, u32 localeFlags, then u32 fileDataIDDelta[numRecords], u8 ckey[16][numRecords],
+            // and u64 nameHash[numRecords] unless the block opts out.
+            writer.Write<uint32_t, std::endian::little>(static_cast<uint32_t>(block.size()));
+            writer.Write<uint32_t, std::endian::little>(block.front().Content);
+            writer.Write<uint32_t, std::endian::little>(block.front().Locales);
+
+            uint32_t previousFileDataID = static_cast<uint32_t>(-1);
+            for (Entry const& entry : block) {
+                writer.Write<uint32_t, std::endian::little>(entry.FileDataID - previousFileDataID - 1);
+                previousFileDataID = entry.FileDataID;
+            }
+
+            for (Entry const& entry : block)
+                writer.Write(entry.ContentKey);
+
+            if (allNamed || (block.front().Content & static_cast<uint32_t>(ContentFlags::NoNameHash)) == 0) {
+                for (Entry const& entry : block)
+                    writer.Write<uint64_t, std::endian::little>(entry.NameHash);
+            }
+
+            first = last;
+        }
+
+        return data;
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+
+#include "fixtures/Types.hpp"
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+#include <vector>
+
+#include <libtactmon/tact/data/product/wow/Root.hpp>
+
+namespace fixtures {
+    /**
+     * Produces World of Warcraft root manifests, in the MFST format.
+     */
+    struct RootWriter final {
+        using ContentFlags = libtactmon::tact::data::product::wow::Root::ContentFlags;
+        using LocaleFlags = libtactmon::tact::data::product::wow::Root::LocaleFlags;
+
+        /**
+         * @param[in] maxBlockSize The maximum amount of files in a block; zero puts every file sharing the same flags in a
+         *                         single block.
+         */
+        explicit RootWriter(std::size_t maxBlockSize = 0);
+
+        /**
+         * Adds a named file.
+         */
+        void Add(uint32_t fileDataID, Key const& contentKey, std::string_view path, ContentFlags content, LocaleFlags locales);
+
+        /**
+         * Adds a file. Files without a name hash are placed in blocks flagged with @c ContentFlags::NoNameHash.
+         */
+        void Add(uint32_t fileDataID, Key const& contentKey, std::optional<uint64_t> nameHash, ContentFlags content, LocaleFlags locales);
+
+        void Reserve(std::size_t entryCount) { _entries.reserve(entryCount); }
+
+        /**
+         * Serializes the manifest. Entries are sorted in the process.
+         */
+        std::vector<uint8_t> Write();
+
+    private:
+        struct Entry {
+            uint32_t Content;
+            uint32_t Locales;
+            uint32_t FileDataID;
+            Key ContentKey;
+            uint64_t NameHash;
+        };
+
+        std::size_t _maxBlockSize;
+        std::size_t _namedCount = 0;
+        std::vector<Entry> _entries;
+    };
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <libtactmon/crypto/Hash.hpp>
+
+namespace fixtures {
+    /**
+     * A content or encoding key.
+     *
+     * Writers store keys inline rather than as @c tact::CKey or @c tact::EKey, which allocate; manifests of millions of
+     * entries would otherwise spend most of their time in the allocator.
+     */
+    using Key = libtactmon::crypto::MD5::Digest;
+
+    /**
+     * A file whose name is derived from its contents, such as a configuration file or an archive index.
+     */
+    struct NamedFile {
+        std::string Name;
+        std::vector<uint8_t> Data;
+    };
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+namespace fixtures::detail {
+    /**
+     * Appends integers, strings and raw bytes to a buffer; the writing counterpart of @c io::SpanReader.
+     */
+    struct ByteWriter final {
+        explicit ByteWriter(std::vector<uint8_t>& buffer) : _buffer(buffer) { }
+
+        template <std::unsigned_integral T, std::endian Endianness>
+        void Write(T value) {
+            WriteUInt<Endianness>(value, sizeof(T));
+        }
+
+        /**
+         * Writes the @p width least significant bytes of a value.
+         */
+        template <std::endian Endianness>
+        void WriteUInt(uint64_t value, std::size_t width) {
+            for (std::size_t i = 0; i < width; ++i) {
+                std::size_t shift = Endianness == std::endian::big ? (width - 1 - i) * 8 : i * 8;
+                _buffer.push_back(static_cast<uint8_t>(value >> shift));
+            }
+        }
+
+        void Write(std::span<const uint8_t> data) {
+            _buffer.insert(_buffer.end(), data.begin(), data.end());
+        }
+
+        void Write(std::string_view data) {
+            _buffer.insert(_buffer.end(), data.begin(), data.end());
+        }
+
+        void WriteCString(std::string_view value) {
+            Write(value);
+            _buffer.push_back(0);
+        }
+
+        /**
+         * Appends zeroes until the buffer is @p size bytes long.
+         */
+        void PadTo(std::size_t size) {
+            if (_buffer.size() < size)
+                _buffer.resize(size, 0);
+        }
+
+        [[nodiscard]] std::size_t size() const { return _buffer.size(); }
+
+    private:
+        std::vector<uint8_t>& _buffer;
+    };
+}
@@ -4,7 +4,7 @@
 #include <string>
 
 namespace libtactmon::crypto {
-    uint32_t JenkinsHash(std::string_view path) {
+    uint64_t JenkinsHash(std::string_view path) {
         std::string normalizedPath { path };
 
         for (std::string::value_type& c : normalizedPath) {
@@ -17,6 +17,6 @@ namespace libtactmon::crypto {
         uint32_t pc = 0;
         uint32_t pb = 0;
         hashlittle2(normalizedPath.data(), normalizedPath.size(), &pc, &pb);
-        return pc;
+        return (uint64_t { pc } << 32) | pb;
     }
 }
@@ -4,5 +4,13 @@
 #include <string_view>
 
 namespace libtactmon::crypto {
-    uint32_t JenkinsHash(std::string_view path);
+    /**
+     * Computes the name hash of a file, as stored in WoW root manifests: both halves of lookup3's hashlittle2, over the
+     * path with forward slashes turned into backslashes and uppercased.
+     *
+     * The primary hash (pc) is the upper half, as in CascLib's CalcFileNameHash. hashlittle2 itself matches the reference
+     * vectors of lookup3.c: over "Four score and seven years ago" with both seeds at zero, pc is 0x17770551 and pb is
+     * 0xCE7226E6. libtactmon-bench checks these before benchmarking this function.
+     */
+    uint64_t JenkinsHash(std::string_view path);
 }
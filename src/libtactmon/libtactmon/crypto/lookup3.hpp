@@ -40,6 +40,7 @@ on 1 byte), but shoehorning those bytes into integers efficiently is messy.
 #include <stdio.h>      /* defines printf for tests */
 #include <time.h>       /* defines time_t for timings in the test */
 #include <stdint.h>     /* defines uint32_t etc */
+#include <cstddef>      /* defines std::size_t */
 #ifdef linux
 #include <sys/param.h>  /* attempt to define endianness */
 #include <endian.h>    /* attempt to define endianness */
@@ -1,133 +1,170 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <cstdint>
-#include <limits>
-#include <span>
+#include <cstring>
+#include <iterator>
+#include <ranges>
 #include <string_view>
-#include <vector>
 
 namespace libtactmon::detail {
-    template <typename CharT, typename Traits = std::char_traits<CharT>>
-    std::vector<std::basic_string_view<CharT, Traits>> Tokenize(
-        std::basic_string_view<CharT, Traits> input,
-        std::basic_string_view<CharT, Traits> token,
-        bool removeEmptyTokens)
-    {
-        std::vector<std::basic_string_view<CharT, Traits>> result;
-
-        while (!input.empty()) {
-            auto pos = input.find(token);
-            if (pos == std::basic_string_view<CharT, Traits>::npos) {
-                if (!removeEmptyTokens || !input.empty())
-                    result.push_back(input);
-
-                break;
-            }
-            else {
-                auto elem = input.substr(0, pos);
-                if (!removeEmptyTokens || !elem.empty())
-                    result.push_back(elem);
-
-                input.remove_prefix(pos + token.length());
-            }
+    /**
+     * A set of single-character delimiters, stored as a 256-bit membership table: looking for the next delimiter costs a
+     * single pass over the input, regardless of the amount of delimiters. Sets of a single delimiter use @c memchr.
+     */
+    struct DelimiterSet final {
+        constexpr DelimiterSet(char delimiter) noexcept : _single(delimiter), _count(1) {
+            Insert(delimiter);
         }
 
-        return result;
-    }
+        constexpr DelimiterSet(char const* delimiters) noexcept : DelimiterSet(std::string_view { delimiters }) { }
 
-    template <typename CharT, typename Traits = std::char_traits<CharT>>
-    std::vector<std::basic_string_view<CharT, Traits>> Tokenize(
-        std::basic_string_view<CharT, Traits> input,
-        std::span<const std::basic_string_view<CharT, Traits>> tokens,
-        bool removeEmptyTokens)
-    {
-        std::vector<std::basic_string_view<CharT, Traits>> result;
-
-        while (!input.empty()) {
-            std::basic_string_view<CharT, Traits>* selectedToken = nullptr;
-            std::size_t tokenPosition = std::numeric_limits<std::size_t>::max();
-
-            for (std::basic_string_view<CharT, Traits> token : tokens) {
-                auto pos = input.find(token);
-                if (pos != std::basic_string_view<CharT, Traits>::npos && pos < tokenPosition) {
-                    selectedToken = &token;
-                    tokenPosition = pos;
+        constexpr DelimiterSet(std::string_view delimiters) noexcept {
+            for (char delimiter : delimiters) {
+                if (!contains(delimiter)) {
+                    Insert(delimiter);
+                    _single = delimiter;
+                    ++_count;
                 }
             }
+        }
 
-            if (selectedToken == nullptr) {
-                if (!removeEmptyTokens || !input.empty())
-                    result.push_back(input);
+        [[nodiscard]] constexpr bool contains(char value) const noexcept {
+            uint8_t index = static_cast<uint8_t>(value);
+            return (_table[index >> 6] >> (index & 63)) & 1;
+        }
 
-                break;
-            } else {
-                if (!removeEmptyTokens || tokenPosition > 0)
-                    result.push_back(input.substr(0, tokenPosition));
+        /**
+         * Returns the position of the first delimiter in the input, or @c std::string_view::npos.
+         */
+        [[nodiscard]] std::size_t find(std::string_view input) const noexcept {
+            if (input.empty())
+                return std::string_view::npos;
+
+            if (_count == 1) {
+                void const* position = std::memchr(input.data(), _single, input.size());
+                return position != nullptr
+                    ? static_cast<std::size_t>(static_cast<char const*>(position) - input.data())
+                    : std::string_view::npos;
+            }
 
-                input.remove_prefix(tokenPosition + selectedToken->length());
+            for (std::size_t i = 0; i < input.size(); ++i) {
+                if (contains(input[i]))
+                    return i;
             }
+
+            return std::string_view::npos;
         }
 
-        return result;
-    }
+    private:
+        constexpr void Insert(char value) noexcept {
+            uint8_t index = static_cast<uint8_t>(value);
+            _table[index >> 6] |= uint64_t { 1 } << (index & 63);
+        }
 
-    template <typename CharT, typename Traits = std::char_traits<CharT>>
-    std::vector<std::basic_string_view<CharT, Traits>> Tokenize(
-        std::basic_string_view<CharT, Traits> input,
-        CharT token,
-        bool removeEmptyTokens)
-    {
-        std::vector<std::basic_string_view<CharT, Traits>> result;
-
-        while (!input.empty()) {
-            auto pos = input.find(token);
-            if (pos == std::basic_string_view<CharT, Traits>::npos) {
-                if (!removeEmptyTokens || !input.empty())
-                    result.push_back(input);
-
-                break;
+        std::array<uint64_t, 4> _table { };
+        char _single = 0;
+        std::size_t _count = 0;
+    };
+
+    /**
+     * A lazy view over the tokens of a string separated by any of a set of delimiters. Tokens are views into the input,
+     * found as the view is iterated; nothing is allocated.
+     *
+     * A delimiter at the very end of the input does not produce an empty token.
+     */
+    class SplitView final : public std::ranges::view_interface<SplitView> {
+    public:
+        struct sentinel { };
+
+        class iterator {
+        public:
+            using iterator_concept = std::forward_iterator_tag;
+            using iterator_category = std::forward_iterator_tag;
+            using value_type = std::string_view;
+            using difference_type = std::ptrdiff_t;
+            using reference = std::string_view;
+
+            iterator() = default;
+
+            iterator(std::string_view input, DelimiterSet delimiters, bool removeEmptyTokens) noexcept
+                : _remainder(input), _delimiters(delimiters), _removeEmptyTokens(removeEmptyTokens), _done(false)
+            {
+                Advance();
             }
-            else {
-                std::basic_string_view<CharT, Traits> elem = input.substr(0, pos);
-                if (!removeEmptyTokens || !elem.empty())
-                    result.push_back(elem);
 
-                input.remove_prefix(pos + 1);
-            }
-        }
+            reference operator * () const noexcept { return _current; }
 
-        return result;
-    }
+            iterator& operator ++ () noexcept {
+                Advance();
+                return *this;
+            }
 
-    template <typename CharT, std::size_t N, typename Traits = std::char_traits<CharT>>
-    std::vector<std::basic_string_view<CharT, Traits>> Tokenize(
-        std::basic_string_view<CharT, Traits> input,
-        std::span<const CharT, N> tokens,
-        bool removeEmptyTokens)
-    {
-        std::vector<std::basic_string_view<CharT, Traits>> result;
-
-        while (!input.empty()) {
-            std::size_t tokenPosition = std::numeric_limits<std::size_t>::max();
-
-            for (CharT token : tokens) {
-                auto pos = input.find(token);
-                if (pos != std::basic_string_view<CharT, Traits>::npos && pos < tokenPosition) {
-                    tokenPosition = pos;
-                }
+            iterator operator ++ (int) noexcept {
+                iterator copy = *this;
+                Advance();
+                return copy;
             }
 
-            if (tokenPosition == std::numeric_limits<std::size_t>::max()) {
-                result.push_back(input);
-                break;
+            friend bool operator == (iterator const& left, iterator const& right) noexcept {
+                return left._done == right._done && (left._done || left._current.data() == right._current.data());
             }
-            else {
-                if (!removeEmptyTokens || tokenPosition > 0)
-                    result.push_back(input.substr(0, tokenPosition));
-                input.remove_prefix(tokenPosition + 1);
+
+            friend bool operator == (iterator const& itr, sentinel) noexcept { return itr._done; }
+
+        private:
+            void Advance() noexcept {
+                while (!_remainder.empty()) {
+                    std::size_t position = _delimiters.find(_remainder);
+                    if (position == std::string_view::npos) {
+                        _current = _remainder;
+                        _remainder = _remainder.substr(_remainder.size());
+                        return;
+                    }
+
+                    _current = _remainder.substr(0, position);
+                    _remainder.remove_prefix(position + 1);
+                    if (!_removeEmptyTokens || !_current.empty())
+                        return;
+                }
+
+                _current = { };
+                _done = true;
             }
-        }
 
-        return result;
+            std::string_view _remainder;
+            std::string_view _current;
+            DelimiterSet _delimiters { std::string_view { } };
+            bool _removeEmptyTokens = false;
+            bool _done = true;
+        };
+
+        SplitView() = default;
+
+        SplitView(std::string_view input, DelimiterSet delimiters, bool removeEmptyTokens) noexcept
+            : _input(input), _delimiters(delimiters), _removeEmptyTokens(removeEmptyTokens)
+        { }
+
+        [[nodiscard]] iterator begin() const noexcept { return iterator { _input, _delimiters, _removeEmptyTokens }; }
+        [[nodiscard]] sentinel end() const noexcept { return sentinel { }; }
+
+    private:
+        std::string_view _input;
+        DelimiterSet _delimiters { std::string_view { } };
+        bool _removeEmptyTokens = false;
+    };
+
+    /**
+     * Splits a string on any of a set of single-character delimiters.
+     *
+     * @param[in] input             The string to split. It must outlive the view.
+     * @param[in] delimiters        A single delimiter, or a string of delimiters.
+     * @param[in] removeEmptyTokens If set, empty tokens (consecutive delimiters) are skipped.
+     *
+     * @returns A lazy view over the tokens, usable with range-for and @c std::views.
+     */
+    inline SplitView Split(std::string_view input, DelimiterSet delimiters, bool removeEmptyTokens) noexcept {
+        return SplitView { input, delimiters, removeEmptyTokens };
     }
 }
@@ -0,0 +1,899 @@
+#include "libtactmon/io/AsyncFileService.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <unordered_set>
+
+#include <boost/system/error_code.hpp>
+
+#if defined(_WIN32)
+# define WIN32_LEAN_AND_MEAN
+# define NOMINMAX
+# include <Windows.h>
+#else
+# include <cerrno>
+# include <fcntl.h>
+# include <sys/stat.h>
+# include <sys/uio.h>
+# include <unistd.h>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/io_uring.h>)
+# define LIBTACTMON_HAS_IO_URING 1
+# include <linux/io_uring.h>
+# include <sys/mman.h>
+# include <sys/syscall.h>
+#endif
+
+namespace libtactmon::io {
+    namespace detail {
+#if defined(_WIN32)
+        using NativeHandle = HANDLE;
+        static const NativeHandle InvalidHandle = INVALID_HANDLE_VALUE;
+#else
+        using NativeHandle = int;
+        static const NativeHandle InvalidHandle = -1;
+#endif
+
+        // Caps a single transfer; larger operations are split by the backends.
+        constexpr static const std::size_t MaxTransferSize = std::size_t { 1 } << 30;
+
+        // Caps the bytes a single Writer may have queued; writers wait for the disk past that point.
+        constexpr static const std::size_t MaxQueuedWriteSize = std::size_t { 16 } << 20;
+
+        static boost::system::error_code LastError() {
+#if defined(_WIN32)
+            return boost::system::error_code { static_cast<int>(::GetLastError()), boost::system::system_category() };
+#else
+            return boost::system::error_code { errno, boost::system::system_category() };
+#endif
+        }
+
+        static NativeHandle OpenForReading(std::filesystem::path const& filePath, uint64_t& fileSize, boost::system::error_code& ec) {
+#if defined(_WIN32)
+            NativeHandle handle = ::CreateFileW(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+            if (handle == InvalidHandle) {
+                ec = LastError();
+                return handle;
+            }
+
+            LARGE_INTEGER size;
+            if (!::GetFileSizeEx(handle, &size)) {
+                ec = LastError();
+                ::CloseHandle(handle);
+                return InvalidHandle;
+            }
+
+            fileSize = static_cast<uint64_t>(size.QuadPart);
+            return handle;
+#else
+            NativeHandle handle = ::open(filePath.c_str(), O_RDONLY | O_CLOEXEC);
+            if (handle == InvalidHandle) {
+                ec = LastError();
+                return handle;
+            }
+
+            struct stat status;
+            if (::fstat(handle, &status) != 0) {
+                ec = LastError();
+                ::close(handle);
+                return InvalidHandle;
+            }
+
+            fileSize = static_cast<uint64_t>(status.st_size);
+            return handle;
+#endif
+        }
+
+        static NativeHandle OpenForWriting(std::filesystem::path const& filePath, bool truncate, boost::system::error_code& ec) {
+            std::error_code directoryError;
+            if (filePath.has_parent_path())
+                std::filesystem::create_directories(filePath.parent_path(), directoryError);
+
+#if defined(_WIN32)
+            NativeHandle handle = ::CreateFileW(filePath.c_str(), GENERIC_WRITE, 0, nullptr, truncate ? CREATE_ALWAYS : OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+#else
+            NativeHandle handle = ::open(filePath.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC | (truncate ? O_TRUNC : 0), 0644);
+#endif
+            if (handle == InvalidHandle)
+                ec = LastError();
+
+            return handle;
+        }
+
+        static void Close(NativeHandle handle) {
+#if defined(_WIN32)
+            ::CloseHandle(handle);
+#else
+            ::close(handle);
+#endif
+        }
+
+        /**
+         * A positional read or write, possibly performed over several transfers.
+         */
+        struct FileOperation {
+            NativeHandle Handle = InvalidHandle;
+            uint64_t Offset = 0;
+            std::byte* Buffer = nullptr;
+            std::size_t Size = 0;
+            std::size_t Transferred = 0;
+            bool Write = false;
+
+            std::function<void(boost::system::error_code, std::size_t)> Completion;
+
+#if LIBTACTMON_HAS_IO_URING
+            iovec Vector { };
+#endif
+
+            void Complete(boost::system::error_code ec) {
+                Completion(ec, Transferred);
+            }
+        };
+
+        /**
+         * Performs an operation synchronously, on the calling thread.
+         */
+        static boost::system::error_code Transfer(FileOperation& operation) {
+            while (operation.Transferred < operation.Size) {
+                std::size_t length = std::min(operation.Size - operation.Transferred, MaxTransferSize);
+                uint64_t offset = operation.Offset + operation.Transferred;
+                std::byte* buffer = operation.Buffer + operation.Transferred;
+
+#if defined(_WIN32)
+                OVERLAPPED overlapped { };
+                overlapped.Offset = static_cast<DWORD>(offset);
+                overlapped.OffsetHigh = static_cast<DWORD>(offset >> 32);
+
+                DWORD transferred = 0;
+                BOOL success = operation.Write
+                    ? ::WriteFile(operation.Handle, buffer, static_cast<DWORD>(length), &transferred, &overlapped)
+                    : ::ReadFile(operation.Handle, buffer, static_cast<DWORD>(length), &transferred, &overlapped);
+                if (!success) {
+                    if (::GetLastError() == ERROR_HANDLE_EOF)
+                        break;
+
+                    return LastError();
+                }
+#else
+                ssize_t transferred = operation.Write
+                    ? ::pwrite(operation.Handle, buffer, length, static_cast<off_t>(offset))
+                    : ::pread(operation.Handle, buffer, length, static_cast<off_t>(offset));
+                if (transferred < 0) {
+                    if (errno == EINTR)
+                        continue;
+
+                    return LastError();
+                }
+#endif
+
+                if (transferred == 0)
+                    break;
+
+                operation.Transferred += static_cast<std::size_t>(transferred);
+            }
+
+            return { };
+        }
+
+        struct AsyncFileBackend {
+            virtual ~AsyncFileBackend() = default;
+
+            /**
+             * Queues an operation. Depending on the backend, it may not start until @ref Flush is called.
+             */
+            virtual void Enqueue(std::unique_ptr<FileOperation> operation) = 0;
+
+            /**
+             * Submits every queued operation.
+             */
+            virtual void Flush() = 0;
+
+            [[nodiscard]] virtual bool native() const = 0;
+        };
+
+        /**
+         * Executes operations on a thread pool, using blocking positional I/O.
+         */
+        struct ThreadPoolBackend final : AsyncFileBackend {
+            explicit ThreadPoolBackend(std::size_t threadCount) : _pool(std::max<std::size_t>(1, threadCount)) { }
+
+            ~ThreadPoolBackend() override {
+                _pool.join();
+            }
+
+            void Enqueue(std::unique_ptr<FileOperation> operation) override {
+                boost::asio::post(_pool, [operation = std::shared_ptr<FileOperation> { std::move(operation) }]() {
+                    operation->Complete(Transfer(*operation));
+                });
+            }
+
+            void Flush() override { }
+
+            [[nodiscard]] bool native() const override { return false; }
+
+        private:
+            boost::asio::thread_pool _pool;
+        };
+
+#if LIBTACTMON_HAS_IO_URING
+        /**
+         * Submits operations to an io_uring instance. Queued operations are submitted with a single system call on
+         * @ref Flush, and completions are reaped by a dedicated thread.
+         *
+         * If the ring fails, every operation it still owns is completed with an error and later operations are executed
+         * on a thread pool instead.
+         */
+        struct IoUringBackend final : AsyncFileBackend {
+            static std::unique_ptr<IoUringBackend> Create(uint32_t entries, std::size_t threadCount) {
+                io_uring_params params { };
+                int ringHandle = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+                if (ringHandle < 0)
+                    return nullptr;
+
+                std::unique_ptr<IoUringBackend> backend { new IoUringBackend(ringHandle, params, threadCount) };
+                if (!backend->Map())
+                    return nullptr;
+
+                backend->_reaper = std::thread { [backend = backend.get()]() { backend->Reap(); } };
+                return backend;
+            }
+
+            ~IoUringBackend() override {
+                if (_reaper.joinable()) {
+                    std::unique_lock<std::mutex> guard { _lock };
+                    _idle.wait(guard, [this]() { return Idle(); });
+
+                    _stopping = true;
+                    _work.notify_all();
+
+                    guard.unlock();
+                    _reaper.join();
+                }
+
+                _fallback.reset();
+
+                if (_submissionEntries != nullptr)
+                    ::munmap(_submissionEntries, _submissionEntryCount * sizeof(io_uring_sqe));
+                if (_completionRing != nullptr && _completionRing != _submissionRing)
+                    ::munmap(_completionRing, _completionRingSize);
+                if (_submissionRing != nullptr)
+                    ::munmap(_submissionRing, _submissionRingSize);
+
+                ::close(_ringHandle);
+
+                // The kernel may have owned these buffers until the ring was closed.
+                for (FileOperation* operation : _abandoned)
+                    delete operation;
+            }
+
+            void Enqueue(std::unique_ptr<FileOperation> operation) override {
+                std::lock_guard<std::mutex> guard { _lock };
+                if (_fallback != nullptr)
+                    _fallback->Enqueue(std::move(operation));
+                else
+                    _pending.push_back(operation.release());
+            }
+
+            void Flush() override {
+                {
+                    std::lock_guard<std::mutex> guard { _lock };
+                    SubmitPending();
+                }
+
+                CompleteFailures();
+            }
+
+            [[nodiscard]] bool native() const override { return !_failed.load(std::memory_order_relaxed); }
+
+        private:
+            IoUringBackend(int ringHandle, io_uring_params const& params, std::size_t threadCount)
+                : _ringHandle(ringHandle), _params(params), _threadCount(threadCount)
+            { }
+
+            bool Map() {
+                _submissionRingSize = _params.sq_off.array + _params.sq_entries * sizeof(uint32_t);
+                _completionRingSize = _params.cq_off.cqes + _params.cq_entries * sizeof(io_uring_cqe);
+
+                bool singleMapping = (_params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+                if (singleMapping)
+                    _submissionRingSize = _completionRingSize = std::max(_submissionRingSize, _completionRingSize);
+
+                void* submissionRing = ::mmap(nullptr, _submissionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringHandle, IORING_OFF_SQ_RING);
+                if (submissionRing == MAP_FAILED)
+                    return false;
+                _submissionRing = static_cast<std::byte*>(submissionRing);
+
+                if (singleMapping) {
+                    _completionRing = _submissionRing;
+                } else {
+                    void* completionRing = ::mmap(nullptr, _completionRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringHandle, IORING_OFF_CQ_RING);
+                    if (completionRing == MAP_FAILED)
+                        return false;
+                    _completionRing = static_cast<std::byte*>(completionRing);
+                }
+
+                _submissionEntryCount = _params.sq_entries;
+                void* submissionEntries = ::mmap(nullptr, _submissionEntryCount * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _ringHandle, IORING_OFF_SQES);
+                if (submissionEntries == MAP_FAILED)
+                    return false;
+                _submissionEntries = static_cast<io_uring_sqe*>(submissionEntries);
+
+                _submissionTail = reinterpret_cast<uint32_t*>(_submissionRing + _params.sq_off.tail);
+                _submissionMask = reinterpret_cast<uint32_t*>(_submissionRing + _params.sq_off.ring_mask);
+                _submissionArray = reinterpret_cast<uint32_t*>(_submissionRing + _params.sq_off.array);
+
+                _completionHead = reinterpret_cast<uint32_t*>(_completionRing + _params.cq_off.head);
+                _completionTail = reinterpret_cast<uint32_t*>(_completionRing + _params.cq_off.tail);
+                _completionMask = reinterpret_cast<uint32_t*>(_completionRing + _params.cq_off.ring_mask);
+                _completionEntries = reinterpret_cast<io_uring_cqe*>(_completionRing + _params.cq_off.cqes);
+                return true;
+            }
+
+            // The following functions must be called with _lock held.
+
+            io_uring_sqe& PrepareEntry() {
+                uint32_t index = *_submissionTail & *_submissionMask;
+
+                io_uring_sqe& sqe = _submissionEntries[index];
+                std::memset(&sqe, 0, sizeof(io_uring_sqe));
+                _submissionArray[index] = index;
+                return sqe;
+            }
+
+            void PublishEntry() {
+                __atomic_store_n(_submissionTail, *_submissionTail + 1, __ATOMIC_RELEASE);
+                ++_unsubmitted;
+            }
+
+            void Submit() {
+                while (_unsubmitted != 0) {
+                    int submitted = static_cast<int>(::syscall(__NR_io_uring_enter, _ringHandle, _unsubmitted, 0, 0, nullptr, 0));
+                    if (submitted < 0) {
+                        if (errno == EINTR)
+                            continue;
+
+                        // Entries stay in the ring and are submitted again once the reaper makes room, provided the
+                        // kernel owns something it can complete.
+                        if ((errno == EAGAIN || errno == EBUSY) && _accepted != 0)
+                            return;
+
+                        Fail(LastError());
+                        return;
+                    }
+
+                    _unsubmitted -= static_cast<uint32_t>(submitted);
+                    _accepted += static_cast<uint32_t>(submitted);
+                    _work.notify_one();
+
+                    if (submitted == 0)
+                        return;
+                }
+            }
+
+            void SubmitPending() {
+                if (_fallback != nullptr) {
+                    Fail(boost::system::errc::make_error_code(boost::system::errc::io_error));
+                    return;
+                }
+
+                // The completion queue is twice as large as the submission queue, so it cannot overflow as long as no
+                // more operations than there are submission entries are in flight.
+                while (!_pending.empty() && _inFlight.size() < _submissionEntryCount) {
+                    FileOperation* operation = _pending.front();
+                    _pending.pop_front();
+
+                    operation->Vector.iov_base = operation->Buffer + operation->Transferred;
+                    operation->Vector.iov_len = std::min(operation->Size - operation->Transferred, MaxTransferSize);
+
+                    io_uring_sqe& sqe = PrepareEntry();
+                    sqe.opcode = operation->Write ? IORING_OP_WRITEV : IORING_OP_READV;
+                    sqe.fd = operation->Handle;
+                    sqe.off = operation->Offset + operation->Transferred;
+                    sqe.addr = reinterpret_cast<uint64_t>(&operation->Vector);
+                    sqe.len = 1;
+                    sqe.user_data = reinterpret_cast<uint64_t>(operation);
+                    PublishEntry();
+
+                    _inFlight.insert(operation);
+                }
+
+                Submit();
+            }
+
+            /**
+             * Stops using the ring. Queued operations and operations the kernel never accepted are failed with @p ec;
+             * the latter are withdrawn from the submission queue. Operations the kernel accepted are still reaped.
+             */
+            void Fail(boost::system::error_code ec) {
+                // Without SQPOLL, the kernel only consumes entries within io_uring_enter; the tail can be rewound.
+                uint32_t tail = *_submissionTail;
+                for (uint32_t i = tail - _unsubmitted; i != tail; ++i) {
+                    auto operation = reinterpret_cast<FileOperation*>(_submissionEntries[_submissionArray[i & *_submissionMask]].user_data);
+                    _inFlight.erase(operation);
+                    _failures.emplace_back(operation, ec);
+                }
+                __atomic_store_n(_submissionTail, tail - _unsubmitted, __ATOMIC_RELEASE);
+                _unsubmitted = 0;
+
+                for (FileOperation* operation : _pending)
+                    _failures.emplace_back(operation, ec);
+                _pending.clear();
+
+                if (_fallback == nullptr)
+                    _fallback = std::make_unique<ThreadPoolBackend>(_threadCount);
+                _failed.store(true, std::memory_order_relaxed);
+            }
+
+            bool Idle() const {
+                return _pending.empty() && _inFlight.empty() && _failures.empty() && _completing == 0;
+            }
+
+            // ^^^ _lock held / _lock not held vvv
+
+            void CompleteFailures() {
+                std::vector<std::pair<FileOperation*, boost::system::error_code>> failures;
+                {
+                    std::lock_guard<std::mutex> guard { _lock };
+                    if (_failures.empty())
+                        return;
+
+                    failures.swap(_failures);
+                    _completing += failures.size();
+                }
+
+                for (auto [operation, ec] : failures) {
+                    operation->Complete(ec);
+                    delete operation;
+                }
+
+                std::lock_guard<std::mutex> guard { _lock };
+                _completing -= failures.size();
+                if (Idle())
+                    _idle.notify_all();
+            }
+
+            void Reap() {
+                std::vector<std::pair<FileOperation*, int32_t>> completions;
+
+                for (;;) {
+                    {
+                        std::unique_lock<std::mutex> guard { _lock };
+                        _work.wait(guard, [this]() { return _accepted != 0 || _stopping; });
+                        if (_accepted == 0)
+                            return;
+                    }
+
+                    int result = static_cast<int>(::syscall(__NR_io_uring_enter, _ringHandle, 0, 1, IORING_ENTER_GETEVENTS, nullptr, 0));
+                    if (result < 0 && errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+                        Abandon(LastError());
+                        return;
+                    }
+
+                    completions.clear();
+
+                    uint32_t head = *_completionHead;
+                    uint32_t tail = __atomic_load_n(_completionTail, __ATOMIC_ACQUIRE);
+                    for (; head != tail; ++head) {
+                        io_uring_cqe const& cqe = _completionEntries[head & *_completionMask];
+                        completions.emplace_back(reinterpret_cast<FileOperation*>(cqe.user_data), cqe.res);
+                    }
+                    __atomic_store_n(_completionHead, head, __ATOMIC_RELEASE);
+
+                    {
+                        std::lock_guard<std::mutex> guard { _lock };
+                        _accepted -= static_cast<uint32_t>(completions.size());
+                        _completing += completions.size();
+                        for (auto [operation, transferred] : completions)
+                            _inFlight.erase(operation);
+                    }
+
+                    std::vector<FileOperation*> resubmissions;
+                    for (auto [operation, transferred] : completions) {
+                        if (transferred == -EINTR || transferred == -EAGAIN) {
+                            resubmissions.push_back(operation);
+                        } else if (transferred < 0) {
+                            operation->Complete(boost::system::error_code { -transferred, boost::system::system_category() });
+                            delete operation;
+                        } else {
+                            operation->Transferred += static_cast<std::size_t>(transferred);
+
+                            // Short transfers are resubmitted for the remainder, unless the end of the file was reached.
+                            if (transferred == 0 || operation->Transferred == operation->Size) {
+                                operation->Complete({ });
+                                delete operation;
+                            } else {
+                                resubmissions.push_back(operation);
+                            }
+                        }
+                    }
+
+                    {
+                        std::lock_guard<std::mutex> guard { _lock };
+                        _completing -= completions.size();
+
+                        _pending.insert(_pending.begin(), resubmissions.begin(), resubmissions.end());
+                        SubmitPending();
+
+                        if (Idle())
+                            _idle.notify_all();
+                    }
+
+                    CompleteFailures();
+                }
+            }
+
+            /**
+             * Called when completions can no longer be reaped: every operation is failed with @p ec. Operations the
+             * kernel accepted are kept alive until the ring is closed, since their buffers may still be in use.
+             */
+            void Abandon(boost::system::error_code ec) {
+                std::vector<FileOperation*> abandoned;
+                {
+                    std::lock_guard<std::mutex> guard { _lock };
+                    Fail(ec);
+
+                    abandoned.assign(_inFlight.begin(), _inFlight.end());
+                    _inFlight.clear();
+                    _accepted = 0;
+                    _completing += abandoned.size();
+                }
+
+                for (FileOperation* operation : abandoned)
+                    operation->Complete(ec);
+
+                {
+                    std::lock_guard<std::mutex> guard { _lock };
+                    _abandoned.insert(_abandoned.end(), abandoned.begin(), abandoned.end());
+                    _completing -= abandoned.size();
+                    if (Idle())
+                        _idle.notify_all();
+                }
+
+                CompleteFailures();
+            }
+
+            int _ringHandle;
+            io_uring_params _params;
+            std::size_t _threadCount;
+
+            std::size_t _submissionRingSize = 0;
+            std::size_t _completionRingSize = 0;
+            std::byte* _submissionRing = nullptr;
+            std::byte* _completionRing = nullptr;
+
+            io_uring_sqe* _submissionEntries = nullptr;
+            uint32_t _submissionEntryCount = 0;
+            uint32_t* _submissionTail = nullptr;
+            uint32_t* _submissionMask = nullptr;
+            uint32_t* _submissionArray = nullptr;
+
+            io_uring_cqe* _completionEntries = nullptr;
+            uint32_t* _completionHead = nullptr;
+            uint32_t* _completionTail = nullptr;
+            uint32_t* _completionMask = nullptr;
+
+            std::mutex _lock;
+            std::condition_variable _idle;
+            std::condition_variable _work;
+            std::deque<FileOperation*> _pending;
+            std::unordered_set<FileOperation*> _inFlight;
+            std::vector<std::pair<FileOperation*, boost::system::error_code>> _failures;
+            std::vector<FileOperation*> _abandoned;
+            uint32_t _unsubmitted = 0;
+            uint32_t _accepted = 0; // Entries consumed by the kernel whose completion was not reaped yet.
+            std::size_t _completing = 0; // Operations taken off the queues whose completion handler is running.
+            bool _stopping = false;
+
+            std::atomic<bool> _failed = false;
+            std::unique_ptr<ThreadPoolBackend> _fallback;
+
+            std::thread _reaper;
+        };
+#endif
+    }
+
+    AsyncFileService::AsyncFileService(std::optional<boost::asio::any_io_executor> executor, std::size_t threadCount) {
+#if LIBTACTMON_HAS_IO_URING
+        _backend = detail::IoUringBackend::Create(256, threadCount);
+#endif
+        if (_backend == nullptr)
+            _backend = std::make_unique<detail::ThreadPoolBackend>(threadCount);
+
+        if (executor.has_value()) {
+            _executor = std::move(*executor);
+        } else {
+            _pool = std::make_unique<boost::asio::thread_pool>(1);
+            _executor = _pool->get_executor();
+        }
+    }
+
+    AsyncFileService::~AsyncFileService() {
+        // Drain outstanding operations before tearing down the executor their completions may be posted to.
+        _backend.reset();
+
+        if (_pool != nullptr)
+            _pool->join();
+    }
+
+    bool AsyncFileService::UsesIoUring() const {
+        return _backend->native();
+    }
+
+    void AsyncFileService::SubmitRead(std::filesystem::path const& filePath, ReadCompletion completion) {
+        boost::system::error_code ec;
+        uint64_t fileSize = 0;
+        detail::NativeHandle handle = detail::OpenForReading(filePath, fileSize, ec);
+        if (ec.failed()) {
+            completion(ec, { });
+            return;
+        }
+
+        auto buffer = std::make_shared<std::vector<std::byte>>(fileSize);
+        if (buffer->empty()) {
+            detail::Close(handle);
+            completion(ec, { });
+            return;
+        }
+
+        auto operation = std::make_unique<detail::FileOperation>();
+        operation->Handle = handle;
+        operation->Buffer = buffer->data();
+        operation->Size = buffer->size();
+        operation->Completion = [handle, buffer, completion = std::move(completion)](boost::system::error_code ec, std::size_t transferred) {
+            detail::Close(handle);
+
+            // On failure, the buffer stays with the operation; an abandoned io_uring operation may still be filling it.
+            if (ec.failed()) {
+                completion(ec, { });
+                return;
+            }
+
+            buffer->resize(transferred);
+            completion(ec, std::move(*buffer));
+        };
+
+        _backend->Enqueue(std::move(operation));
+    }
+
+    void AsyncFileService::SubmitWrite(std::filesystem::path const& filePath, std::vector<std::byte> data, WriteCompletion completion) {
+        boost::system::error_code ec;
+        detail::NativeHandle handle = detail::OpenForWriting(filePath, true, ec);
+        if (ec.failed()) {
+            completion(ec);
+            return;
+        }
+
+        if (data.empty()) {
+            detail::Close(handle);
+            completion(ec);
+            return;
+        }
+
+        auto buffer = std::make_shared<std::vector<std::byte>>(std::move(data));
+
+        auto operation = std::make_unique<detail::FileOperation>();
+        operation->Handle = handle;
+        operation->Buffer = buffer->data();
+        operation->Size = buffer->size();
+        operation->Write = true;
+        operation->Completion = [handle, buffer, completion = std::move(completion)](boost::system::error_code ec, std::size_t transferred) {
+            detail::Close(handle);
+
+            if (!ec.failed() && transferred != buffer->size())
+                ec = boost::system::errc::make_error_code(boost::system::errc::io_error);
+
+            completion(ec);
+        };
+
+        _backend->Enqueue(std::move(operation));
+    }
+
+    void AsyncFileService::Flush() {
+        _backend->Flush();
+    }
+
+    boost::future<AsyncFileService::ReadResult> AsyncFileService::ReadFile(std::filesystem::path const& filePath) {
+        return std::move(ReadFiles(std::span { &filePath, 1 }).front());
+    }
+
+    std::vector<boost::future<AsyncFileService::ReadResult>> AsyncFileService::ReadFiles(std::span<const std::filesystem::path> filePaths) {
+        std::vector<boost::future<ReadResult>> futures;
+        futures.reserve(filePaths.size());
+
+        for (std::filesystem::path const& filePath : filePaths) {
+            auto promise = std::make_shared<boost::promise<ReadResult>>();
+            futures.push_back(promise->get_future());
+
+            SubmitRead(filePath, [promise](boost::system::error_code ec, std::vector<std::byte> data) {
+                if (ec.failed())
+                    promise->set_value(std::nullopt);
+                else
+                    promise->set_value(std::move(data));
+            });
+        }
+
+        Flush();
+        return futures;
+    }
+
+    boost::future<bool> AsyncFileService::WriteFile(std::filesystem::path const& filePath, std::vector<std::byte> data) {
+        auto promise = std::make_shared<boost::promise<bool>>();
+        boost::future<bool> future = promise->get_future();
+
+        SubmitWrite(filePath, std::move(data), [promise](boost::system::error_code ec) {
+            promise->set_value(!ec.failed());
+        });
+
+        Flush();
+        return future;
+    }
+
+    // ^^^ AsyncFileService / AsyncFileService::Writer vvv
+
+    struct AsyncFileService::Writer::State {
+        detail::NativeHandle Handle = detail::InvalidHandle;
+
+        std::mutex Lock;
+        std::condition_variable Condition;
+        std::size_t Pending = 0;
+        std::size_t QueuedBytes = 0;
+        bool Failed = false;
+    };
+
+    AsyncFileService::Writer::~Writer() {
+        Close();
+    }
+
+    AsyncFileService::Writer::Writer(Writer&& other) noexcept
+        : _service(other._service), _state(std::move(other._state)), _offset(other._offset)
+    {
+        other._service = nullptr;
+        other._offset = 0;
+    }
+
+    AsyncFileService::Writer& AsyncFileService::Writer::operator = (Writer&& other) noexcept {
+        Close();
+
+        _service = other._service;
+        _state = std::move(other._state);
+        _offset = other._offset;
+
+        other._service = nullptr;
+        other._offset = 0;
+        return *this;
+    }
+
+    bool AsyncFileService::Writer::Open(AsyncFileService& service, std::filesystem::path const& filePath, std::optional<uint64_t> resumeAt) {
+        Close();
+
+        boost::system::error_code ec;
+        detail::NativeHandle handle = detail::OpenForWriting(filePath, !resumeAt.has_value(), ec);
+        if (ec.failed())
+            return false;
+
+        _service = &service;
+        _state = std::make_shared<State>();
+        _state->Handle = handle;
+        _offset = 0;
+
+        if (resumeAt.has_value()) {
+            // Drop whatever lies past the resume point; it may be incomplete.
+#if defined(_WIN32)
+            FILE_END_OF_FILE_INFO info;
+            info.EndOfFile.QuadPart = static_cast<LONGLONG>(*resumeAt);
+            bool truncated = ::SetFileInformationByHandle(handle, FileEndOfFileInfo, &info, sizeof(info)) != FALSE;
+#else
+            bool truncated = ::ftruncate(handle, static_cast<off_t>(*resumeAt)) == 0;
+#endif
+            if (!truncated) {
+                Close();
+                return false;
+            }
+
+            _offset = *resumeAt;
+        }
+
+        return true;
+    }
+
+    bool AsyncFileService::Writer::is_open() const {
+        return _state != nullptr;
+    }
+
+    bool AsyncFileService::Writer::Write(std::span<const std::byte> data) {
+        if (!WriteAt(_offset, data))
+            return false;
+
+        _offset += data.size();
+        return true;
+    }
+
+    bool AsyncFileService::Writer::WriteAt(uint64_t offset, std::span<const std::byte> data) {
+        if (_state == nullptr)
+            return false;
+
+        {
+            // Waits for earlier writes to drain if too much is queued already, but always lets one write through.
+            std::unique_lock<std::mutex> guard { _state->Lock };
+            _state->Condition.wait(guard, [state = _state.get(), size = data.size()]() {
+                return state->Failed || state->Pending == 0 || state->QueuedBytes + size <= detail::MaxQueuedWriteSize;
+            });
+
+            if (_state->Failed)
+                return false;
+
+            ++_state->Pending;
+            _state->QueuedBytes += data.size();
+        }
+
+        auto buffer = std::make_shared<std::vector<std::byte>>(data.begin(), data.end());
+
+        auto operation = std::make_unique<detail::FileOperation>();
+        operation->Handle = _state->Handle;
+        operation->Offset = offset;
+        operation->Buffer = buffer->data();
+        operation->Size = buffer->size();
+        operation->Write = true;
+        operation->Completion = [state = _state, buffer](boost::system::error_code ec, std::size_t transferred) {
+            std::lock_guard<std::mutex> guard { state->Lock };
+            if (ec.failed() || transferred != buffer->size())
+                state->Failed = true;
+
+            --state->Pending;
+            state->QueuedBytes -= buffer->size();
+            state->Condition.notify_all();
+        };
+
+        _service->_backend->Enqueue(std::move(operation));
+        _service->_backend->Flush();
+        return true;
+    }
+
+    bool AsyncFileService::Writer::Preallocate(uint64_t size) {
+        if (_state == nullptr)
+            return false;
+
+#if defined(_WIN32)
+        FILE_END_OF_FILE_INFO info;
+        info.EndOfFile.QuadPart = static_cast<LONGLONG>(size);
+        return ::SetFileInformationByHandle(_state->Handle, FileEndOfFileInfo, &info, sizeof(info)) != FALSE;
+#else
+# if defined(__linux__)
+        // Reserves the blocks up front; not every filesystem supports it, in which case the file is only extended.
+        if (::posix_fallocate(_state->Handle, 0, static_cast<off_t>(size)) == 0)
+            return true;
+# endif
+
+        struct stat status;
+        if (::fstat(_state->Handle, &status) != 0)
+            return false;
+
+        if (static_cast<uint64_t>(status.st_size) >= size)
+            return true;
+
+        return ::ftruncate(_state->Handle, static_cast<off_t>(size)) == 0;
+#endif
+    }
+
+    bool AsyncFileService::Writer::Close() {
+        if (_state == nullptr)
+            return false;
+
+        std::unique_lock<std::mutex> guard { _state->Lock };
+        _state->Condition.wait(guard, [state = _state.get()]() { return state->Pending == 0; });
+
+        detail::Close(_state->Handle);
+        bool success = !_state->Failed;
+
+        guard.unlock();
+        _state.reset();
+        _service = nullptr;
+        return success;
+    }
+}
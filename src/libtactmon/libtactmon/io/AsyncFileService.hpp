@@ -0,0 +1,215 @@
+#pragma once
+
+#include "libtactmon/detail/Export.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/associated_executor.hpp>
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/thread_pool.hpp>
+#include <boost/system/error_code.hpp>
+#include <boost/thread/future.hpp>
+
+namespace libtactmon::io {
+    namespace detail {
+        struct AsyncFileBackend;
+    }
+
+    /**
+     * Performs file I/O asynchronously.
+     *
+     * On Linux, operations are queued and submitted in batches to an io_uring instance. Elsewhere, or if io_uring is not
+     * available (old kernels, seccomp filters, ...), operations are executed on a dedicated thread pool instead.
+     *
+     * Two flavors of every operation are provided: one returning a @c boost::future, which completes on the I/O thread and
+     * can safely be waited on from any executor; and one taking an ASIO completion token, whose handler is dispatched on
+     * its associated executor (or on the executor given at construction).
+     */
+    struct LIBTACTMON_API AsyncFileService final {
+        using ReadResult = std::optional<std::vector<std::byte>>;
+
+        /**
+         * Creates a new file service.
+         *
+         * @param[in] executor    The executor on which completion handlers are invoked by default. If not provided,
+         *                        handlers are invoked on an internal thread.
+         * @param[in] threadCount The amount of threads used if io_uring is not available.
+         */
+        explicit AsyncFileService(std::optional<boost::asio::any_io_executor> executor = std::nullopt, std::size_t threadCount = 4);
+        ~AsyncFileService();
+
+        AsyncFileService(AsyncFileService const&) = delete;
+        AsyncFileService& operator = (AsyncFileService const&) = delete;
+
+        /**
+         * Returns true if operations are backed by io_uring.
+         */
+        [[nodiscard]] bool UsesIoUring() const;
+
+        /**
+         * Returns the executor on which completion handlers are invoked by default.
+         */
+        [[nodiscard]] boost::asio::any_io_executor const& executor() const { return _executor; }
+
+        /**
+         * Reads an entire file.
+         *
+         * @param[in] filePath The path to the file.
+         * @returns A future holding the contents of the file, or an empty optional if it could not be read.
+         */
+        boost::future<ReadResult> ReadFile(std::filesystem::path const& filePath);
+
+        /**
+         * Reads several files, submitting all the reads at once.
+         *
+         * @param[in] filePaths The paths to the files.
+         * @returns One future per file, in the same order as @p filePaths.
+         */
+        std::vector<boost::future<ReadResult>> ReadFiles(std::span<const std::filesystem::path> filePaths);
+
+        /**
+         * Writes an entire file, replacing it if it already exists. Parent directories are created if needed.
+         *
+         * @param[in] filePath The path to the file.
+         * @param[in] data     The contents of the file.
+         * @returns A future holding true if the file was written successfully.
+         */
+        boost::future<bool> WriteFile(std::filesystem::path const& filePath, std::vector<std::byte> data);
+
+        /**
+         * Reads an entire file.
+         *
+         * @param[in] filePath The path to the file.
+         * @param[in] token    An ASIO completion token for the signature <tt>void(boost::system::error_code, std::vector<std::byte>)</tt>.
+         */
+        template <typename CompletionToken>
+        auto AsyncReadFile(std::filesystem::path filePath, CompletionToken&& token) {
+            return boost::asio::async_initiate<CompletionToken, void(boost::system::error_code, std::vector<std::byte>)>(
+                [this](auto handler, std::filesystem::path filePath) {
+                    SubmitRead(filePath, BindHandler<boost::system::error_code, std::vector<std::byte>>(std::move(handler)));
+                    Flush();
+                }, token, std::move(filePath));
+        }
+
+        /**
+         * Writes an entire file, replacing it if it already exists. Parent directories are created if needed.
+         *
+         * @param[in] filePath The path to the file.
+         * @param[in] data     The contents of the file.
+         * @param[in] token    An ASIO completion token for the signature <tt>void(boost::system::error_code)</tt>.
+         */
+        template <typename CompletionToken>
+        auto AsyncWriteFile(std::filesystem::path filePath, std::vector<std::byte> data, CompletionToken&& token) {
+            return boost::asio::async_initiate<CompletionToken, void(boost::system::error_code)>(
+                [this](auto handler, std::filesystem::path filePath, std::vector<std::byte> data) {
+                    SubmitWrite(filePath, std::move(data), BindHandler<boost::system::error_code>(std::move(handler)));
+                    Flush();
+                }, token, std::move(filePath), std::move(data));
+        }
+
+        /**
+         * A file opened for sequential writing, where writes are queued and performed in the background. Buffers are
+         * copied, so callers can reuse them as soon as @ref Write returns. Once too many bytes are queued, writes block
+         * until the disk catches up.
+         */
+        struct LIBTACTMON_API Writer final {
+            Writer() = default;
+            ~Writer();
+
+            Writer(Writer&& other) noexcept;
+            Writer& operator = (Writer&& other) noexcept;
+
+            /**
+             * Opens a file for writing. Parent directories are created if needed.
+             *
+             * @param[in] service  The service performing the writes.
+             * @param[in] filePath The path to the file.
+             * @param[in] resumeAt If set, the existing contents of the file up to this offset are kept and sequential
+             *                     writes start there; otherwise, the file is truncated.
+             */
+            bool Open(AsyncFileService& service, std::filesystem::path const& filePath, std::optional<uint64_t> resumeAt = std::nullopt);
+
+            /**
+             * Queues bytes to be written after everything previously written.
+             *
+             * @returns false if a previous write failed.
+             */
+            bool Write(std::span<const std::byte> data);
+
+            /**
+             * Queues bytes to be written at a given offset. Writes to disjoint ranges may complete in any order.
+             *
+             * @returns false if a previous write failed.
+             */
+            bool WriteAt(uint64_t offset, std::span<const std::byte> data);
+
+            /**
+             * Reserves disk space for the file and sets its size. Data already written is preserved.
+             *
+             * @returns false if the space could not be reserved.
+             */
+            bool Preallocate(uint64_t size);
+
+            /**
+             * Waits for all queued writes to complete and closes the file.
+             *
+             * @returns true if every write succeeded.
+             */
+            bool Close();
+
+            [[nodiscard]] bool is_open() const;
+            [[nodiscard]] uint64_t size() const { return _offset; }
+
+        private:
+            struct State;
+
+            AsyncFileService* _service = nullptr;
+            std::shared_ptr<State> _state;
+            uint64_t _offset = 0;
+        };
+
+    private:
+        using ReadCompletion = std::function<void(boost::system::error_code, std::vector<std::byte>)>;
+        using WriteCompletion = std::function<void(boost::system::error_code)>;
+
+        /**
+         * Wraps an ASIO completion handler so that it is invoked on its associated executor.
+         */
+        template <typename... Args, typename Handler>
+        auto BindHandler(Handler handler) {
+            auto executor = boost::asio::get_associated_executor(handler, _executor);
+            auto state = std::make_shared<std::pair<Handler, boost::asio::executor_work_guard<decltype(executor)>>>(
+                std::move(handler), boost::asio::make_work_guard(executor));
+
+            return [state, executor](Args... args) {
+                boost::asio::post(executor, [state, ...args = std::move(args)]() mutable {
+                    std::move(state->first)(std::move(args)...);
+                    state->second.reset();
+                });
+            };
+        }
+
+        void SubmitRead(std::filesystem::path const& filePath, ReadCompletion completion);
+        void SubmitWrite(std::filesystem::path const& filePath, std::vector<std::byte> data, WriteCompletion completion);
+
+        /**
+         * Submits all queued operations.
+         */
+        void Flush();
+
+        std::unique_ptr<boost::asio::thread_pool> _pool;
+        boost::asio::any_io_executor _executor;
+        std::unique_ptr<detail::AsyncFileBackend> _backend;
+    };
+}
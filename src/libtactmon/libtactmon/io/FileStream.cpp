@@ -1,12 +1,55 @@
 #include "libtactmon/io/FileStream.hpp"
 
+#include <algorithm>
+#include <cstring>
+
+#if defined(_WIN32)
+# define WIN32_LEAN_AND_MEAN
+# define NOMINMAX
+# include <Windows.h>
+#else
+# include <sys/mman.h>
+# include <unistd.h>
+#endif
+
 namespace libtactmon::io {
-    FileStream::FileStream(const std::filesystem::path& filePath) : IReadableStream()
+    // Huge pages are 2 MiB on most platforms; advising smaller mappings is pointless.
+    constexpr static const std::size_t HugePageSize = 2 * 1024 * 1024;
+
+    static std::size_t GetPageSize() {
+#if defined(_WIN32)
+        static const std::size_t pageSize = []() {
+            SYSTEM_INFO systemInfo;
+            ::GetSystemInfo(&systemInfo);
+            return static_cast<std::size_t>(systemInfo.dwPageSize);
+        }();
+#else
+        static const std::size_t pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+#endif
+        return pageSize;
+    }
+
+    FileStream::FileStream(const std::filesystem::path& filePath, FileMappingOptions options) : IReadableStream()
     {
         try {
             _stream.open(filePath.string());
         } catch (...) {
             // Failed to open the file, probably does not exist, is empty, or invalid
+            return;
+        }
+
+#if defined(MADV_HUGEPAGE)
+        if (options.HugePages && _stream.size() >= HugePageSize)
+            ::madvise(const_cast<char*>(_stream.data()), _stream.size(), MADV_HUGEPAGE);
+#endif
+
+        if (options.Populate) {
+#if defined(MADV_POPULATE_READ)
+            // Synchronous, like MAP_POPULATE; only available since Linux 5.14.
+            if (::madvise(const_cast<char*>(_stream.data()), _stream.size(), MADV_POPULATE_READ) == 0)
+                return;
+#endif
+            Prefetch(0, _stream.size());
         }
     }
 
@@ -22,6 +65,40 @@ namespace libtactmon::io {
         return _stream.size();
     }
 
+    void FileStream::Advise(AccessPattern pattern) const {
+#if !defined(_WIN32)
+        if (!_stream.is_open())
+            return;
+
+        int advice = MADV_NORMAL;
+        switch (pattern) {
+            case AccessPattern::Sequential: advice = MADV_SEQUENTIAL; break;
+            case AccessPattern::Random:     advice = MADV_RANDOM; break;
+            default: break;
+        }
+
+        ::madvise(const_cast<char*>(_stream.data()), _stream.size(), advice);
+#endif
+    }
+
+    void FileStream::Prefetch(std::size_t offset, std::size_t length) const {
+        if (!_stream.is_open() || offset >= _stream.size())
+            return;
+
+        // The mapping itself is page-aligned, but the range may not be.
+        std::size_t begin = offset - offset % GetPageSize();
+        std::size_t end = offset + std::min(length, _stream.size() - offset);
+
+#if defined(_WIN32)
+# if _WIN32_WINNT >= 0x0602 // Windows 8
+        WIN32_MEMORY_RANGE_ENTRY range { const_cast<char*>(_stream.data() + begin), end - begin };
+        ::PrefetchVirtualMemory(::GetCurrentProcess(), 1, &range, 0);
+# endif
+#else
+        ::madvise(const_cast<char*>(_stream.data() + begin), end - begin, MADV_WILLNEED);
+#endif
+    }
+
     std::size_t FileStream::_ReadImpl(std::span<std::byte> bytes) {
         std::size_t length = std::min(bytes.size(), _stream.size() - _cursor);
 
@@ -7,8 +7,19 @@
 #include <boost/iostreams/device/mapped_file.hpp>
 
 namespace libtactmon::io {
+    /**
+     * Options controlling how a file is mapped in memory.
+     */
+    struct FileMappingOptions {
+        //! Loads the entire file before the constructor returns, instead of faulting pages in as they are accessed.
+        bool Populate = false;
+
+        //! Asks the kernel to back the mapping with huge pages if possible. Only has an effect on large files.
+        bool HugePages = false;
+    };
+
     struct FileStream final : IReadableStream {
-        explicit FileStream(const std::filesystem::path& filePath);
+        explicit FileStream(const std::filesystem::path& filePath, FileMappingOptions options = { });
 
     public: // IStream
         [[nodiscard]] std::size_t GetLength() const override;
@@ -22,6 +33,9 @@ namespace libtactmon::io {
 
         [[nodiscard]] std::span<std::byte const> Data() const override { return std::span { reinterpret_cast<std::byte const*>(_stream.data() + _cursor), _stream.size() - _cursor }; }
 
+        void Advise(AccessPattern pattern) const override;
+        void Prefetch(std::size_t offset, std::size_t length) const override;
+
     protected: // IReadableStream
         std::size_t _ReadImpl(std::span<std::byte> bytes) override;
 
@@ -8,10 +8,20 @@
 #include <iterator>
 #include <memory>
 #include <span>
+#include <string>
 #include <type_traits>
 #include <vector>
 
 namespace libtactmon::io {
+    /**
+     * Describes how the data of a stream is going to be read.
+     */
+    enum class AccessPattern {
+        Normal,
+        Sequential, //< Data is read in order, usually once.
+        Random      //< Data is read at arbitrary offsets; reading ahead is wasteful.
+    };
+
     /**
      * Provides read operations on a sequence of bytes.
      */
@@ -49,6 +59,19 @@ namespace libtactmon::io {
          */
         [[nodiscard]] virtual std::span<std::byte const> Data() const = 0;
 
+        /**
+         * Tells the stream how its data is going to be read. This is only a hint: streams that are not backed by a file
+         * ignore it.
+         */
+        virtual void Advise(AccessPattern) const { }
+
+        /**
+         * Tells the stream that a range of its data, given by its absolute offset and its length, is going to be read
+         * soon, so that it can be loaded in the background. This is only a hint: streams that are not backed by a file
+         * ignore it.
+         */
+        virtual void Prefetch(std::size_t, std::size_t) const { }
+
         template <typename T> requires (!std::same_as<T, std::byte> && std::is_trivial_v<T>)
         [[nodiscard]] std::span<const T> Data() const {
             return std::span { reinterpret_cast<const T*>(Data().data()), Data().size() / sizeof(T) };
@@ -3,6 +3,10 @@
 #include "libtactmon/io/IStream.hpp"
 #include "libtactmon/utility/Traits.hpp"
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
 namespace libtactmon::io {
     /**
      * Provides write operations on a sequence of bytes.
@@ -40,7 +44,7 @@ namespace libtactmon::io {
         template <typename T> requires (utility::is_span_v<T> || std::is_trivial_v<T>)
         std::size_t Write(T const value, std::endian endianness = std::endian::native) {
             if constexpr (utility::is_span_v<T>) {
-                return _WriteSpan(std::as_bytes(value), endianness, sizeof(T));
+                return _WriteSpan(std::as_bytes(value), endianness, sizeof(typename T::element_type));
             } else {
                 std::span<const T> valueSpan { std::addressof(value), 1 };
                 return _WriteSpan(valueSpan, endianness, sizeof(T));
@@ -59,27 +63,42 @@ namespace libtactmon::io {
         }
 
     protected:
-        virtual std::span<std::byte> _WriteImpl(std::span<const std::byte> value) = 0;
+        /**
+         * Writes bytes at the write cursor and advances it.
+         *
+         * @returns The amount of bytes written.
+         */
+        virtual std::size_t _WriteImpl(std::span<const std::byte> value) = 0;
 
     private:
         template <typename T>
         std::size_t _WriteSpan(std::span<const T> valueSpan, std::endian endianness, std::size_t elementSize) {
-            std::span<std::byte> writtenBytes = _WriteImpl(std::as_bytes(valueSpan));
+            std::span<const std::byte> bytes = std::as_bytes(valueSpan);
+            if (endianness == std::endian::native || elementSize <= 1)
+                return _WriteImpl(bytes);
 
-            if (endianness != std::endian::native) {
-                auto begin = writtenBytes.begin();
-                auto end = writtenBytes.end();
+            // Swap a block of elements at a time in a scratch buffer rather than in the destination, which may not be
+            // contiguous.
+            std::array<std::byte, 256> scratch;
+            std::size_t blockSize = scratch.size() - scratch.size() % elementSize;
+            if (blockSize == 0)
+                return 0;
 
-                while (begin != end) {
-                    auto tail = begin;
-                    std::advance(tail, elementSize);
+            std::size_t bytesWritten = 0;
+            while (bytesWritten < bytes.size()) {
+                std::size_t length = std::min(blockSize, bytes.size() - bytesWritten);
+                std::memcpy(scratch.data(), bytes.data() + bytesWritten, length);
 
-                    std::ranges::reverse(begin, tail);
-                    begin = tail;
-                }
+                for (std::size_t i = 0; i + elementSize <= length; i += elementSize)
+                    std::reverse(scratch.begin() + i, scratch.begin() + i + elementSize);
+
+                std::size_t blockWritten = _WriteImpl(std::span { scratch.data(), length });
+                bytesWritten += blockWritten;
+                if (blockWritten != length)
+                    break;
             }
 
-            return writtenBytes.size();
+            return bytesWritten;
         }
     };
 }
@@ -6,7 +6,7 @@ namespace libtactmon::io {
     std::size_t SpanStream::_ReadImpl(std::span<std::byte> bytes) {
         std::size_t length = std::min(bytes.size(), _data.size() - _cursor);
 
-        std::copy_n(Data().subspan(length).data(), length, bytes.data());
+        std::copy_n(Data().data(), length, bytes.data());
         _cursor += length;
         return length;
     }
@@ -24,7 +24,7 @@ namespace libtactmon::io {
     std::size_t MemoryStream::_ReadImpl(std::span<std::byte> bytes) {
         std::size_t length = std::min(bytes.size(), _data.size() - _cursor);
 
-        bytes = std::span { reinterpret_cast<std::byte*>(_data.data()) + _cursor, length };
+        std::copy_n(Data().data(), length, bytes.data());
         _cursor += length;
         return length;
     }
@@ -55,14 +55,12 @@ namespace libtactmon::io {
         return length;
     }
 
-    std::span<std::byte> GrowableMemoryStream::_WriteImpl(std::span<const std::byte> bytes) {
+    std::size_t GrowableMemoryStream::_WriteImpl(std::span<const std::byte> bytes) {
         if (_data.size() < _writeCursor + bytes.size())
             _data.resize(_writeCursor + bytes.size());
 
-        std::span<std::byte> writtenData { _data.data() + _writeCursor, bytes.size() };
-
-        std::memcpy(writtenData.data(), bytes.data(), bytes.size());
+        std::memcpy(_data.data() + _writeCursor, bytes.data(), bytes.size());
         _writeCursor += bytes.size();
-        return writtenData;
+        return bytes.size();
     }
 }
@@ -92,9 +92,14 @@ namespace libtactmon::io {
         std::size_t SeekWrite(std::size_t offset) override;
         void SkipWrite(std::size_t offset) override { _writeCursor += offset; }
 
+        /**
+         * Preallocates storage for at least @p capacity bytes, so that writing up to that amount does not reallocate.
+         */
+        void Reserve(std::size_t capacity) { _data.reserve(capacity); }
+
     protected:
         std::size_t _ReadImpl(std::span<std::byte> writableSpan) override;
-        std::span<std::byte> _WriteImpl(std::span<const std::byte> writableSpan) override;
+        std::size_t _WriteImpl(std::span<const std::byte> writableSpan) override;
 
     private:
         std::vector<std::byte> _data;
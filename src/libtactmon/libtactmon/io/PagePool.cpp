@@ -0,0 +1,45 @@
+#include "libtactmon/io/PagePool.hpp"
+
+namespace libtactmon::io {
+    PagePool::PagePool(std::size_t pageSize, std::size_t maxFreePages)
+        : _pageSize(pageSize), _maxFreePages(maxFreePages)
+    { }
+
+    PagePool::~PagePool() {
+        for (std::byte* page : _freePages)
+            delete[] page;
+    }
+
+    /* static */ std::shared_ptr<PagePool> PagePool::Default() {
+        static const std::shared_ptr<PagePool> instance = std::make_shared<PagePool>();
+        return instance;
+    }
+
+    std::byte* PagePool::Acquire() {
+        {
+            std::lock_guard<std::mutex> guard { _lock };
+            if (!_freePages.empty()) {
+                std::byte* page = _freePages.back();
+                _freePages.pop_back();
+                return page;
+            }
+        }
+
+        return new std::byte[_pageSize];
+    }
+
+    void PagePool::Release(std::byte* page) {
+        if (page == nullptr)
+            return;
+
+        {
+            std::lock_guard<std::mutex> guard { _lock };
+            if (_freePages.size() < _maxFreePages) {
+                _freePages.push_back(page);
+                return;
+            }
+        }
+
+        delete[] page;
+    }
+}
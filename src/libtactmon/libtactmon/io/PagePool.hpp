@@ -0,0 +1,55 @@
+#pragma once
+
+#include "libtactmon/detail/Export.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace libtactmon::io {
+    /**
+     * A thread-safe free list of fixed-size pages of memory.
+     *
+     * Released pages are kept around (up to a limit) and handed out again instead of going back to the allocator.
+     */
+    struct LIBTACTMON_API PagePool final {
+        constexpr static const std::size_t DefaultPageSize = 64 * 1024;
+
+        /**
+         * Creates a new pool.
+         *
+         * @param[in] pageSize     The size of every page handed out by this pool.
+         * @param[in] maxFreePages The maximum amount of released pages kept for reuse.
+         */
+        explicit PagePool(std::size_t pageSize = DefaultPageSize, std::size_t maxFreePages = 256);
+        ~PagePool();
+
+        PagePool(PagePool const&) = delete;
+        PagePool& operator = (PagePool const&) = delete;
+
+        /**
+         * Returns the pool shared by streams that were not given one explicitly.
+         */
+        static std::shared_ptr<PagePool> Default();
+
+        [[nodiscard]] std::size_t pageSize() const { return _pageSize; }
+
+        /**
+         * Returns a page of @ref pageSize bytes. Its contents are unspecified.
+         */
+        [[nodiscard]] std::byte* Acquire();
+
+        /**
+         * Returns a page to this pool.
+         */
+        void Release(std::byte* page);
+
+    private:
+        std::size_t _pageSize;
+        std::size_t _maxFreePages;
+
+        std::mutex _lock;
+        std::vector<std::byte*> _freePages;
+    };
+}
@@ -0,0 +1,151 @@
+#include "libtactmon/io/PagedMemoryStream.hpp"
+
+#include <cstring>
+#include <utility>
+
+namespace libtactmon::io {
+    PagedMemoryStream::PagedMemoryStream(std::shared_ptr<PagePool> pool)
+        : IReadableStream(), IWritableStream(), _pool(std::move(pool)), _pageSize(_pool->pageSize())
+    { }
+
+    PagedMemoryStream::~PagedMemoryStream() {
+        ReleasePages();
+    }
+
+    PagedMemoryStream::PagedMemoryStream(PagedMemoryStream&& other) noexcept
+        : IReadableStream(), IWritableStream(), _pool(other._pool), _pageSize(other._pageSize),
+        _pages(std::move(other._pages)), _origin(other._origin), _size(other._size),
+        _readCursor(other._readCursor), _writeCursor(other._writeCursor)
+    {
+        other._pages.clear();
+        other._origin = other._size = other._readCursor = other._writeCursor = 0;
+    }
+
+    PagedMemoryStream& PagedMemoryStream::operator = (PagedMemoryStream&& other) noexcept {
+        if (this == &other)
+            return *this;
+
+        ReleasePages();
+
+        _pool = other._pool;
+        _pageSize = other._pageSize;
+        _pages = std::move(other._pages);
+        _origin = other._origin;
+        _size = other._size;
+        _readCursor = other._readCursor;
+        _writeCursor = other._writeCursor;
+
+        other._pages.clear();
+        other._origin = other._size = other._readCursor = other._writeCursor = 0;
+        return *this;
+    }
+
+    std::size_t PagedMemoryStream::SeekRead(std::size_t offset) {
+        return _readCursor = std::clamp(offset, _origin, _size);
+    }
+
+    std::span<std::byte const> PagedMemoryStream::Data() const {
+        if (_readCursor >= _size)
+            return { };
+
+        return SegmentAt(_readCursor, _size - _readCursor);
+    }
+
+    std::size_t PagedMemoryStream::SeekWrite(std::size_t offset) {
+        // Mirrors GrowableMemoryStream: the stream is resized to the new position of the write cursor.
+        offset = std::max(offset, _origin);
+        if (offset < _size) {
+            Truncate(offset);
+        } else if (offset > _size) {
+            EnsureCapacity(offset);
+            for (std::size_t position = _size; position < offset; ) {
+                std::span<std::byte> segment = SegmentAt(position, offset - position);
+                std::memset(segment.data(), 0, segment.size());
+                position += segment.size();
+            }
+            _size = offset;
+        }
+
+        return _writeCursor = offset;
+    }
+
+    void PagedMemoryStream::Compact() {
+        std::size_t releasedPages = (_readCursor - _origin) / _pageSize;
+        for (std::size_t i = 0; i < releasedPages; ++i) {
+            _pool->Release(_pages.front());
+            _pages.pop_front();
+        }
+
+        _origin += releasedPages * _pageSize;
+        _writeCursor = std::max(_writeCursor, _origin);
+    }
+
+    std::size_t PagedMemoryStream::_ReadImpl(std::span<std::byte> bytes) {
+        std::size_t length = std::min(bytes.size(), _size - _readCursor);
+
+        std::size_t bytesRead = 0;
+        ForEachSegment(length, [&](std::span<const std::byte> segment) {
+            std::memcpy(bytes.data() + bytesRead, segment.data(), segment.size());
+            bytesRead += segment.size();
+        });
+
+        _readCursor += length;
+        return length;
+    }
+
+    std::size_t PagedMemoryStream::_WriteImpl(std::span<const std::byte> bytes) {
+        // A write past the end of the data (after SkipWrite) leaves a zero-filled gap.
+        if (_writeCursor > _size)
+            SeekWrite(_writeCursor);
+
+        EnsureCapacity(_writeCursor + bytes.size());
+        Fill(_writeCursor, bytes);
+
+        _writeCursor += bytes.size();
+        _size = std::max(_size, _writeCursor);
+        return bytes.size();
+    }
+
+    std::span<std::byte> PagedMemoryStream::SegmentAt(std::size_t position, std::size_t maxLength) const {
+        std::size_t relativePosition = position - _origin;
+        std::size_t pageOffset = relativePosition % _pageSize;
+
+        std::byte* page = _pages[relativePosition / _pageSize];
+        return std::span { page + pageOffset, std::min(maxLength, _pageSize - pageOffset) };
+    }
+
+    void PagedMemoryStream::EnsureCapacity(std::size_t end) {
+        while (_origin + _pages.size() * _pageSize < end)
+            _pages.push_back(_pool->Acquire());
+    }
+
+    void PagedMemoryStream::Fill(std::size_t position, std::span<const std::byte> data) {
+        while (!data.empty()) {
+            std::span<std::byte> segment = SegmentAt(position, data.size());
+            std::memcpy(segment.data(), data.data(), segment.size());
+
+            position += segment.size();
+            data = data.subspan(segment.size());
+        }
+    }
+
+    void PagedMemoryStream::Truncate(std::size_t size) {
+        _size = size;
+        _readCursor = std::min(_readCursor, _size);
+
+        std::size_t pageCount = (_size - _origin + _pageSize - 1) / _pageSize;
+        while (_pages.size() > pageCount) {
+            _pool->Release(_pages.back());
+            _pages.pop_back();
+        }
+    }
+
+    void PagedMemoryStream::ReleasePages() {
+        if (_pool == nullptr)
+            return;
+
+        for (std::byte* page : _pages)
+            _pool->Release(page);
+        _pages.clear();
+    }
+}
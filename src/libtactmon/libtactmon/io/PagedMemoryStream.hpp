@@ -0,0 +1,111 @@
+#pragma once
+
+#include "libtactmon/detail/Export.hpp"
+#include "libtactmon/io/IReadableStream.hpp"
+#include "libtactmon/io/IWritableStream.hpp"
+#include "libtactmon/io/PagePool.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <span>
+
+namespace libtactmon::io {
+    /**
+     * A growable in-memory stream that stores its data in fixed-size pages taken from a @ref PagePool, rather than in a
+     * single contiguous buffer. Growing never moves existing data, and pages that were fully consumed can be handed back
+     * to the pool with @ref Compact, which makes this stream suitable as a FIFO for data that is produced and consumed
+     * incrementally.
+     *
+     * Since the data is not contiguous, @ref Data only returns the bytes between the read cursor and the end of the page
+     * it points into; use @ref ForEachSegment to walk a larger range.
+     */
+    struct LIBTACTMON_API PagedMemoryStream final : IReadableStream, IWritableStream {
+        explicit PagedMemoryStream(std::shared_ptr<PagePool> pool = PagePool::Default());
+        ~PagedMemoryStream() override;
+
+        PagedMemoryStream(PagedMemoryStream&& other) noexcept;
+        PagedMemoryStream& operator = (PagedMemoryStream&& other) noexcept;
+
+        PagedMemoryStream(PagedMemoryStream const&) = delete;
+        PagedMemoryStream& operator = (PagedMemoryStream const&) = delete;
+
+    public: // IStream
+        [[nodiscard]] std::size_t GetLength() const override { return _size; }
+        explicit operator bool() const override { return true; }
+
+    public: // IReadableStream
+        [[nodiscard]] std::size_t GetReadCursor() const override { return _readCursor; }
+        std::size_t SeekRead(std::size_t offset) override;
+        void SkipRead(std::size_t offset) override { _readCursor = std::min(_readCursor + offset, _size); }
+        [[nodiscard]] bool CanRead(std::size_t amount) const override { return _readCursor + amount <= _size; }
+
+        /**
+         * Returns the data located between the read cursor and the end of the page it points into.
+         */
+        [[nodiscard]] std::span<std::byte const> Data() const override;
+
+        using IReadableStream::Data;
+
+    public: // IWritableStream
+        [[nodiscard]] std::size_t GetWriteCursor() const override { return _writeCursor; }
+        std::size_t SeekWrite(std::size_t offset) override;
+        void SkipWrite(std::size_t offset) override { _writeCursor += offset; }
+
+    public:
+        /**
+         * Invokes a callable on each contiguous segment of data following the read cursor, up to a given amount of bytes.
+         * The read cursor is not moved.
+         *
+         * @param[in] length  The amount of bytes to visit.
+         * @param[in] handler A callable invoked with a <tt>std::span<const std::byte></tt> for every segment.
+         */
+        template <typename Handler>
+        void ForEachSegment(std::size_t length, Handler&& handler) const {
+            length = std::min(length, _size - _readCursor);
+
+            for (std::size_t position = _readCursor; length != 0; ) {
+                std::span<const std::byte> segment = SegmentAt(position, length);
+                handler(segment);
+
+                position += segment.size();
+                length -= segment.size();
+            }
+        }
+
+        /**
+         * Returns every page located entirely before the read cursor to the pool. Offsets are not affected, but the data
+         * before the read cursor can no longer be accessed; both cursors are clamped accordingly.
+         */
+        void Compact();
+
+    protected:
+        std::size_t _ReadImpl(std::span<std::byte> writableSpan) override;
+        std::size_t _WriteImpl(std::span<const std::byte> writableSpan) override;
+
+    private:
+        /**
+         * Returns the data starting at a given absolute position, up to the end of the page it lives in or @p maxLength.
+         */
+        [[nodiscard]] std::span<std::byte> SegmentAt(std::size_t position, std::size_t maxLength) const;
+
+        /**
+         * Allocates pages until the given absolute position is backed by memory.
+         */
+        void EnsureCapacity(std::size_t end);
+
+        void Fill(std::size_t position, std::span<const std::byte> data);
+        void Truncate(std::size_t size);
+        void ReleasePages();
+
+        std::shared_ptr<PagePool> _pool;
+        std::size_t _pageSize;
+
+        std::deque<std::byte*> _pages;
+        std::size_t _origin = 0; //< Absolute offset of the first byte of the first page.
+        std::size_t _size = 0;
+        std::size_t _readCursor = 0;
+        std::size_t _writeCursor = 0;
+    };
+}
@@ -0,0 +1,19 @@
+#include "libtactmon/io/SpanReader.hpp"
+
+#include <assert.hpp>
+
+namespace libtactmon::io {
+    SpanReader::SpanReader(IReadableStream const& stream) : _data(stream.Data()) {
+        DEBUG_ASSERT(_data.size() == stream.GetLength() - stream.GetReadCursor(), "Stream data is not contiguous");
+
+        // Reading part of the data would look like a truncated file to parsers; give them nothing instead, so that they fail.
+        if (_data.size() != stream.GetLength() - stream.GetReadCursor())
+            _data = { };
+    }
+
+    SpanReader::SpanReader(IReadableStream const& stream, AccessPattern pattern) : SpanReader(stream) {
+        stream.Advise(pattern);
+        if (pattern == AccessPattern::Sequential)
+            stream.Prefetch(stream.GetReadCursor(), _data.size());
+    }
+}
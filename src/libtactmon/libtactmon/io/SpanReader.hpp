@@ -0,0 +1,185 @@
+#pragma once
+
+#include "libtactmon/detail/Export.hpp"
+#include "libtactmon/io/IReadableStream.hpp"
+#include "libtactmon/utility/Endian.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <concepts>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <string_view>
+#include <type_traits>
+
+namespace libtactmon::io {
+    /**
+     * A non-virtual reader over a contiguous sequence of bytes.
+     *
+     * This is meant for parsers that read many small fields in a row, where going through the virtual interface of
+     * @ref IReadableStream for every field shows up in profiles. Reading past the end of the data yields zero-initialized
+     * values and moves the cursor to the end of the data; callers are expected to check @ref CanRead beforehand.
+     */
+    struct LIBTACTMON_API SpanReader final {
+        constexpr SpanReader() noexcept = default;
+        constexpr explicit SpanReader(std::span<const std::byte> data) noexcept : _data(data) { }
+
+        /**
+         * Creates a reader over the data of a stream, starting at its read cursor. The stream itself is left untouched.
+         *
+         * The stream must expose all of its remaining data through @ref IReadableStream::Data, which rules out streams
+         * made of several pages such as @ref PagedMemoryStream. If it does not, the reader is empty.
+         */
+        explicit SpanReader(IReadableStream const& stream);
+
+        /**
+         * Creates a reader over the data of a stream, starting at its read cursor, and tells the stream how that data is
+         * going to be read. For sequential reads, the data is also prefetched. See @ref SpanReader(IReadableStream const&).
+         */
+        SpanReader(IReadableStream const& stream, AccessPattern pattern);
+
+        /**
+         * Returns the total amount of bytes this reader was created over.
+         */
+        [[nodiscard]] constexpr std::size_t size() const noexcept { return _data.size(); }
+
+        /**
+         * Returns the position of the read cursor.
+         */
+        [[nodiscard]] constexpr std::size_t cursor() const noexcept { return _cursor; }
+
+        /**
+         * Returns the amount of bytes left to read.
+         */
+        [[nodiscard]] constexpr std::size_t remaining() const noexcept { return _data.size() - _cursor; }
+
+        /**
+         * Returns true if at least @p amount bytes can be read.
+         */
+        [[nodiscard]] constexpr bool CanRead(std::size_t amount) const noexcept { return amount <= remaining(); }
+
+        /**
+         * Sets the position of the read cursor; the position is clamped to the end of the data.
+         */
+        constexpr void Seek(std::size_t offset) noexcept { _cursor = std::min(offset, _data.size()); }
+
+        /**
+         * Moves the read cursor forward; the position is clamped to the end of the data.
+         */
+        constexpr void Skip(std::size_t amount) noexcept { _cursor += std::min(amount, remaining()); }
+
+        /**
+         * Returns the data located after the read cursor.
+         */
+        [[nodiscard]] constexpr std::span<const std::byte> Data() const noexcept { return _data.subspan(_cursor); }
+
+        template <typename T> requires (!std::same_as<T, std::byte> && std::is_trivial_v<T>)
+        [[nodiscard]] std::span<const T> Data() const noexcept {
+            return std::span { reinterpret_cast<const T*>(_data.data() + _cursor), remaining() / sizeof(T) };
+        }
+
+        /**
+         * Reads an integer stored with the given endianness.
+         */
+        template <std::integral T, std::endian Endianness = std::endian::native>
+        [[nodiscard]] T Read() noexcept {
+            if (!CanRead(sizeof(T))) {
+                _cursor = _data.size();
+                return T { };
+            }
+
+            T value;
+            std::memcpy(std::addressof(value), _data.data() + _cursor, sizeof(T));
+            _cursor += sizeof(T);
+
+            return utility::to_endianness<std::endian::native, Endianness>(value);
+        }
+
+        /**
+         * Reads an unsigned integer of arbitrary width (up to 8 bytes), stored with the given endianness.
+         *
+         * @param[in] width The amount of bytes the integer is stored on.
+         */
+        template <std::endian Endianness>
+        [[nodiscard]] uint64_t ReadUInt(std::size_t width) noexcept {
+            if (width > sizeof(uint64_t) || !CanRead(width)) {
+                _cursor = _data.size();
+                return 0;
+            }
+
+            std::byte const* bytes = _data.data() + _cursor;
+            _cursor += width;
+
+            uint64_t value = 0;
+            if constexpr (Endianness == std::endian::big) {
+                for (std::size_t i = 0; i < width; ++i)
+                    value = (value << 8) | std::to_integer<uint64_t>(bytes[i]);
+            } else {
+                for (std::size_t i = width; i > 0; --i)
+                    value = (value << 8) | std::to_integer<uint64_t>(bytes[i - 1]);
+            }
+            return value;
+        }
+
+        /**
+         * Reads an array of integers stored with the given endianness, converting them in bulk.
+         *
+         * @param[out] values Storage for the values to read.
+         * @returns true if enough data was available to fill @p values.
+         */
+        template <std::integral T, std::endian Endianness = std::endian::native>
+        bool ReadArray(std::span<T> values) noexcept {
+            if (!CanRead(values.size_bytes())) {
+                _cursor = _data.size();
+                return false;
+            }
+
+            std::memcpy(values.data(), _data.data() + _cursor, values.size_bytes());
+            _cursor += values.size_bytes();
+
+            if constexpr (Endianness != std::endian::native && sizeof(T) > 1) {
+                for (T& value : values)
+                    value = utility::byteswap(value);
+            }
+
+            return true;
+        }
+
+        /**
+         * Returns a view over the next @p count elements and moves the cursor past them, or an empty view if not enough
+         * data is available. No endianness conversion is performed.
+         */
+        template <typename T = std::byte> requires (std::is_trivial_v<T>)
+        [[nodiscard]] std::span<const T> ReadSpan(std::size_t count) noexcept {
+            if (!CanRead(count * sizeof(T))) {
+                _cursor = _data.size();
+                return { };
+            }
+
+            std::span<const T> values { reinterpret_cast<const T*>(_data.data() + _cursor), count };
+            _cursor += count * sizeof(T);
+            return values;
+        }
+
+        /**
+         * Reads a null-terminated string, returning a view over it. If no terminator is found, the view covers the rest
+         * of the data.
+         */
+        [[nodiscard]] std::string_view ReadCString() noexcept {
+            std::span<const std::byte> data = Data();
+
+            void const* terminator = std::memchr(data.data(), '\0', data.size());
+            std::size_t length = terminator != nullptr
+                ? static_cast<std::size_t>(static_cast<std::byte const*>(terminator) - data.data())
+                : data.size();
+
+            _cursor += std::min(length + 1, data.size());
+            return std::string_view { reinterpret_cast<const char*>(data.data()), length };
+        }
+
+    private:
+        std::span<const std::byte> _data;
+        std::size_t _cursor = 0;
+    };
+}
@@ -0,0 +1,379 @@
+#include "libtactmon/net/ConnectionPool.hpp"
+#include "libtactmon/net/HostOverrides.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/execution/context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <fmt/format.h>
+
+namespace libtactmon::net {
+    using tcp = boost::asio::ip::tcp;
+
+    template <typename Handler>
+    struct ConnectionPool::HandlerWaiter final : Waiter {
+        explicit HandlerWaiter(Handler handler) : _handler(std::move(handler)) { }
+
+        void Resume() override {
+            // Completes on the handler's associated executor.
+            boost::asio::post(std::move(_handler));
+        }
+
+    private:
+        Handler _handler;
+    };
+
+    /**
+     * Keeps track of the pools holding connections bound to an execution context. When the context shuts down, these
+     * connections are closed and the coroutines waiting on them are destroyed, as their sockets and handlers may not outlive
+     * the context.
+     */
+    struct ConnectionPool::ContextService final : boost::asio::execution_context::service {
+        static inline boost::asio::execution_context::id id;
+
+        explicit ContextService(boost::asio::execution_context& context) : service(context) { }
+
+        /**
+         * Registers a pool holding connections bound to this context.
+         *
+         * @returns A token that expires once the context shuts down.
+         */
+        std::weak_ptr<const void> Register(std::shared_ptr<State> const& state) {
+            std::lock_guard<std::mutex> guard { _lock };
+
+            std::erase_if(_pools, [](std::weak_ptr<State> const& pool) { return pool.expired(); });
+            bool registered = std::any_of(_pools.begin(), _pools.end(), [&state](std::weak_ptr<State> const& pool) {
+                return !pool.owner_before(state) && !state.owner_before(pool);
+            });
+
+            if (!registered)
+                _pools.push_back(state);
+
+            return _alive;
+        }
+
+    private:
+        void shutdown() override {
+            std::vector<std::weak_ptr<State>> pools;
+            {
+                std::lock_guard<std::mutex> guard { _lock };
+                pools = std::move(_pools);
+                _alive.reset();
+            }
+
+            for (std::weak_ptr<State> const& pool : pools) {
+                std::shared_ptr<State> state = pool.lock();
+                if (state == nullptr)
+                    continue;
+
+                // Destroyed outside of the lock; destroying a waiter may release leases held by its coroutine.
+                std::vector<std::unique_ptr<Connection>> connections;
+                std::vector<std::unique_ptr<Waiter>> waiters;
+
+                {
+                    std::lock_guard<std::mutex> guard { state->Lock };
+                    for (auto&& [key, host] : state->Hosts) {
+                        for (std::unique_ptr<Connection>& connection : host.Idle)
+                            if (connection->_context == &context())
+                                connections.push_back(std::move(connection));
+                        std::erase(host.Idle, nullptr);
+
+                        for (std::unique_ptr<Waiter>& waiter : host.Waiters)
+                            if (waiter->Context == &context())
+                                waiters.push_back(std::move(waiter));
+                        std::erase(host.Waiters, nullptr);
+                    }
+                }
+            }
+        }
+
+        std::mutex _lock;
+        std::vector<std::weak_ptr<State>> _pools;
+        std::shared_ptr<const void> _alive = std::make_shared<bool>(true);
+    };
+
+    ConnectionPool::ConnectionPool() : ConnectionPool(Options { }) { }
+
+    ConnectionPool::ConnectionPool(Options options) : _options(options), _state(std::make_shared<State>()) {
+        _options.MaxConnectionsPerHost = std::max<std::size_t>(1, _options.MaxConnectionsPerHost);
+        _options.MaxPipelineDepth = std::max<std::size_t>(1, _options.MaxPipelineDepth);
+    }
+
+    ConnectionPool::~ConnectionPool() {
+        Clear();
+    }
+
+    /* static */ ConnectionPool& ConnectionPool::Default() {
+        static ConnectionPool instance;
+        return instance;
+    }
+
+    ConnectionPool::Lease ConnectionPool::Acquire(boost::asio::any_io_executor const& executor, std::string_view host, std::string_view service,
+        boost::system::error_code& ec)
+    {
+        ec = { };
+
+        boost::asio::execution_context& context = boost::asio::query(executor, boost::asio::execution::context);
+
+        std::string key = fmt::format("{}:{}", host, service);
+        tcp::resolver::results_type endpoints;
+
+        {
+            std::unique_lock<std::mutex> guard { _state->Lock };
+            Host& state = _state->Hosts[key];
+
+            for (;;) {
+                if (std::unique_ptr<Connection> connection = TakeIdle(state, context); connection != nullptr) {
+                    ++state.Active;
+                    return Lease { this, std::move(connection), true };
+                }
+
+                if (state.Active < _options.MaxConnectionsPerHost)
+                    break;
+
+                _state->Released.wait(guard);
+            }
+
+            EvictIdle(state);
+
+            ++state.Active;
+            if (!state.Endpoints.empty() && std::chrono::steady_clock::now() - state.ResolvedAt < _options.ResolveTimeout)
+                endpoints = state.Endpoints;
+        }
+
+        auto connection = std::make_unique<Connection>(executor);
+        connection->_key = std::move(key);
+        Bind(*connection, context);
+
+        if (endpoints.empty()) {
+            Endpoint endpoint = HostOverrides::Default().Resolve(host, service);
+
+            tcp::resolver resolver { executor };
+            endpoints = resolver.resolve(endpoint.Host, endpoint.Service, ec);
+
+            if (!ec.failed()) {
+                std::lock_guard<std::mutex> guard { _state->Lock };
+                Host& state = _state->Hosts[connection->_key];
+                state.Endpoints = endpoints;
+                state.ResolvedAt = std::chrono::steady_clock::now();
+            }
+        }
+
+        if (!ec.failed())
+            connection->Stream.connect(endpoints, ec);
+
+        if (ec.failed()) {
+            Release(std::move(connection), false);
+            return { };
+        }
+
+        return Lease { this, std::move(connection), false };
+    }
+
+    boost::asio::awaitable<ConnectionPool::Lease> ConnectionPool::AcquireAsync(std::string host, std::string service, boost::system::error_code& ec) {
+        ec = { };
+
+        boost::asio::any_io_executor executor = co_await boost::asio::this_coro::executor;
+        boost::asio::execution_context& context = boost::asio::query(executor, boost::asio::execution::context);
+
+        std::string key = fmt::format("{}:{}", host, service);
+        tcp::resolver::results_type endpoints;
+
+        for (;;) {
+            std::unique_ptr<Connection> reusable;
+
+            {
+                std::lock_guard<std::mutex> guard { _state->Lock };
+                Host& state = _state->Hosts[key];
+
+                reusable = TakeIdle(state, context);
+                if (reusable != nullptr)
+                    ++state.Active;
+                else if (state.Active < _options.MaxConnectionsPerHost) {
+                    EvictIdle(state);
+
+                    ++state.Active;
+                    if (!state.Endpoints.empty() && std::chrono::steady_clock::now() - state.ResolvedAt < _options.ResolveTimeout)
+                        endpoints = state.Endpoints;
+
+                    break;
+                }
+            }
+
+            if (reusable != nullptr)
+                co_return Lease { this, std::move(reusable), true };
+
+            co_await WaitForRelease(key, context);
+        }
+
+        auto connection = std::make_unique<Connection>(executor);
+        connection->_key = std::move(key);
+        Bind(*connection, context);
+
+        if (endpoints.empty()) {
+            Endpoint endpoint = HostOverrides::Default().Resolve(host, service);
+
+            tcp::resolver resolver { executor };
+            endpoints = co_await resolver.async_resolve(endpoint.Host, endpoint.Service, boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+
+            if (!ec.failed()) {
+                std::lock_guard<std::mutex> guard { _state->Lock };
+                Host& state = _state->Hosts[connection->_key];
+                state.Endpoints = endpoints;
+                state.ResolvedAt = std::chrono::steady_clock::now();
+            }
+        }
+
+        if (!ec.failed()) {
+            connection->Stream.expires_after(_options.IoTimeout);
+            co_await connection->Stream.async_connect(endpoints, boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+            connection->Stream.expires_never();
+        }
+
+        if (ec.failed()) {
+            Release(std::move(connection), false);
+            co_return Lease { };
+        }
+
+        co_return Lease { this, std::move(connection), false };
+    }
+
+    boost::asio::awaitable<void> ConnectionPool::WaitForRelease(std::string const& key, boost::asio::execution_context& context) {
+        auto initiation = [this, &key, &context](auto handler) {
+            std::unique_lock<std::mutex> guard { _state->Lock };
+
+            // A connection may have been released since the caller last checked.
+            Host& state = _state->Hosts[key];
+            bool hasIdle = std::any_of(state.Idle.begin(), state.Idle.end(), [&context](std::unique_ptr<Connection> const& connection) {
+                return connection->_context == &context;
+            });
+
+            if (hasIdle || state.Active < _options.MaxConnectionsPerHost) {
+                guard.unlock();
+
+                boost::asio::post(std::move(handler));
+                return;
+            }
+
+            auto waiter = std::make_unique<HandlerWaiter<decltype(handler)>>(std::move(handler));
+            waiter->Context = &context;
+            state.Waiters.push_back(std::move(waiter));
+        };
+
+        return boost::asio::async_initiate<decltype(boost::asio::use_awaitable) const&, void()>(std::move(initiation), boost::asio::use_awaitable);
+    }
+
+    void ConnectionPool::Clear() {
+        std::lock_guard<std::mutex> guard { _state->Lock };
+        for (auto&& [key, state] : _state->Hosts)
+            state.Idle.clear();
+    }
+
+    std::unique_ptr<ConnectionPool::Connection> ConnectionPool::TakeIdle(Host& state, boost::asio::execution_context const& context) {
+        // Drop connections that sat idle for too long; the server has likely closed them already.
+        auto now = std::chrono::steady_clock::now();
+        std::erase_if(state.Idle, [&](std::unique_ptr<Connection> const& connection) {
+            return now - connection->_lastUsed > _options.IdleTimeout;
+        });
+
+        auto itr = std::find_if(state.Idle.rbegin(), state.Idle.rend(), [&context](std::unique_ptr<Connection> const& connection) {
+            return connection->_context == &context;
+        });
+        if (itr == state.Idle.rend())
+            return nullptr;
+
+        std::unique_ptr<Connection> connection = std::move(*itr);
+        state.Idle.erase(std::next(itr).base());
+        return connection;
+    }
+
+    void ConnectionPool::EvictIdle(Host& state) {
+        // Idle connections are the oldest at the front.
+        if (!state.Idle.empty() && state.Active + state.Idle.size() >= _options.MaxConnectionsPerHost)
+            state.Idle.erase(state.Idle.begin());
+    }
+
+    void ConnectionPool::Bind(Connection& connection, boost::asio::execution_context& context) {
+        connection._context = &context;
+        connection._contextAlive = boost::asio::use_service<ContextService>(context).Register(_state);
+    }
+
+    void ConnectionPool::Release(std::unique_ptr<Connection> connection, bool recycle) {
+        std::unique_ptr<Waiter> waiter;
+
+        {
+            std::lock_guard<std::mutex> guard { _state->Lock };
+
+            Host& state = _state->Hosts[connection->_key];
+            --state.Active;
+
+            // Connections released after their context shut down would never be dropped.
+            if (recycle && !connection->_contextAlive.expired() && connection->Stream.socket().is_open()) {
+                connection->_lastUsed = std::chrono::steady_clock::now();
+                state.Idle.push_back(std::move(connection));
+            }
+
+            if (!state.Waiters.empty()) {
+                waiter = std::move(state.Waiters.front());
+                state.Waiters.pop_front();
+            }
+
+            _state->Released.notify_all();
+        }
+
+        // Resumed outside of the lock; the coroutine checks again whether a connection is available.
+        if (waiter != nullptr)
+            waiter->Resume();
+    }
+
+    // ^^^ ConnectionPool / ConnectionPool::Lease vvv
+
+    ConnectionPool::Lease::Lease(ConnectionPool* pool, std::unique_ptr<Connection> connection, bool reused)
+        : _pool(pool), _connection(std::move(connection)), _reused(reused)
+    { }
+
+    ConnectionPool::Lease::~Lease() {
+        Release();
+    }
+
+    ConnectionPool::Lease::Lease(Lease&& other) noexcept
+        : _pool(other._pool), _connection(std::move(other._connection)), _reused(other._reused), _recycle(other._recycle)
+    {
+        other._pool = nullptr;
+    }
+
+    ConnectionPool::Lease& ConnectionPool::Lease::operator = (Lease&& other) noexcept {
+        if (this != &other) {
+            Release();
+
+            _pool = other._pool;
+            _connection = std::move(other._connection);
+            _reused = other._reused;
+            _recycle = other._recycle;
+
+            other._pool = nullptr;
+        }
+
+        return *this;
+    }
+
+    void ConnectionPool::Lease::Release() {
+        if (_pool == nullptr || _connection == nullptr)
+            return;
+
+        if (!_recycle) {
+            boost::system::error_code ec;
+            _connection->Stream.socket().shutdown(tcp::socket::shutdown_both, ec);
+            _connection->Stream.close();
+        }
+
+        _pool->Release(std::move(_connection), _recycle);
+        _pool = nullptr;
+    }
+}
@@ -0,0 +1,215 @@
+#pragma once
+
+#include "libtactmon/detail/Export.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/beast/core/flat_buffer.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
+#include <boost/system/error_code.hpp>
+
+namespace libtactmon::net {
+    /**
+     * A pool of persistent (HTTP/1.1 keep-alive) connections, grouped by remote host.
+     *
+     * Connections are handed out through a @ref Lease. Once a response has been fully read and the server did not ask for
+     * the connection to be closed, the lease is recycled and the connection goes back to the pool, where it stays until it
+     * is reused or its idle timeout expires. The amount of connections to a given host is capped; callers wait for a
+     * connection to be released when the cap is reached.
+     *
+     * Connections are bound to the execution context of the executor they were created with: idle connections are only
+     * handed out to callers running on that same context, and are closed when it shuts down, so that a pool may outlive the
+     * contexts it served.
+     */
+    struct LIBTACTMON_API ConnectionPool final {
+        struct Options {
+            //! Maximum amount of simultaneous connections to a single host.
+            std::size_t MaxConnectionsPerHost = 6;
+
+            //! Idle connections older than this are closed instead of being reused.
+            std::chrono::steady_clock::duration IdleTimeout = std::chrono::seconds { 30 };
+
+            //! Resolved endpoints are reused for this long.
+            std::chrono::steady_clock::duration ResolveTimeout = std::chrono::minutes { 5 };
+
+            //! Maximum amount of requests sent on a connection before reading their responses.
+            std::size_t MaxPipelineDepth = 16;
+
+            //! Asynchronous operations fail if they make no progress for this long.
+            std::chrono::steady_clock::duration IoTimeout = std::chrono::seconds { 30 };
+        };
+
+        struct Connection {
+            explicit Connection(boost::asio::any_io_executor executor) : Stream(std::move(executor)) { }
+
+            boost::beast::tcp_stream Stream;
+
+            //! Bytes received past the end of the previous response, which belong to the next one.
+            boost::beast::flat_buffer Buffer;
+
+        private:
+            friend struct ConnectionPool;
+
+            std::string _key;
+            boost::asio::execution_context* _context = nullptr;
+            std::weak_ptr<const void> _contextAlive;
+            std::chrono::steady_clock::time_point _lastUsed;
+        };
+
+        /**
+         * Exclusive access to a connection. Unless @ref Recycle is called, the connection is closed when the lease is
+         * destroyed.
+         */
+        struct LIBTACTMON_API Lease final {
+            Lease() = default;
+            ~Lease();
+
+            Lease(Lease&& other) noexcept;
+            Lease& operator = (Lease&& other) noexcept;
+
+            Lease(Lease const&) = delete;
+            Lease& operator = (Lease const&) = delete;
+
+            explicit operator bool() const { return _connection != nullptr; }
+
+            Connection* operator -> () const { return _connection.get(); }
+            Connection& operator * () const { return *_connection; }
+
+            /**
+             * Returns true if the connection was used by a previous request. Such a connection may have been closed by the
+             * server in the meantime; requests that fail before receiving anything should be retried on a new connection.
+             */
+            [[nodiscard]] bool reused() const { return _reused; }
+
+            /**
+             * Marks the connection as reusable; it is returned to the pool when the lease is destroyed.
+             */
+            void Recycle() { _recycle = true; }
+
+        private:
+            friend struct ConnectionPool;
+
+            Lease(ConnectionPool* pool, std::unique_ptr<Connection> connection, bool reused);
+
+            void Release();
+
+            ConnectionPool* _pool = nullptr;
+            std::unique_ptr<Connection> _connection;
+            bool _reused = false;
+            bool _recycle = false;
+        };
+
+        ConnectionPool();
+        explicit ConnectionPool(Options options);
+        ~ConnectionPool();
+
+        ConnectionPool(ConnectionPool const&) = delete;
+        ConnectionPool& operator = (ConnectionPool const&) = delete;
+
+        /**
+         * Returns the pool used by download tasks.
+         */
+        static ConnectionPool& Default();
+
+        [[nodiscard]] Options const& options() const { return _options; }
+
+        /**
+         * Obtains a connection to a host, reusing an idle one if possible. Blocks if the maximum amount of connections to
+         * that host is reached.
+         *
+         * @param[in]  executor The executor new connections are bound to.
+         * @param[in]  host     The remote host.
+         * @param[in]  service  The remote port or service name.
+         * @param[out] ec       Set if no connection could be established.
+         */
+        [[nodiscard]] Lease Acquire(boost::asio::any_io_executor const& executor, std::string_view host, std::string_view service,
+            boost::system::error_code& ec);
+
+        /**
+         * Obtains a connection to a host, reusing an idle one if possible. If the maximum amount of connections to that host
+         * is reached, the calling coroutine is suspended until one is released.
+         *
+         * @param[in]  host    The remote host.
+         * @param[in]  service The remote port or service name.
+         * @param[out] ec      Set if no connection could be established.
+         */
+        [[nodiscard]] boost::asio::awaitable<Lease> AcquireAsync(std::string host, std::string service, boost::system::error_code& ec);
+
+        /**
+         * Closes every idle connection.
+         */
+        void Clear();
+
+    private:
+        //! A suspended call to @ref AcquireAsync.
+        struct Waiter {
+            virtual ~Waiter() = default;
+
+            virtual void Resume() = 0;
+
+            //! The execution context of the suspended coroutine.
+            boost::asio::execution_context* Context = nullptr;
+        };
+
+        template <typename Handler> struct HandlerWaiter;
+        struct ContextService;
+
+        struct Host {
+            std::vector<std::unique_ptr<Connection>> Idle;
+            std::size_t Active = 0;
+
+            std::deque<std::unique_ptr<Waiter>> Waiters;
+
+            boost::asio::ip::tcp::resolver::results_type Endpoints;
+            std::chrono::steady_clock::time_point ResolvedAt;
+        };
+
+        //! Shared with the execution contexts connections are bound to, which may outlive the pool.
+        struct State {
+            std::mutex Lock;
+            std::condition_variable Released;
+            std::unordered_map<std::string, Host> Hosts;
+        };
+
+        /**
+         * Takes an idle connection to the given host that is bound to the given execution context, dropping the connections
+         * that sat idle for too long along the way. The caller must hold the lock.
+         */
+        std::unique_ptr<Connection> TakeIdle(Host& state, boost::asio::execution_context const& context);
+
+        /**
+         * Makes room for a new connection to the given host: if it would exceed the cap, an idle connection bound to another
+         * execution context is closed. The caller must hold the lock.
+         */
+        void EvictIdle(Host& state);
+
+        /**
+         * Binds a new connection to an execution context, so that it is closed when that context shuts down.
+         */
+        void Bind(Connection& connection, boost::asio::execution_context& context);
+
+        void Release(std::unique_ptr<Connection> connection, bool recycle);
+
+        /**
+         * Completes once a connection to the given host may be available.
+         */
+        boost::asio::awaitable<void> WaitForRelease(std::string const& key, boost::asio::execution_context& context);
+
+        Options _options;
+        std::shared_ptr<State> _state;
+    };
+}
@@ -0,0 +1,108 @@
+#include "libtactmon/net/DownloadProgress.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <fstream>
+#include <string_view>
+#include <system_error>
+
+namespace libtactmon::net {
+    namespace {
+        bool ParseNumber(std::string_view value, std::uint64_t& number) {
+            auto [ptr, ec] = std::from_chars(value.data(), value.data() + value.size(), number);
+            return ec == std::errc { } && ptr == value.data() + value.size();
+        }
+    }
+
+    /* static */ std::optional<DownloadProgress> DownloadProgress::Load(std::filesystem::path const& recordPath) {
+        std::ifstream stream { recordPath };
+        if (!stream)
+            return std::nullopt;
+
+        DownloadProgress progress;
+        std::string line;
+        if (!std::getline(stream, line) || !ParseNumber(line, progress.Received))
+            return std::nullopt;
+
+        std::getline(stream, progress.Validator);
+
+        if (!std::getline(stream, line) || line.empty())
+            return progress;
+
+        if (!ParseNumber(line, progress.TotalSize) || progress.Received > progress.TotalSize)
+            return std::nullopt;
+
+        std::uint64_t end = progress.Received;
+        while (std::getline(stream, line) && !line.empty()) {
+            std::size_t separator = line.find(' ');
+            if (separator == std::string::npos)
+                return std::nullopt;
+
+            Range range;
+            if (!ParseNumber(std::string_view { line }.substr(0, separator), range.Offset) || !ParseNumber(std::string_view { line }.substr(separator + 1), range.Length))
+                return std::nullopt;
+
+            // Ranges must be sorted, disjoint, and lie within the resource.
+            if (range.Offset <= end || range.Offset >= progress.TotalSize || range.Length == 0 || range.Length > progress.TotalSize - range.Offset)
+                return std::nullopt;
+
+            end = range.Offset + range.Length;
+            progress.Ranges.push_back(range);
+        }
+
+        return progress;
+    }
+
+    void DownloadProgress::Save(std::filesystem::path const& recordPath) const {
+        std::ofstream stream { recordPath, std::ios::trunc };
+        stream << Received << '\n' << Validator << '\n';
+
+        if (TotalSize != 0) {
+            stream << TotalSize << '\n';
+            for (Range const& range : Ranges)
+                stream << range.Offset << ' ' << range.Length << '\n';
+        }
+    }
+
+    void DownloadProgress::Add(std::uint64_t offset, std::uint64_t length) {
+        if (length == 0)
+            return;
+
+        Ranges.push_back(Range { offset, length });
+        std::sort(Ranges.begin(), Ranges.end(), [](Range const& left, Range const& right) {
+            return left.Offset < right.Offset;
+        });
+
+        // Ranges that reach the prefix are folded into it; the others are merged with their neighbors.
+        std::vector<Range> merged;
+        for (Range const& range : Ranges) {
+            std::uint64_t end = range.Offset + range.Length;
+
+            if (merged.empty() && range.Offset <= Received)
+                Received = std::max(Received, end);
+            else if (!merged.empty() && range.Offset <= merged.back().Offset + merged.back().Length)
+                merged.back().Length = std::max(merged.back().Offset + merged.back().Length, end) - merged.back().Offset;
+            else
+                merged.push_back(range);
+        }
+
+        Ranges = std::move(merged);
+    }
+
+    std::vector<DownloadProgress::Range> DownloadProgress::Missing() const {
+        std::vector<Range> missing;
+
+        std::uint64_t offset = Received;
+        for (Range const& range : Ranges) {
+            if (range.Offset > offset)
+                missing.push_back(Range { offset, range.Offset - offset });
+
+            offset = std::max(offset, range.Offset + range.Length);
+        }
+
+        if (offset < TotalSize)
+            missing.push_back(Range { offset, TotalSize - offset });
+
+        return missing;
+    }
+}
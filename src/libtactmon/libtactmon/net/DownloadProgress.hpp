@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace libtactmon::net {
+    /**
+     * The record of an interrupted download, kept in a <tt>.progress</tt> file next to the partial file.
+     *
+     * The first line is the amount of bytes received from the start of the resource, and the second one is the validator
+     * (ETag or Last-Modified date) of the resource, if any. Downloads made of several ranges (see @ref SegmentedDownload)
+     * append the size of the resource, then each range received past that prefix as an offset and a length; downloads that
+     * only resume from the prefix (see @ref FileDownloadTask) ignore these lines.
+     */
+    struct DownloadProgress {
+        struct Range {
+            std::uint64_t Offset = 0;
+            std::uint64_t Length = 0;
+        };
+
+        /**
+         * Reads a progress record.
+         *
+         * @returns The record, or an empty optional if it does not exist or is malformed.
+         */
+        static std::optional<DownloadProgress> Load(std::filesystem::path const& recordPath);
+
+        void Save(std::filesystem::path const& recordPath) const;
+
+        /**
+         * Marks a range of the resource as received.
+         */
+        void Add(std::uint64_t offset, std::uint64_t length);
+
+        /**
+         * Returns the ranges of the resource that are yet to be received. @ref TotalSize must be known.
+         */
+        [[nodiscard]] std::vector<Range> Missing() const;
+
+        //! Amount of bytes received from the start of the resource.
+        std::uint64_t Received = 0;
+
+        std::string Validator;
+
+        //! Size of the entire resource, or 0 if unknown.
+        std::uint64_t TotalSize = 0;
+
+        //! Ranges received past @ref Received, sorted and disjoint.
+        std::vector<Range> Ranges;
+    };
+}
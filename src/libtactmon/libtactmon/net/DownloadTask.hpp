@@ -2,18 +2,29 @@
 
 #include "libtactmon/io/FileStream.hpp"
 #include "libtactmon/io/MemoryStream.hpp"
+#include "libtactmon/net/ConnectionPool.hpp"
+#include "libtactmon/net/HostScoreboard.hpp"
 #include "libtactmon/tact/Cache.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
+#include <vector>
 
+#include <boost/asio/awaitable.hpp>
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <boost/beast/core/tcp_stream.hpp>
 #include <boost/beast/core/flat_buffer.hpp>
 #include <boost/beast/http.hpp>
@@ -73,66 +84,329 @@ namespace libtactmon::net {
             std::string_view host,
             spdlog::logger* logger = nullptr)
         {
-            namespace asio = boost::asio;
-            namespace ip = asio::ip;
-            using tcp = ip::tcp;
-
-            namespace beast = boost::beast;
             namespace http = boost::beast::http;
 
-            beast::error_code ec;
+            ConnectionPool& pool = ConnectionPool::Default();
 
             if (logger != nullptr)
                 logger->trace("Downloading '{}' from {}.", _resourcePath, host);
 
-            beast::tcp_stream stream { executor };
-            tcp::resolver r { executor };
+            for (;;) {
+                boost::beast::error_code ec;
 
-            stream.connect(r.resolve(host, "80"), ec);
-            if (ec.failed()) {
-                if (logger != nullptr)
-                    logger->error("An error occured while downloading {} from {}: {}.", _resourcePath, host, ec.message());
+                ConnectionPool::Lease connection = pool.Acquire(executor, host, "80", ec);
+                if (ec.failed()) {
+                    if (logger != nullptr)
+                        logger->error("An error occured while downloading {} from {}: {}.", _resourcePath, host, ec.message());
 
-                return std::nullopt;
+                    HostScoreboard::Default().RecordFailure(host);
+                    return std::nullopt;
+                }
+
+                _requestStart = std::chrono::steady_clock::now();
+
+                http::write(connection->Stream, MakeRequest(host), ec);
+                if (ec.failed()) {
+                    // Idle connections may have been closed by the server; retry on a new one.
+                    if (connection.reused())
+                        continue;
+
+                    if (logger != nullptr)
+                        logger->error("An error occured while downloading {} from {}: {}.", _resourcePath, host, ec.message());
+
+                    HostScoreboard::Default().RecordFailure(host);
+                    return std::nullopt;
+                }
+
+                bool stale = false;
+                std::optional<R> result = ReadResponse(connection, host, logger, stale);
+                if (stale)
+                    continue;
+
+                return result;
+            }
+        }
+
+        /**
+         * Executes this task asynchronously. Unlike @ref Run, no thread is blocked while the request is in flight; every
+         * network operation fails with a timeout if no progress is made for @ref ConnectionPool::Options::IoTimeout.
+         *
+         * The task must outlive the returned awaitable. It can be aborted with @ref Cancel.
+         *
+         * @param host     The remote host expected to supply the resource.
+         * @param logger   An (optional) logger.
+         *
+         * @returns An optional containing the parsed response or an empty optional if an error occured.
+         */
+        boost::asio::awaitable<std::optional<R>> RunAsync(std::string host, spdlog::logger* logger = nullptr) {
+            return RunAsync(ConnectionPool::Default(), std::move(host), logger);
+        }
+
+        /**
+         * Executes this task asynchronously, using connections from the given pool.
+         *
+         * @param pool   The pool connections are obtained from. Must outlive the returned awaitable.
+         * @param host   The remote host expected to supply the resource.
+         * @param logger An (optional) logger.
+         *
+         * @returns An optional containing the parsed response or an empty optional if an error occured.
+         */
+        boost::asio::awaitable<std::optional<R>> RunAsync(ConnectionPool& pool, std::string host, spdlog::logger* logger = nullptr) {
+            namespace http = boost::beast::http;
+
+            if (logger != nullptr)
+                logger->trace("Downloading '{}' from {}.", _resourcePath, host);
+
+            _cancelled = false;
+
+            for (;;) {
+                boost::beast::error_code ec;
+
+                ConnectionPool::Lease connection = co_await pool.AcquireAsync(host, "80", ec);
+                if (_cancelled)
+                    co_return std::nullopt;
+
+                if (ec.failed()) {
+                    if (logger != nullptr)
+                        logger->error("An error occured while downloading {} from {}: {}.", _resourcePath, host, ec.message());
+
+                    HostScoreboard::Default().RecordFailure(host);
+                    co_return std::nullopt;
+                }
+
+                // Exposes the connection to Cancel() for as long as the lease is held.
+                struct ActiveConnection {
+                    ConnectionPool::Connection*& Slot;
+
+                    ~ActiveConnection() { Slot = nullptr; }
+                } activeConnection { _connection };
+                _connection = &*connection;
+
+                http::request<http::empty_body> request = MakeRequest(host);
+
+                _requestStart = std::chrono::steady_clock::now();
+
+                connection->Stream.expires_after(pool.options().IoTimeout);
+                co_await http::async_write(connection->Stream, request, boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+                if (ec.failed()) {
+                    // Idle connections may have been closed by the server; retry on a new one.
+                    if (connection.reused() && ec != boost::beast::error::timeout && !_cancelled)
+                        continue;
+
+                    if (logger != nullptr && !_cancelled)
+                        logger->error("An error occured while downloading {} from {}: {}.", _resourcePath, host, ec.message());
+
+                    if (!_cancelled)
+                        HostScoreboard::Default().RecordFailure(host);
+                    co_return std::nullopt;
+                }
+
+                http::response_parser<Body> res;
+                if (!PrepareResponse(res, host, logger))
+                    co_return std::nullopt;
+
+                // The timeout is renewed after each read, so that it only fires if the server stops sending data.
+                while (!res.is_done()) {
+                    connection->Stream.expires_after(pool.options().IoTimeout);
+                    co_await http::async_read_some(connection->Stream, connection->Buffer, res, boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+                    if (ec.failed())
+                        break;
+
+                    if (_headerReceived < _requestStart && res.is_header_done())
+                        _headerReceived = std::chrono::steady_clock::now();
+                }
+
+                if (_cancelled)
+                    co_return std::nullopt;
+
+                bool stale = false;
+                std::optional<R> result = CompleteResponse(res, connection, ec, host, logger, stale);
+                if (stale)
+                    continue;
+
+                co_return result;
             }
+        }
+
+        /**
+         * Aborts this task if it is running asynchronously: pending network operations complete immediately and
+         * @ref RunAsync returns an empty optional. Must be called from the executor the task runs on.
+         */
+        void Cancel() {
+            _cancelled = true;
 
-            http::request<http::string_body> req { http::verb::get, _resourcePath, 11 };
+            if (_connection != nullptr)
+                _connection->Stream.cancel();
+        }
+
+        /**
+         * Executes several tasks against the same host, pipelining requests over pooled connections: up to
+         * @ref ConnectionPool::Options::MaxPipelineDepth requests are sent before their responses are read.
+         *
+         * @param tasks    The tasks to execute.
+         * @param executor An ASIO (Networking TS) executor.
+         * @param host     The remote host expected to supply the resources.
+         * @param logger   An (optional) logger.
+         *
+         * @returns The result of each task, in the same order as @p tasks.
+         */
+        static std::vector<std::optional<R>> RunPipelined(std::span<T> tasks,
+            boost::asio::any_io_executor const& executor,
+            std::string_view host,
+            spdlog::logger* logger = nullptr)
+        {
+            namespace http = boost::beast::http;
+
+            ConnectionPool& pool = ConnectionPool::Default();
+
+            std::vector<std::optional<R>> results(tasks.size());
+            for (std::size_t next = 0; next < tasks.size(); ) {
+                boost::beast::error_code ec;
+
+                ConnectionPool::Lease connection = pool.Acquire(executor, host, "80", ec);
+                if (ec.failed()) {
+                    if (logger != nullptr)
+                        logger->error("An error occured while connecting to {}: {}.", host, ec.message());
+
+                    break;
+                }
+
+                std::size_t batchEnd = std::min(tasks.size(), next + pool.options().MaxPipelineDepth);
+
+                std::size_t sent = next;
+                for (; sent < batchEnd; ++sent) {
+                    http::write(connection->Stream, tasks[sent].MakeRequest(host), ec);
+                    if (ec.failed())
+                        break;
+                }
+
+                // Responses come back in the order requests were sent. Stop at the first failure, or if the server closes
+                // the connection; tasks after that point are sent again on another connection.
+                std::size_t received = next;
+                bool keepAlive = true;
+                while (received < sent && keepAlive) {
+                    bool stale = false;
+                    results[received] = tasks[received].ReadResponse(connection, host, logger, stale, &keepAlive);
+                    if (stale)
+                        break;
+
+                    ++received;
+                }
+
+                if (received == next) {
+                    // No progress on this connection; fall back to a regular request so that we cannot loop forever.
+                    results[next] = tasks[next].Run(executor, host, logger);
+                    ++received;
+                }
+
+                next = received;
+            }
+
+            return results;
+        }
+
+    private:
+        boost::beast::http::request<boost::beast::http::empty_body> MakeRequest(std::string_view host) {
+            namespace http = boost::beast::http;
+
+            http::request<http::empty_body> req { http::verb::get, _resourcePath, 11 };
             req.set(http::field::host, host);
-            if (_offset != 0 && _size != 0)
-                req.set(http::field::range, fmt::format("{}-{}", _offset, _offset + _size - 1));
+            req.keep_alive(true);
+            if (_size != 0)
+                req.set(http::field::range, fmt::format("bytes={}-{}", _offset, _offset + _size - 1));
 
-            http::write(stream, req, ec);
-            if (ec.failed()) {
-                if (logger != nullptr)
-                    logger->error("An error occured while downloading {} from {}: {}.", _resourcePath, host, ec.message());
+            // Implementations may amend the request, e.g. to resume an interrupted download.
+            if constexpr (requires (T& task) { task.PrepareRequest(req); })
+                static_cast<T*>(this)->PrepareRequest(req);
 
+            return req;
+        }
+
+        /**
+         * Reads a response from a connection. If the response was read entirely and the server allows it, the connection
+         * is recycled.
+         *
+         * @param[out] stale     Set if the connection had been reused and failed before anything was received.
+         * @param[out] keepAlive Set to false if the connection can not be used for further requests.
+         */
+        std::optional<R> ReadResponse(ConnectionPool::Lease& connection, std::string_view host, spdlog::logger* logger,
+            bool& stale, bool* keepAlive = nullptr)
+        {
+            namespace http = boost::beast::http;
+
+            http::response_parser<Body> res;
+            if (!PrepareResponse(res, host, logger))
                 return std::nullopt;
+
+            boost::beast::error_code ec;
+            http::read_header(connection->Stream, connection->Buffer, res, ec);
+            if (!ec.failed()) {
+                _headerReceived = std::chrono::steady_clock::now();
+
+                http::read(connection->Stream, connection->Buffer, res, ec);
             }
 
-            http::response_parser<Body> res;
-            res.body_limit({ });
+            return CompleteResponse(res, connection, ec, host, logger, stale, keepAlive);
+        }
+
+        bool PrepareResponse(boost::beast::http::response_parser<Body>& res, std::string_view host, spdlog::logger* logger) {
+            // An empty limit is mishandled by older versions of Beast, which compare it against the content length.
+            res.body_limit(std::numeric_limits<std::uint64_t>::max());
 
-            ec = static_cast<T*>(this)->Initialize(res.get().body());
+            boost::beast::error_code ec = static_cast<T*>(this)->Initialize(res.get().body());
             if (ec.failed()) {
                 if (logger != nullptr)
                     logger->error("An error occured while downloading {} from {}: {}.", _resourcePath, host, ec.message());
 
+                return false;
+            }
+
+            return true;
+        }
+
+        std::optional<R> CompleteResponse(boost::beast::http::response_parser<Body>& res, ConnectionPool::Lease& connection,
+            boost::beast::error_code const& ec, std::string_view host, spdlog::logger* logger,
+            bool& stale, bool* keepAlive = nullptr)
+        {
+            namespace http = boost::beast::http;
+
+            if (ec.failed() && ec != boost::beast::error::timeout && connection.reused() && !res.got_some()) {
+                stale = true;
                 return std::nullopt;
             }
 
-            beast::flat_buffer buffer;
-            http::read(stream, buffer, res, ec);
-            if (ec.failed() || res.get().result() != http::status::ok) {
+            bool success = res.get().result() == http::status::ok || res.get().result() == http::status::partial_content;
+            if (ec.failed() || !success) {
                 if (logger != nullptr)
-                    logger->error("An error occured while downloading {} from {}: {}.", _resourcePath, host, ec.message());
+                    logger->error("An error occured while downloading {} from {}: {}.", _resourcePath, host, ec.failed() ? ec.message() : std::string { res.get().reason() });
             }
 
-            if (res.get().result() == http::status::ok) {
+            if (success) {
                 if (logger != nullptr)
                     logger->trace("Downloaded '{}' from {} ({} bytes)", host, _resourcePath, res.get()[http::field::content_length]);
             }
 
-            stream.socket().shutdown(boost::asio::ip::tcp::socket::shutdown_both);
+            // Pipelined requests are not timed; their responses wait behind the ones sent before them.
+            if (_requestStart != std::chrono::steady_clock::time_point { }) {
+                if (success && !ec.failed() && _headerReceived >= _requestStart) {
+                    HostScoreboard::Default().RecordSuccess(host, _headerReceived - _requestStart,
+                        std::chrono::steady_clock::now() - _headerReceived, res.content_length().value_or(0));
+                }
+                else {
+                    HostScoreboard::Default().RecordFailure(host);
+                }
+
+                _requestStart = { };
+            }
+
+            bool reusable = !ec.failed() && res.is_done() && res.keep_alive();
+            if (reusable) {
+                connection->Stream.expires_never();
+                connection.Recycle();
+            }
+            if (keepAlive != nullptr)
+                *keepAlive = reusable;
+
             return static_cast<T*>(this)->TransformMessage(res.get());
         }
 
@@ -140,5 +414,12 @@ namespace libtactmon::net {
         std::string _resourcePath;
         std::size_t _size = 0;
         std::size_t _offset = 0;
+
+    private:
+        std::chrono::steady_clock::time_point _requestStart;
+        std::chrono::steady_clock::time_point _headerReceived;
+
+        ConnectionPool::Connection* _connection = nullptr;
+        bool _cancelled = false;
     };
 }
@@ -1,28 +1,141 @@
+#include "libtactmon/net/DownloadProgress.hpp"
 #include "libtactmon/net/FileDownloadTask.hpp"
 #include "libtactmon/tact/Cache.hpp"
 
-#include <filesystem>
+#include <system_error>
+
+#include <fmt/format.h>
 
 namespace libtactmon::net {
+    std::filesystem::path FileDownloadTask::GetPartialPath() const {
+        std::filesystem::path partialPath = _localCache.GetAbsolutePath(_cachePath);
+        partialPath += ".part";
+        return partialPath;
+    }
+
+    std::filesystem::path FileDownloadTask::GetProgressPath() const {
+        std::filesystem::path progressPath = _localCache.GetAbsolutePath(_cachePath);
+        progressPath += ".progress";
+        return progressPath;
+    }
+
+    void FileDownloadTask::Discard() const {
+        std::error_code ec;
+        std::filesystem::remove(GetPartialPath(), ec);
+        std::filesystem::remove(GetProgressPath(), ec);
+    }
+
+    void FileDownloadTask::PrepareRequest(boost::beast::http::request<boost::beast::http::empty_body>& request) {
+        namespace http = boost::beast::http;
+
+        _resumeFrom = 0;
+        _validator.clear();
+
+        // Downloads of part of a resource, and observed downloads, are not resumed.
+        if (_size != 0 || _observer)
+            return;
+
+        std::optional<DownloadProgress> progress = DownloadProgress::Load(GetProgressPath());
+        if (!progress.has_value() || progress->Received == 0)
+            return;
+
+        std::error_code ec;
+        std::uintmax_t partialSize = std::filesystem::file_size(GetPartialPath(), ec);
+        if (ec || partialSize < progress->Received)
+            return;
+
+        _resumeFrom = progress->Received;
+        _validator = std::move(progress->Validator);
+
+        // Resources are content-addressed, so the partial file can be resumed even without a validator. If there is one
+        // and the resource changed anyway, If-Range makes the server send all of it again.
+        request.set(http::field::range, fmt::format("bytes={}-", _resumeFrom));
+        if (!_validator.empty())
+            request.set(http::field::if_range, _validator);
+    }
+
     boost::system::error_code FileDownloadTask::Initialize(ValueType& body) {
-        std::filesystem::path absolutePath { _localCache.GetAbsolutePath(_resourcePath) };
-        std::filesystem::create_directories(absolutePath.parent_path());
+        std::optional<std::uint64_t> resumeAt;
+        if (_resumeFrom != 0)
+            resumeAt = _resumeFrom;
+
+        if (!_writer.Open(_localCache.files(), GetPartialPath(), resumeAt))
+            return boost::system::errc::make_error_code(boost::system::errc::io_error);
 
-        boost::system::error_code ec;
-        body.open(absolutePath.string().data(), boost::beast::file_mode::write, ec);
-        return ec;
+        body.Writer = &_writer;
+        body.Offset = _resumeFrom;
+        body.Size = 0;
+        body.Complete = false;
+        body.Observer = _observer;
+        return { };
     }
 
     std::optional<io::FileStream> FileDownloadTask::TransformMessage(MessageType& message) {
-        message.body().close();
+        namespace http = boost::beast::http;
+
+        bool written = _writer.Close();
+
+        std::uint64_t start = 0;
+        if (message.result() == http::status::partial_content) {
+            std::uint64_t first = 0, last = 0, total = 0;
+            std::uint64_t expected = _size != 0 ? _offset : _resumeFrom;
+            if (!ParseContentRange(message[http::field::content_range], first, last, total) || first != expected) {
+                Discard();
+                return std::nullopt;
+            }
 
-        if (message.result() != boost::beast::http::status::ok) {
-            // Ideally we would prevent beast from writing to disk if http response is not 200 OK or some
-            // other 2xx code.
-            _localCache.Delete(_resourcePath);
+            start = first;
+
+            // The range requested covers everything up to the end of the resource, unless this is a partial download.
+            if (_size != 0 ? last - first + 1 != _size : last + 1 != total) {
+                Discard();
+                return std::nullopt;
+            }
+        }
+        else if (_size != 0) {
+            // The server ignored the range and is sending the entire resource, which must not be cached as this part.
+            Discard();
+            return std::nullopt;
+        }
+        else if (message.result() == http::status::range_not_satisfiable) {
+            // The progress record does not match the resource; start over next time.
+            Discard();
+            return std::nullopt;
+        }
+        else if (message.result() != http::status::ok) {
+            // Nothing was written; a previous partial download, if any, can still be resumed.
+            return std::nullopt;
+        }
+
+        if (!written) {
+            Discard();
             return std::nullopt;
         }
 
-        return _localCache.OpenWrite(_resourcePath);
+        if (!message.body().Complete) {
+            DownloadProgress progress;
+            progress.Received = start + message.body().Size;
+            progress.Validator = std::string { message[http::field::etag] };
+            if (progress.Validator.empty())
+                progress.Validator = std::string { message[http::field::last_modified] };
+
+            if (_size == 0 && progress.Received != 0)
+                progress.Save(GetProgressPath());
+            else
+                Discard();
+
+            return std::nullopt;
+        }
+
+        std::error_code ec;
+        std::filesystem::rename(GetPartialPath(), _localCache.GetAbsolutePath(_cachePath), ec);
+        if (ec) {
+            Discard();
+            return std::nullopt;
+        }
+
+        std::filesystem::remove(GetProgressPath(), ec);
+
+        return _localCache.OpenWrite(_cachePath);
     }
 }
@@ -1,13 +1,21 @@
 #pragma once
 
+#include "libtactmon/io/AsyncFileService.hpp"
 #include "libtactmon/io/FileStream.hpp"
 #include "libtactmon/net/DownloadTask.hpp"
+#include "libtactmon/net/RangeFileBody.hpp"
 
+#include <cstddef>
 #include <cstdint>
+#include <filesystem>
+#include <functional>
 #include <optional>
+#include <span>
+#include <string>
 #include <string_view>
 
-#include <boost/beast/http/file_body.hpp>
+#include <boost/beast/http/empty_body.hpp>
+#include <boost/beast/http/message.hpp>
 #include <boost/system/error_code.hpp>
 
 namespace libtactmon::tact {
@@ -16,21 +24,61 @@ namespace libtactmon::tact {
 
 namespace libtactmon::net {
     /**
-     * A download task for a file that writes the result to the disk.
+     * A download task for a file that writes the result to the disk. Writes are performed in the background by the
+     * cache's @ref io::AsyncFileService while the response is still being received.
+     *
+     * The response is written to a <tt>.part</tt> file next to its final location, which it replaces once complete. If the
+     * transfer is interrupted, the amount of bytes received is saved in a <tt>.progress</tt> record; the next task for the
+     * same resource (possibly against another host) resumes from there with a range request.
      */
-    struct FileDownloadTask final : DownloadTask<FileDownloadTask, boost::beast::http::file_body, io::FileStream> {
+    struct FileDownloadTask final : DownloadTask<FileDownloadTask, RangeFileBody, io::FileStream> {
         FileDownloadTask(std::string_view resourcePath, tact::Cache& localCache) noexcept
-            : DownloadTask(resourcePath), _localCache(localCache)
+            : DownloadTask(resourcePath), _localCache(localCache), _cachePath(resourcePath)
         { }
 
         FileDownloadTask(std::string_view resourcePath, std::size_t offset, std::size_t length, tact::Cache& localCache) noexcept
-            : DownloadTask(resourcePath, offset, length), _localCache(localCache)
+            : DownloadTask(resourcePath, offset, length), _localCache(localCache), _cachePath(resourcePath)
         { }
 
+        /**
+         * Downloads part of a resource, storing it in the cache under another path.
+         */
+        FileDownloadTask(std::string_view resourcePath, std::size_t offset, std::size_t length, tact::Cache& localCache, std::string_view cachePath) noexcept
+            : DownloadTask(resourcePath, offset, length), _localCache(localCache), _cachePath(cachePath)
+        { }
+
+        /**
+         * Hands the bytes of the response to a callable as they are received, in addition to writing them to the cache.
+         * Since the callable must see the entire response, an observed download is never resumed.
+         *
+         * @param[in] observer A callable receiving bytes in order. Returning false aborts the download.
+         */
+        void Observe(std::function<bool(std::span<const std::byte>)> observer) { _observer = std::move(observer); }
+
+        void PrepareRequest(boost::beast::http::request<boost::beast::http::empty_body>& request);
+
         boost::system::error_code Initialize(ValueType& body);
         std::optional<io::FileStream> TransformMessage(MessageType& body);
 
     private:
+        std::filesystem::path GetPartialPath() const;
+        std::filesystem::path GetProgressPath() const;
+
+        /**
+         * Deletes the partial file and its progress record.
+         */
+        void Discard() const;
+
         tact::Cache& _localCache;
+        std::string _cachePath;
+        io::AsyncFileService::Writer _writer;
+
+        //! Offset at which the response starts, if resuming an interrupted download.
+        std::uint64_t _resumeFrom = 0;
+
+        //! The ETag (or Last-Modified date) of the partial file, if resuming an interrupted download.
+        std::string _validator;
+
+        std::function<bool(std::span<const std::byte>)> _observer;
     };
 }
@@ -0,0 +1,130 @@
+#pragma once
+
+#include "libtactmon/net/ConnectionPool.hpp"
+#include "libtactmon/net/HostScoreboard.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <spdlog/logger.h>
+
+namespace libtactmon::net {
+    /**
+     * Executes a download task against the first of a list of hosts. If no response arrived once the host's hedge delay
+     * (see @ref HostScoreboard::HedgeDelay) has elapsed, a duplicate request is sent to the next host; the first successful
+     * response wins and the other request is cancelled. If a request fails, the next host is tried immediately.
+     *
+     * Both requests may run at the same time: tasks must not write to a destination that the other task truncates.
+     *
+     * This coroutine and the tasks it spawns must run on a strand (or on a single-threaded context).
+     *
+     * @param makeTask A callable returning a new download task for the resource.
+     * @param hosts    The hosts able to supply the resource, best first (see @ref HostScoreboard::Rank).
+     * @param pool     The pool connections are obtained from. Must outlive every spawned task, including cancelled ones.
+     * @param logger   An (optional) logger.
+     *
+     * @returns The result of the first successful task, or an empty optional if every host failed.
+     */
+    template <typename Factory>
+    auto RunHedged(Factory makeTask, std::vector<std::string> hosts, ConnectionPool& pool, spdlog::logger* logger = nullptr)
+        -> boost::asio::awaitable<typename std::invoke_result_t<Factory&>::ResultType>
+    {
+        using TaskType = std::invoke_result_t<Factory&>;
+
+        struct Contender {
+            TaskType Task;
+            typename TaskType::ResultType Result;
+            bool Done = false;
+        };
+
+        boost::asio::any_io_executor executor = co_await boost::asio::this_coro::executor;
+
+        // Cancelled whenever a contender completes, to wake this coroutine up.
+        auto event = std::make_shared<boost::asio::steady_timer>(executor);
+
+        auto start = [&](std::string const& host) {
+            auto contender = std::shared_ptr<Contender>(new Contender { makeTask() });
+
+            boost::asio::co_spawn(executor, [contender, event, &pool, host, logger]() -> boost::asio::awaitable<void> {
+                contender->Result = co_await contender->Task.RunAsync(pool, host, logger);
+                contender->Done = true;
+
+                event->cancel();
+            }, boost::asio::detached);
+
+            return contender;
+        };
+
+        std::vector<std::shared_ptr<Contender>> running;
+        std::size_t next = 0;
+        bool hedged = false;
+
+        auto hedgeAt = std::chrono::steady_clock::time_point::max();
+        if (!hosts.empty()) {
+            hedgeAt = std::chrono::steady_clock::now() + HostScoreboard::Default().HedgeDelay(hosts[next]);
+            running.push_back(start(hosts[next++]));
+        }
+
+        while (!running.empty()) {
+            for (auto itr = running.begin(); itr != running.end(); ) {
+                if (!(*itr)->Done) {
+                    ++itr;
+                    continue;
+                }
+
+                if ((*itr)->Result.has_value()) {
+                    for (std::shared_ptr<Contender> const& other : running) {
+                        if (other != *itr)
+                            other->Task.Cancel();
+                    }
+
+                    co_return std::move((*itr)->Result);
+                }
+
+                itr = running.erase(itr);
+            }
+
+            // Fail over to the next host as soon as every pending request failed.
+            if (running.empty() && next < hosts.size()) {
+                hedgeAt = std::chrono::steady_clock::now() + HostScoreboard::Default().HedgeDelay(hosts[next]);
+                running.push_back(start(hosts[next++]));
+            }
+
+            if (running.empty())
+                break;
+
+            bool canHedge = !hedged && running.size() == 1 && next < hosts.size();
+            if (canHedge && std::chrono::steady_clock::now() >= hedgeAt) {
+                if (logger != nullptr)
+                    logger->debug("Sending a hedged request to {}.", hosts[next]);
+
+                hedged = true;
+                running.push_back(start(hosts[next++]));
+                continue;
+            }
+
+            boost::system::error_code ec;
+            if (canHedge)
+                event->expires_at(hedgeAt);
+            else
+                event->expires_at(std::chrono::steady_clock::time_point::max());
+
+            co_await event->async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+        }
+
+        co_return std::nullopt;
+    }
+}
@@ -0,0 +1,100 @@
+#include "libtactmon/net/HostOverrides.hpp"
+#include "libtactmon/detail/Tokenizer.hpp"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+
+namespace libtactmon::net {
+    namespace {
+        /**
+         * Splits "host[:service]". IPv6 addresses must be bracketed.
+         */
+        std::optional<Endpoint> ParseEndpoint(std::string_view value) {
+            std::string_view host = value;
+            std::string_view service;
+
+            if (value.starts_with('[')) {
+                std::size_t end = value.find(']');
+                if (end == std::string_view::npos)
+                    return std::nullopt;
+
+                host = value.substr(1, end - 1);
+                value.remove_prefix(end + 1);
+                if (!value.empty() && !value.starts_with(':'))
+                    return std::nullopt;
+
+                service = value.substr(std::min<std::size_t>(1, value.size()));
+            }
+            else if (std::size_t colon = value.rfind(':'); colon != std::string_view::npos) {
+                host = value.substr(0, colon);
+                service = value.substr(colon + 1);
+            }
+
+            if (host.empty())
+                return std::nullopt;
+
+            return Endpoint { std::string { host }, std::string { service } };
+        }
+    }
+
+    /* static */ HostOverrides& HostOverrides::Default() {
+        static HostOverrides instance;
+        return instance;
+    }
+
+    void HostOverrides::Add(std::string_view host, std::string_view service, Endpoint target) {
+        std::lock_guard<std::mutex> guard { _lock };
+        _rules.push_back(Rule { std::string { host }, std::string { service }, std::move(target) });
+    }
+
+    bool HostOverrides::Parse(std::string_view rules) {
+        std::vector<Rule> parsed;
+
+        for (std::string_view rule : detail::Split(rules, ',', true)) {
+            std::size_t separator = rule.find('=');
+            if (separator == std::string_view::npos)
+                return false;
+
+            std::optional<Endpoint> source = ParseEndpoint(rule.substr(0, separator));
+            std::optional<Endpoint> target = ParseEndpoint(rule.substr(separator + 1));
+            if (!source.has_value() || !target.has_value())
+                return false;
+
+            if (source->Service.empty())
+                source->Service.assign(1, '*');
+
+            parsed.push_back(Rule { std::move(source->Host), std::move(source->Service), std::move(*target) });
+        }
+
+        std::lock_guard<std::mutex> guard { _lock };
+        for (Rule& rule : parsed)
+            _rules.push_back(std::move(rule));
+
+        return true;
+    }
+
+    void HostOverrides::Clear() {
+        std::lock_guard<std::mutex> guard { _lock };
+        _rules.clear();
+    }
+
+    Endpoint HostOverrides::Resolve(std::string_view host, std::string_view service) const {
+        std::lock_guard<std::mutex> guard { _lock };
+
+        for (Rule const& rule : _rules) {
+            if (rule.Host != "*" && rule.Host != host)
+                continue;
+
+            if (rule.Service != "*" && rule.Service != service)
+                continue;
+
+            return Endpoint {
+                rule.Target.Host,
+                rule.Target.Service.empty() ? std::string { service } : rule.Target.Service
+            };
+        }
+
+        return Endpoint { std::string { host }, std::string { service } };
+    }
+}
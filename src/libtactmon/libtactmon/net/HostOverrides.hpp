@@ -0,0 +1,71 @@
+#pragma once
+
+#include "libtactmon/detail/Export.hpp"
+
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace libtactmon::net {
+    /**
+     * A remote host and service (port), as given to a resolver.
+     */
+    struct Endpoint {
+        std::string Host;
+        std::string Service;
+    };
+
+    /**
+     * Redirects connections to Blizzard services elsewhere, typically to a local mirror or to a test server such as
+     * @c tactmon-fakecdn. Every connection made by the library (Ribbit, CDN downloads) resolves its endpoint through the
+     * process-wide instance.
+     *
+     * Only name resolution is affected: requests still carry the original host name.
+     */
+    struct LIBTACTMON_API HostOverrides final {
+        HostOverrides() = default;
+
+        HostOverrides(HostOverrides const&) = delete;
+        HostOverrides& operator = (HostOverrides const&) = delete;
+
+        /**
+         * Returns the process-wide instance.
+         */
+        static HostOverrides& Default();
+
+        /**
+         * Adds an override. Overrides are tried in the order they were added; the first match wins.
+         *
+         * @param[in] host    The host to redirect, or @c "*" to match any host.
+         * @param[in] service The service (port) to redirect, or @c "*" to match any service.
+         * @param[in] target  Where connections are redirected to. An empty service keeps the original one.
+         */
+        void Add(std::string_view host, std::string_view service, Endpoint target);
+
+        /**
+         * Adds overrides from a comma-separated list of @c "host:service=target[:service]" rules, such as
+         * @c "*:1119=127.0.0.1:11119,*:80=127.0.0.1:8080".
+         *
+         * @returns false if a rule is malformed, in which case no override is added.
+         */
+        bool Parse(std::string_view rules);
+
+        void Clear();
+
+        /**
+         * Returns the endpoint a connection to @p host and @p service should be made to.
+         */
+        [[nodiscard]] Endpoint Resolve(std::string_view host, std::string_view service) const;
+
+    private:
+        struct Rule {
+            std::string Host;
+            std::string Service;
+            Endpoint Target;
+        };
+
+        mutable std::mutex _lock;
+        std::vector<Rule> _rules;
+    };
+}
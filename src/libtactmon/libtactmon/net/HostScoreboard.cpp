@@ -0,0 +1,132 @@
+#include "libtactmon/net/HostScoreboard.hpp"
+
+#include <algorithm>
+
+namespace libtactmon::net {
+    HostScoreboard::HostScoreboard() : HostScoreboard(Options { }) { }
+
+    HostScoreboard::HostScoreboard(Options options) : _options(options) {
+        _options.Smoothing = std::clamp(_options.Smoothing, 0.01, 1.0);
+        _options.LatencyWindow = std::max<std::size_t>(1, _options.LatencyWindow);
+    }
+
+    /* static */ HostScoreboard& HostScoreboard::Default() {
+        static HostScoreboard instance;
+        return instance;
+    }
+
+    void HostScoreboard::RecordSuccess(std::string_view host, std::chrono::steady_clock::duration latency,
+        std::chrono::steady_clock::duration transfer, std::uint64_t size)
+    {
+        double latencySeconds = std::chrono::duration<double>(latency).count();
+        double transferSeconds = std::chrono::duration<double>(transfer).count();
+
+        std::lock_guard<std::mutex> guard { _lock };
+        Host& state = _hosts[std::string { host }];
+
+        // Each average is seeded by its first sample; failures recorded beforehand measured neither latency nor throughput.
+        auto update = [&](double& average, double sample, std::size_t& samples) {
+            average = samples == 0 ? sample : average + _options.Smoothing * (sample - average);
+            ++samples;
+        };
+
+        update(state.Averages.Latency, latencySeconds, state.Averages.LatencySamples);
+
+        update(state.Averages.ErrorRate, 0.0, state.Averages.Samples);
+
+        // Bodies too small to be measured accurately say nothing about the transfer rate.
+        if (size != 0 && transferSeconds > 0.0)
+            update(state.Averages.Throughput, static_cast<double>(size) / transferSeconds, state.Averages.ThroughputSamples);
+
+        if (state.Latencies.size() < _options.LatencyWindow)
+            state.Latencies.push_back(latency);
+        else
+            state.Latencies[state.NextLatency] = latency;
+
+        state.NextLatency = (state.NextLatency + 1) % _options.LatencyWindow;
+    }
+
+    void HostScoreboard::RecordFailure(std::string_view host) {
+        std::lock_guard<std::mutex> guard { _lock };
+        Host& state = _hosts[std::string { host }];
+
+        state.Averages.ErrorRate = state.Averages.Samples == 0
+            ? 1.0
+            : state.Averages.ErrorRate + _options.Smoothing * (1.0 - state.Averages.ErrorRate);
+
+        ++state.Averages.Samples;
+    }
+
+    std::optional<HostScoreboard::Statistics> HostScoreboard::statistics(std::string_view host) const {
+        std::lock_guard<std::mutex> guard { _lock };
+
+        auto itr = _hosts.find(std::string { host });
+        if (itr == _hosts.end())
+            return std::nullopt;
+
+        return itr->second.Averages;
+    }
+
+    double HostScoreboard::Score(std::string_view host) const {
+        std::lock_guard<std::mutex> guard { _lock };
+        return ScoreUnlocked(host);
+    }
+
+    double HostScoreboard::ScoreUnlocked(std::string_view host) const {
+        auto itr = _hosts.find(std::string { host });
+        if (itr == _hosts.end())
+            return 0.0;
+
+        Statistics const& averages = itr->second.Averages;
+
+        double cost = averages.Latency;
+        if (averages.Throughput > 0.0)
+            cost += static_cast<double>(_options.ReferenceSize) / averages.Throughput;
+
+        // A request that fails has to be sent again; a host that always fails is as bad as it gets.
+        double successRate = 1.0 - std::min(averages.ErrorRate, 0.99);
+        return std::max(cost, 1e-3) / successRate;
+    }
+
+    std::vector<std::string> HostScoreboard::Rank(std::span<const std::string> hosts) const {
+        std::vector<std::pair<double, std::string>> scored;
+        scored.reserve(hosts.size());
+
+        {
+            std::lock_guard<std::mutex> guard { _lock };
+            for (std::string const& host : hosts)
+                scored.emplace_back(ScoreUnlocked(host), host);
+        }
+
+        std::stable_sort(scored.begin(), scored.end(), [](auto const& left, auto const& right) {
+            return left.first < right.first;
+        });
+
+        std::vector<std::string> ranked;
+        ranked.reserve(scored.size());
+        for (auto&& [score, host] : scored)
+            ranked.push_back(std::move(host));
+
+        return ranked;
+    }
+
+    std::chrono::steady_clock::duration HostScoreboard::HedgeDelay(std::string_view host) const {
+        std::vector<std::chrono::steady_clock::duration> latencies;
+
+        {
+            std::lock_guard<std::mutex> guard { _lock };
+
+            auto itr = _hosts.find(std::string { host });
+            if (itr != _hosts.end())
+                latencies = itr->second.Latencies;
+        }
+
+        // Too few samples for a meaningful percentile.
+        if (latencies.size() < 8)
+            return _options.DefaultHedgeDelay;
+
+        auto percentile = latencies.begin() + (latencies.size() * 95) / 100;
+        std::nth_element(latencies.begin(), percentile, latencies.end());
+        return std::max(*percentile, _options.MinimumHedgeDelay);
+    }
+}
@@ -0,0 +1,128 @@
+#pragma once
+
+#include "libtactmon/detail/Export.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace libtactmon::net {
+    /**
+     * Keeps track of how well remote hosts perform, so that requests go to the fastest and most reliable ones first.
+     *
+     * For every host, exponentially weighted moving averages of the time to first byte, of the transfer rate and of the
+     * error rate are maintained, along with a window of recent latencies used to estimate when a request is late enough
+     * to be worth duplicating on another host.
+     */
+    struct LIBTACTMON_API HostScoreboard final {
+        struct Options {
+            //! Weight of a new sample in the moving averages.
+            double Smoothing = 0.2;
+
+            //! Amount of recent latencies kept per host to compute percentiles.
+            std::size_t LatencyWindow = 64;
+
+            //! Hedge delay used until enough latencies were observed for a host.
+            std::chrono::steady_clock::duration DefaultHedgeDelay = std::chrono::milliseconds { 500 };
+
+            //! Lower bound of the hedge delay.
+            std::chrono::steady_clock::duration MinimumHedgeDelay = std::chrono::milliseconds { 20 };
+
+            //! Size of the typical request used to weigh latency against transfer rate when scoring.
+            std::uint64_t ReferenceSize = 1024 * 1024;
+        };
+
+        struct Statistics {
+            //! Average time between sending a request and receiving the response's header, in seconds.
+            double Latency = 0.0;
+
+            //! Average transfer rate of response bodies, in bytes per second.
+            double Throughput = 0.0;
+
+            //! Average ratio of failed requests.
+            double ErrorRate = 0.0;
+
+            //! Amount of requests recorded, successful or not.
+            std::size_t Samples = 0;
+
+            //! Amount of successful requests, which contribute to @ref Latency.
+            std::size_t LatencySamples = 0;
+
+            //! Amount of response bodies that contribute to @ref Throughput.
+            std::size_t ThroughputSamples = 0;
+        };
+
+        HostScoreboard();
+        explicit HostScoreboard(Options options);
+
+        HostScoreboard(HostScoreboard const&) = delete;
+        HostScoreboard& operator = (HostScoreboard const&) = delete;
+
+        /**
+         * Returns the scoreboard fed by download tasks.
+         */
+        static HostScoreboard& Default();
+
+        [[nodiscard]] Options const& options() const { return _options; }
+
+        /**
+         * Records a successful request.
+         *
+         * @param[in] host     The remote host.
+         * @param[in] latency  Time elapsed between sending the request and receiving the response's header.
+         * @param[in] transfer Time spent receiving the response's body.
+         * @param[in] size     Size of the response's body.
+         */
+        void RecordSuccess(std::string_view host, std::chrono::steady_clock::duration latency,
+            std::chrono::steady_clock::duration transfer, std::uint64_t size);
+
+        /**
+         * Records a failed request (connection error, timeout or unexpected response).
+         */
+        void RecordFailure(std::string_view host);
+
+        /**
+         * Returns the statistics of a host, or an empty optional if no request to it was recorded.
+         */
+        [[nodiscard]] std::optional<Statistics> statistics(std::string_view host) const;
+
+        /**
+         * Estimates the cost, in seconds, of a typical request to a host; lower is better. Hosts that were never used
+         * score zero, so that they are tried and measured.
+         */
+        [[nodiscard]] double Score(std::string_view host) const;
+
+        /**
+         * Orders hosts from best to worst score. Hosts with equal scores keep their relative order.
+         */
+        [[nodiscard]] std::vector<std::string> Rank(std::span<const std::string> hosts) const;
+
+        /**
+         * Returns how long to wait for a response from a host before sending a duplicate request elsewhere; this is the
+         * 95th percentile of recent latencies.
+         */
+        [[nodiscard]] std::chrono::steady_clock::duration HedgeDelay(std::string_view host) const;
+
+    private:
+        struct Host {
+            Statistics Averages;
+
+            std::vector<std::chrono::steady_clock::duration> Latencies;
+            std::size_t NextLatency = 0;
+        };
+
+        double ScoreUnlocked(std::string_view host) const;
+
+        Options _options;
+
+        mutable std::mutex _lock;
+        std::unordered_map<std::string, Host> _hosts;
+    };
+}
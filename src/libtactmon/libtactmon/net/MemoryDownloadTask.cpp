@@ -5,10 +5,10 @@ namespace libtactmon::net {
         return { };
     }
 
-    std::optional<io::GrowableMemoryStream> MemoryDownloadTask::TransformMessage(MessageType& message) {
-        if (message.result() != boost::beast::http::status::ok)
+    std::optional<io::PagedMemoryStream> MemoryDownloadTask::TransformMessage(MessageType& message) {
+        if (message.result() != boost::beast::http::status::ok && message.result() != boost::beast::http::status::partial_content)
             return std::nullopt;
 
-        return io::GrowableMemoryStream { message.body().data() };
+        return std::move(message.body());
     }
 }
@@ -1,21 +1,21 @@
 #pragma once
 
-#include "libtactmon/io/MemoryStream.hpp"
+#include "libtactmon/io/PagedMemoryStream.hpp"
 #include "libtactmon/net/DownloadTask.hpp"
+#include "libtactmon/net/PagedBody.hpp"
 
 #include <optional>
 
-#include <boost/beast/http/dynamic_body.hpp>
 #include <boost/system/error_code.hpp>
 
 namespace libtactmon::net {
     /**
      * A download task that loads a resource to system memory.
      */
-    struct MemoryDownloadTask : DownloadTask<MemoryDownloadTask, boost::beast::http::dynamic_body, io::GrowableMemoryStream> {
+    struct MemoryDownloadTask : DownloadTask<MemoryDownloadTask, PagedBody, io::PagedMemoryStream> {
         using DownloadTask::DownloadTask;
 
         boost::system::error_code Initialize(ValueType& body);
-        std::optional<io::GrowableMemoryStream> TransformMessage(MessageType& body);
+        std::optional<io::PagedMemoryStream> TransformMessage(MessageType& body);
     };
 }
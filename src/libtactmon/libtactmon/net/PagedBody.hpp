@@ -0,0 +1,51 @@
+#pragma once
+
+#include "libtactmon/io/PagedMemoryStream.hpp"
+
+#include <cstdint>
+#include <span>
+
+#include <boost/asio/buffer.hpp>
+#include <boost/beast/core/buffers_range.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/optional.hpp>
+#include <boost/system/error_code.hpp>
+
+namespace libtactmon::net {
+    /**
+     * A Boost.Beast body that stores a response in an @ref io::PagedMemoryStream. Incoming buffers are copied straight
+     * into pooled pages, so large responses never cause reallocations.
+     */
+    struct PagedBody {
+        using value_type = io::PagedMemoryStream;
+
+        static std::uint64_t size(value_type const& body) { return body.GetLength(); }
+
+        struct reader {
+            template <bool IsRequest, typename Fields>
+            reader(boost::beast::http::header<IsRequest, Fields>& header, value_type& body) : _body(body) { }
+
+            void init(boost::optional<std::uint64_t> const& contentLength, boost::system::error_code& ec) {
+                ec = { };
+            }
+
+            template <typename ConstBufferSequence>
+            std::size_t put(ConstBufferSequence const& buffers, boost::system::error_code& ec) {
+                ec = { };
+
+                std::size_t bytesWritten = 0;
+                for (auto const buffer : boost::beast::buffers_range_ref(buffers))
+                    bytesWritten += _body.Write(std::span { static_cast<const std::byte*>(buffer.data()), buffer.size() });
+
+                return bytesWritten;
+            }
+
+            void finish(boost::system::error_code& ec) {
+                ec = { };
+            }
+
+        private:
+            value_type& _body;
+        };
+    };
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include "libtactmon/io/AsyncFileService.hpp"
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string_view>
+#include <system_error>
+
+#include <boost/beast/core/buffers_range.hpp>
+#include <boost/beast/http/message.hpp>
+#include <boost/optional.hpp>
+#include <boost/system/error_code.hpp>
+
+namespace libtactmon::net {
+    /**
+     * A Boost.Beast body that writes a response at a given position of a file, through an
+     * @ref io::AsyncFileService::Writer. Bodies of unsuccessful responses are discarded; if the server ignored the range
+     * that was requested and sent the entire resource, it is written at the start of the file instead.
+     */
+    struct RangeFileBody {
+        struct value_type {
+            io::AsyncFileService::Writer* Writer = nullptr;
+
+            //! Offset in the file of the first byte of the response.
+            std::uint64_t Offset = 0;
+
+            //! Amount of bytes written so far.
+            std::uint64_t Size = 0;
+
+            //! Set once the entire body was received.
+            bool Complete = false;
+
+            //! If set, receives every byte written, in order. Returning false aborts the transfer.
+            std::function<bool(std::span<const std::byte>)> Observer;
+        };
+
+        static std::uint64_t size(value_type const& body) { return body.Size; }
+
+        struct reader {
+            template <bool IsRequest, typename Fields>
+            reader(boost::beast::http::header<IsRequest, Fields>& header, value_type& body) : _body(body) {
+                if constexpr (!IsRequest) {
+                    _discard = header.result() != boost::beast::http::status::ok && header.result() != boost::beast::http::status::partial_content;
+
+                    if (header.result() == boost::beast::http::status::ok)
+                        _body.Offset = 0;
+                }
+            }
+
+            void init(boost::optional<std::uint64_t> const& contentLength, boost::system::error_code& ec) {
+                ec = { };
+            }
+
+            template <typename ConstBufferSequence>
+            std::size_t put(ConstBufferSequence const& buffers, boost::system::error_code& ec) {
+                ec = { };
+
+                std::size_t bytesWritten = 0;
+                for (auto const buffer : boost::beast::buffers_range_ref(buffers)) {
+                    std::span<const std::byte> data { static_cast<const std::byte*>(buffer.data()), buffer.size() };
+
+                    if (!_discard && !_body.Writer->WriteAt(_body.Offset + _body.Size, data)) {
+                        ec = boost::system::errc::make_error_code(boost::system::errc::io_error);
+                        return bytesWritten;
+                    }
+
+                    if (!_discard && _body.Observer && !_body.Observer(data)) {
+                        ec = boost::system::errc::make_error_code(boost::system::errc::operation_canceled);
+                        return bytesWritten;
+                    }
+
+                    _body.Size += buffer.size();
+                    bytesWritten += buffer.size();
+                }
+
+                return bytesWritten;
+            }
+
+            void finish(boost::system::error_code& ec) {
+                ec = { };
+
+                _body.Complete = !_discard;
+            }
+
+        private:
+            value_type& _body;
+            bool _discard = false;
+        };
+    };
+
+    /**
+     * Parses the value of a Content-Range header (<tt>bytes first-last/total</tt>).
+     *
+     * @returns false if the value is malformed.
+     */
+    inline bool ParseContentRange(std::string_view value, std::uint64_t& first, std::uint64_t& last, std::uint64_t& total) {
+        using namespace std::string_view_literals;
+
+        if (!value.starts_with("bytes "sv))
+            return false;
+
+        char const* cursor = value.data() + 6;
+        char const* end = value.data() + value.size();
+
+        auto parse = [&](std::uint64_t& field, char delimiter) {
+            auto [ptr, ec] = std::from_chars(cursor, end, field);
+            if (ec != std::errc { } || (delimiter != '\0' && (ptr == end || *ptr != delimiter)))
+                return false;
+
+            cursor = ptr + (delimiter != '\0' ? 1 : 0);
+            return true;
+        };
+
+        return parse(first, '-') && parse(last, '/') && parse(total, '\0') && cursor == end && first <= last && last < total;
+    }
+}
@@ -0,0 +1,247 @@
+#include "libtactmon/net/SegmentedDownload.hpp"
+#include "libtactmon/net/ConnectionPool.hpp"
+#include "libtactmon/net/DownloadProgress.hpp"
+#include "libtactmon/net/HedgedRequest.hpp"
+#include "libtactmon/net/HostScoreboard.hpp"
+#include "libtactmon/tact/Cache.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+namespace libtactmon::net {
+    boost::system::error_code RangeDownloadTask::Initialize(ValueType& body) {
+        body.Writer = &_writer;
+        body.Offset = _offset;
+        body.Size = 0;
+        body.Complete = false;
+        return { };
+    }
+
+    std::optional<RangeDownloadResult> RangeDownloadTask::TransformMessage(MessageType& message) {
+        namespace http = boost::beast::http;
+
+        // Responses are handed over even if the transfer failed partway through.
+        if (!message.body().Complete)
+            return std::nullopt;
+
+        std::uint64_t received = message.body().Size;
+
+        if (message.result() == http::status::ok) {
+            // The server ignored the range and sent the whole resource, which was written at the start of the file. That is
+            // only what was asked for if this is the first range.
+            if (_offset != 0)
+                return std::nullopt;
+
+            if (message.has_content_length()) {
+                std::string_view contentLength = message[http::field::content_length];
+                std::uint64_t expected = 0;
+                auto [ptr, ec] = std::from_chars(contentLength.data(), contentLength.data() + contentLength.size(), expected);
+                if (ec != std::errc { } || ptr != contentLength.data() + contentLength.size() || received != expected)
+                    return std::nullopt;
+            }
+
+            return RangeDownloadResult { received, received };
+        }
+
+        if (message.result() != http::status::partial_content)
+            return std::nullopt;
+
+        std::uint64_t first = 0, last = 0, total = 0;
+        if (!ParseContentRange(message[http::field::content_range], first, last, total))
+            return std::nullopt;
+
+        if (first != _offset || last - first + 1 != received)
+            return std::nullopt;
+
+        return RangeDownloadResult { total, received };
+    }
+
+    // ^^^ RangeDownloadTask / SegmentedDownload vvv
+
+    SegmentedDownload::SegmentedDownload(std::string_view resourcePath, tact::Cache& localCache)
+        : SegmentedDownload(resourcePath, localCache, Options { })
+    { }
+
+    SegmentedDownload::SegmentedDownload(std::string_view resourcePath, tact::Cache& localCache, Options options)
+        : _resourcePath(resourcePath), _localCache(localCache), _options(options)
+    {
+        _options.SegmentSize = std::max<std::uint64_t>(1, _options.SegmentSize);
+        _options.Concurrency = std::max<std::size_t>(1, _options.Concurrency);
+        _options.MaxAttempts = std::max<std::size_t>(1, _options.MaxAttempts);
+    }
+
+    std::optional<io::FileStream> SegmentedDownload::Run(boost::asio::any_io_executor const& executor, std::span<const std::string> candidates,
+        spdlog::logger* logger)
+    {
+        if (candidates.empty())
+            return std::nullopt;
+
+        std::vector<std::string> hosts = HostScoreboard::Default().Rank(candidates);
+
+        // Ranges are assembled in a partial file that replaces the final one once complete, so that an incomplete file
+        // never appears in the cache. The ranges received are recorded next to it if the download is abandoned, in the same
+        // record @ref FileDownloadTask uses; either kind of download resumes what the other left.
+        std::filesystem::path partialPath = _localCache.GetAbsolutePath(_resourcePath);
+        partialPath += ".part";
+
+        std::filesystem::path progressPath = _localCache.GetAbsolutePath(_resourcePath);
+        progressPath += ".progress";
+
+        std::optional<DownloadProgress> progress = DownloadProgress::Load(progressPath);
+        std::optional<std::uint64_t> resumeAt;
+        if (progress.has_value()) {
+            // Segmented downloads preallocate the partial file, so it must be exactly as large as the resource.
+            std::error_code ec;
+            std::uintmax_t partialSize = std::filesystem::file_size(partialPath, ec);
+            if (!ec && partialSize >= progress->Received && (progress->TotalSize == 0 || partialSize == progress->TotalSize))
+                resumeAt = partialSize;
+            else
+                progress.reset();
+        }
+
+        if (!progress.has_value())
+            progress.emplace();
+
+        io::AsyncFileService::Writer writer;
+        if (!writer.Open(_localCache.files(), partialPath, resumeAt)) {
+            if (logger != nullptr)
+                logger->error("Unable to create '{}' in the local cache.", _resourcePath);
+
+            return std::nullopt;
+        }
+
+        auto abandon = [&]() -> std::optional<io::FileStream> {
+            std::error_code ec;
+            if (writer.Close() && (progress->Received != 0 || !progress->Ranges.empty()))
+                progress->Save(progressPath);
+            else {
+                std::filesystem::remove(partialPath, ec);
+                std::filesystem::remove(progressPath, ec);
+            }
+
+            return std::nullopt;
+        };
+
+        if (resumeAt.has_value() && logger != nullptr)
+            logger->trace("Resuming the download of '{}' ({} bytes already received).", _resourcePath, progress->Received);
+
+        // Unless a previous download recorded it, the first range tells us how large the resource is. It goes through the
+        // shared connection pool, so that small files cost a single request on an already established connection.
+        if (progress->TotalSize == 0) {
+            std::uint64_t headOffset = progress->Received;
+
+            std::optional<RangeDownloadResult> head;
+            if (_options.Hedge && hosts.size() > 1) {
+                // Both requests write the same bytes at the same position, so they can share the file. They run on a
+                // private context, for the same reasons as the remaining ranges below.
+                boost::asio::io_context context;
+                ConnectionPool pool { ConnectionPool::Options { .MaxConnectionsPerHost = 1 } };
+
+                boost::asio::co_spawn(context, [&]() -> boost::asio::awaitable<void> {
+                    head = co_await RunHedged([&]() { return RangeDownloadTask { _resourcePath, headOffset, _options.SegmentSize, writer }; }, hosts, pool, logger);
+                }, boost::asio::detached);
+
+                context.run();
+            }
+
+            for (std::size_t attempt = 0; attempt < _options.MaxAttempts * hosts.size() && !head.has_value(); ++attempt) {
+                RangeDownloadTask task { _resourcePath, headOffset, _options.SegmentSize, writer };
+                head = task.Run(executor, hosts[attempt % hosts.size()], logger);
+            }
+
+            if (!head.has_value())
+                return abandon();
+
+            progress->TotalSize = head->TotalSize;
+            progress->Add(headOffset, head->Size);
+        }
+
+        struct Segment {
+            std::uint64_t Offset;
+            std::uint64_t Length;
+        };
+
+        std::vector<Segment> segments;
+        for (DownloadProgress::Range const& missing : progress->Missing())
+            for (std::uint64_t offset = missing.Offset; offset < missing.Offset + missing.Length; offset += _options.SegmentSize)
+                segments.push_back(Segment { offset, std::min(_options.SegmentSize, missing.Offset + missing.Length - offset) });
+
+        if (!segments.empty()) {
+            if (!writer.Preallocate(progress->TotalSize))
+                return abandon();
+
+            if (logger != nullptr)
+                logger->trace("Downloading '{}' ({} bytes) as {} additional ranges.", _resourcePath, progress->TotalSize, segments.size());
+
+            // Remaining ranges are driven by this thread on a private context, so that waiting for them never occupies
+            // the threads of the caller's executor. Connections are pooled privately as they are bound to that context;
+            // the pool is declared after the context so that it is destroyed first.
+            boost::asio::io_context context;
+            ConnectionPool pool { ConnectionPool::Options { .MaxConnectionsPerHost = _options.Concurrency } };
+
+            std::size_t next = 0;
+            bool failed = false;
+
+            std::size_t workerCount = std::min(_options.Concurrency * hosts.size(), segments.size());
+            for (std::size_t worker = 0; worker < workerCount; ++worker) {
+                boost::asio::co_spawn(context, [&]() -> boost::asio::awaitable<void> {
+                    while (!failed && next < segments.size()) {
+                        std::size_t index = next++;
+                        Segment const& segment = segments[index];
+
+                        bool received = false;
+                        for (std::size_t attempt = 0; attempt < _options.MaxAttempts && !received && !failed; ++attempt) {
+                            // Spread ranges across hosts that currently work; retries move on to the next one.
+                            std::vector<std::string> healthy;
+                            for (std::string const& host : hosts) {
+                                std::optional<HostScoreboard::Statistics> statistics = HostScoreboard::Default().statistics(host);
+                                if (!statistics.has_value() || statistics->ErrorRate < 0.5)
+                                    healthy.push_back(host);
+                            }
+
+                            std::span<const std::string> candidates = healthy.empty() ? std::span<const std::string> { hosts } : healthy;
+                            std::string const& host = candidates[(index + attempt) % candidates.size()];
+
+                            RangeDownloadTask task { _resourcePath, segment.Offset, segment.Length, writer };
+                            std::optional<RangeDownloadResult> result = co_await task.RunAsync(pool, host, logger);
+
+                            received = result.has_value() && result->TotalSize == progress->TotalSize && result->Size == segment.Length;
+                            if (!received && logger != nullptr)
+                                logger->warn("Range {}-{} of '{}' could not be obtained from {}.", segment.Offset, segment.Offset + segment.Length - 1, _resourcePath, host);
+                        }
+
+                        if (received)
+                            progress->Add(segment.Offset, segment.Length);
+                        else
+                            failed = true;
+                    }
+                }, boost::asio::detached);
+            }
+
+            context.run();
+
+            if (failed)
+                return abandon();
+        }
+
+        if (!writer.Close())
+            return abandon();
+
+        std::error_code ec;
+        std::filesystem::rename(partialPath, _localCache.GetAbsolutePath(_resourcePath), ec);
+        if (ec)
+            return abandon();
+
+        std::filesystem::remove(progressPath, ec);
+        return _localCache.OpenWrite(_resourcePath);
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "libtactmon/detail/Export.hpp"
+#include "libtactmon/io/AsyncFileService.hpp"
+#include "libtactmon/io/FileStream.hpp"
+#include "libtactmon/net/DownloadTask.hpp"
+#include "libtactmon/net/RangeFileBody.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <spdlog/logger.h>
+
+namespace libtactmon::tact {
+    struct Cache;
+}
+
+namespace libtactmon::net {
+    struct RangeDownloadResult {
+        //! Size of the entire remote resource.
+        std::uint64_t TotalSize = 0;
+
+        //! Amount of bytes received.
+        std::uint64_t Size = 0;
+    };
+
+    /**
+     * A download task for a range of bytes of a remote resource, which are written at the same position of a local file.
+     */
+    struct RangeDownloadTask final : DownloadTask<RangeDownloadTask, RangeFileBody, RangeDownloadResult> {
+        RangeDownloadTask(std::string_view resourcePath, std::uint64_t offset, std::uint64_t length, io::AsyncFileService::Writer& writer) noexcept
+            : DownloadTask(resourcePath, offset, length), _writer(writer)
+        { }
+
+        boost::system::error_code Initialize(ValueType& body);
+        std::optional<RangeDownloadResult> TransformMessage(MessageType& body);
+
+    private:
+        io::AsyncFileService::Writer& _writer;
+    };
+
+    /**
+     * Downloads a single remote resource to the cache as several byte ranges requested concurrently, possibly from
+     * different hosts.
+     *
+     * The first range is requested on its own; its response carries the size of the resource. Small resources are thus
+     * obtained in a single request. For larger ones, the file is preallocated and the remaining ranges are fetched over
+     * several connections, each range being written at its final position as it is received. A range that fails is
+     * retried on its own, on the next host.
+     *
+     * If the download is abandoned, the ranges received so far are kept in a @ref DownloadProgress record; the next
+     * download of the resource, segmented or not, only requests what is missing.
+     *
+     * Hosts are tried in the order given by @ref HostScoreboard::Default.
+     */
+    struct LIBTACTMON_API SegmentedDownload final {
+        struct Options {
+            //! Size of each range.
+            std::uint64_t SegmentSize = 4 * 1024 * 1024;
+
+            //! Maximum amount of ranges being downloaded at the same time.
+            std::size_t Concurrency = 8;
+
+            //! Amount of times a range is requested before the download is abandoned.
+            std::size_t MaxAttempts = 3;
+
+            //! If set, the first range is duplicated on another host when it takes unusually long (see @ref RunHedged).
+            bool Hedge = false;
+        };
+
+        SegmentedDownload(std::string_view resourcePath, tact::Cache& localCache);
+        SegmentedDownload(std::string_view resourcePath, tact::Cache& localCache, Options options);
+
+        /**
+         * Executes the download. The calling thread is blocked until it completes.
+         *
+         * @param executor An ASIO (Networking TS) executor, used for the first request.
+         * @param hosts    The hosts expected to supply the resource. Ranges are spread across all of them.
+         * @param logger   An (optional) logger.
+         *
+         * @returns A stream over the downloaded file, or an empty optional if an error occured.
+         */
+        std::optional<io::FileStream> Run(boost::asio::any_io_executor const& executor, std::span<const std::string> hosts,
+            spdlog::logger* logger = nullptr);
+
+    private:
+        std::string _resourcePath;
+        tact::Cache& _localCache;
+        Options _options;
+    };
+}
@@ -1,27 +1,37 @@
 #pragma once
 
-#include "libtactmon/detail/ctre.hpp"
 #include "libtactmon/detail/Export.hpp"
+#include "libtactmon/net/HostOverrides.hpp"
 #include "libtactmon/ribbit/Enums.hpp"
+#include "libtactmon/ribbit/PSV.hpp"
 #include "libtactmon/ribbit/types/BGDL.hpp"
 #include "libtactmon/ribbit/types/CDNs.hpp"
 #include "libtactmon/ribbit/types/Summary.hpp"
 #include "libtactmon/ribbit/types/Versions.hpp"
 
+#include <chrono>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <optional>
 #include <sstream>
+#include <string>
 #include <string_view>
+#include <utility>
 
+#include <boost/asio/awaitable.hpp>
 #include <boost/asio/connect.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/buffers_iterator.hpp>
 #include <boost/asio/read.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/asio/streambuf.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <boost/asio/write.hpp>
+#include <boost/beast/core/tcp_stream.hpp>
 #include <boost/core/ignore_unused.hpp>
-#include <boost/tokenizer.hpp>
 
 #include <fmt/format.h>
 
@@ -43,6 +53,9 @@ namespace libtactmon::ribbit {
         template <> struct CommandTraits<Command::ProductVersions> {
             constexpr static const char Format[] = "{}/products/{}/versions";
 
+            //! Flags of the summary record carrying the sequence number of this response.
+            constexpr static const std::string_view SummaryFlags = "";
+
             using Args = std::tuple<std::string_view>;
             using ValueType = types::Versions;
 
@@ -51,6 +64,7 @@ namespace libtactmon::ribbit {
 
         template <> struct CommandTraits<Command::ProductCDNs> {
             constexpr static const char Format[] = "{}/products/{}/cdns";
+            constexpr static const std::string_view SummaryFlags = "cdn";
 
             using Args = std::tuple<std::string_view>;
             using ValueType = types::CDNs;
@@ -59,7 +73,8 @@ namespace libtactmon::ribbit {
         };
 
         template <> struct CommandTraits<Command::ProductBGDL> {
-            constexpr static const char Format[] = "{}/products/{}/cdns";
+            constexpr static const char Format[] = "{}/products/{}/bgdl";
+            constexpr static const std::string_view SummaryFlags = "bgdl";
 
             using ValueType = types::BGDL;
             using Args = std::tuple<std::string_view>;
@@ -72,52 +87,59 @@ namespace libtactmon::ribbit {
         template <> struct VersionTraits<Version::V1> {
             constexpr static const std::string_view Value = "v1";
 
+            /**
+             * Parses the first part of the MIME message that holds a valid table.
+             */
             template <typename C>
             static auto Parse(std::string_view payload, spdlog::logger* logger)
                 -> std::optional<typename C::ValueType>
             {
-                std::vector<std::string_view> messageParts = ParseCore(payload, logger);
-                for (std::string_view elem : messageParts) {
-                    auto elemParse = C::Parse(elem);
-                    if (elemParse.has_value())
-                        return elemParse;
-                }
+                std::optional<typename C::ValueType> value;
+                bool multipart = ForEachMimePart(payload, [&](std::string_view part) {
+                    value = C::Parse(part);
+                    return value.has_value();
+                });
 
-                return std::nullopt;
-            }
+                if (!multipart && logger != nullptr)
+                    logger->error("An error occured: Malformed multipart response; message boundary not found.");
 
-        private:
-            static std::vector<std::string_view> ParseCore(std::string_view input, spdlog::logger* logger);
+                return value;
+            }
         };
 
         template <> struct VersionTraits<Version::V2> {
             constexpr static const std::string_view Value = "v2";
 
+            /**
+             * Version 2 responses are bare tables.
+             */
             template <typename C>
             static auto Parse(std::string_view payload, spdlog::logger* logger)
                 -> std::optional<typename C::ValueType>
             {
-                std::vector<std::string_view> messageParts = ParseCore(payload, logger);
-                for (std::string_view elem : messageParts) {
-                    auto elemParse = C::Parse(elem);
-                    if (elemParse.has_value())
-                        return elemParse;
-                }
+                boost::ignore_unused(logger);
 
-                return std::nullopt;
+                return C::Parse(payload);
             }
-
-        private:
-            static std::vector<std::string_view> ParseCore(std::string_view input, spdlog::logger* logger);
         };
 
         template <Command C, Version V, typename Args> class command_executor_impl;
         template <Command C, Version V, typename... Args>
         class command_executor_impl<C, V, std::tuple<Args...>> {
+        public:
             using CommandTraits = detail::CommandTraits<C>;
             using VersionTraits = detail::VersionTraits<V>;
+            using ValueType = typename CommandTraits::ValueType;
+
+            constexpr static const Command CommandType = C;
+
+            /**
+             * Returns the command sent to Ribbit, without its line terminator.
+             */
+            static std::string FormatCommand(Args... args) {
+                return fmt::format(CommandTraits::Format, VersionTraits::Value, std::forward<Args>(args)...);
+            }
 
-        public:
             static auto Execute(boost::asio::any_io_executor const& executor, Region region, Args... args) {
                 return Execute(executor, nullptr, region, std::forward<Args>(args)...);
             }
@@ -133,15 +155,17 @@ namespace libtactmon::ribbit {
 
                 boost::system::error_code ec;
 
-                auto command = fmt::format(CommandTraits::Format, VersionTraits::Value, std::forward<Args>(args)...) + "\r\n";
+                auto command = FormatCommand(std::forward<Args>(args)...) + "\r\n";
 
                 std::string host = fmt::format("{}.version.battle.net", region);
 
                 if (logger != nullptr)
                     logger->info("Loading {}:{}/{}.", host, 1119, command);
 
+                net::Endpoint endpoint = net::HostOverrides::Default().Resolve(host, "1119");
+
                 tcp::resolver r { executor };
-                asio::connect(socket, r.resolve(host, "1119"), ec);
+                asio::connect(socket, r.resolve(endpoint.Host, endpoint.Service), ec);
 
                 if (ec) {
                     if (logger != nullptr)
@@ -175,6 +199,77 @@ namespace libtactmon::ribbit {
                     return VersionTraits::template Parse<CommandTraits>(response, logger);
                 }
             }
+
+            /**
+             * Coroutine counterpart of @ref Execute. The calling thread is never blocked.
+             *
+             * @param[in] timeout Time allotted to the entire request, including name resolution.
+             * @param[in] logger  An (optional) logger.
+             * @param[in] region  The region to query.
+             * @param[in] args    Arguments of the command. Views must remain valid until the coroutine completes.
+             *
+             * @returns The parsed response, or an empty optional if an error occured or the request timed out.
+             */
+            static auto ExecuteAsync(std::chrono::steady_clock::duration timeout, spdlog::logger* logger, Region region, Args... args)
+                -> boost::asio::awaitable<std::optional<typename CommandTraits::ValueType>>
+            {
+                namespace asio = boost::asio;
+                using tcp = asio::ip::tcp;
+
+                asio::any_io_executor executor = co_await asio::this_coro::executor;
+                auto deadline = std::chrono::steady_clock::now() + timeout;
+
+                auto command = FormatCommand(std::forward<Args>(args)...) + "\r\n";
+
+                std::string host = fmt::format("{}.version.battle.net", region);
+
+                if (logger != nullptr)
+                    logger->info("Loading {}:{}/{}.", host, 1119, command);
+
+                auto fail = [&](boost::system::error_code ec) -> std::optional<typename CommandTraits::ValueType> {
+                    if (logger != nullptr)
+                        logger->error("An error occured while querying {}: {}.", host, ec.message());
+
+                    return std::nullopt;
+                };
+
+                boost::system::error_code ec;
+
+                // Name resolution is not covered by the stream's timeout. The timer's handler may run after this coroutine
+                // moved on (or was destroyed), so it shares ownership of the resolver.
+                auto resolver = std::make_shared<tcp::resolver>(executor);
+                asio::steady_timer resolveTimer { executor, deadline };
+                resolveTimer.async_wait([resolver](boost::system::error_code timerError) {
+                    if (!timerError)
+                        resolver->cancel();
+                });
+
+                net::Endpoint endpoint = net::HostOverrides::Default().Resolve(host, "1119");
+                tcp::resolver::results_type endpoints = co_await resolver->async_resolve(endpoint.Host, endpoint.Service,
+                    asio::redirect_error(asio::use_awaitable, ec));
+                resolveTimer.cancel();
+                if (ec)
+                    co_return fail(ec);
+
+                boost::beast::tcp_stream stream { executor };
+                stream.expires_at(deadline);
+
+                co_await stream.async_connect(endpoints, asio::redirect_error(asio::use_awaitable, ec));
+                if (ec)
+                    co_return fail(ec);
+
+                co_await asio::async_write(stream, asio::buffer(command), asio::redirect_error(asio::use_awaitable, ec));
+                if (ec)
+                    co_return fail(ec);
+
+                // Ribbit closes the connection once the response was sent.
+                std::string response;
+                co_await asio::async_read(stream, asio::dynamic_buffer(response), asio::redirect_error(asio::use_awaitable, ec));
+                if (ec && ec != asio::error::eof)
+                    co_return fail(ec);
+
+                co_return VersionTraits::template Parse<CommandTraits>(response, logger);
+            }
         };
     }
 
@@ -187,6 +282,9 @@ namespace libtactmon::ribbit {
     template <Version V = Version::V1>
     using Versions = CommandExecutor<Command::ProductVersions, V>;
 
+    template <Version V = Version::V1>
+    using BGDL = CommandExecutor<Command::ProductBGDL, V>;
+
     template <Version V = Version::V1>
     using Summary = CommandExecutor<Command::Summary, V>;
 }
@@ -0,0 +1,101 @@
+#include "libtactmon/ribbit/MultiRegion.hpp"
+
+#include <algorithm>
+#include <string_view>
+
+#include <fmt/format.h>
+
+namespace libtactmon::ribbit {
+    namespace {
+        /**
+         * Merges rows that each describe one region, identified by @p Key. Every region is authoritative for its own
+         * row; rows of regions that did not answer are taken from the first response that mentions them.
+         */
+        template <typename Record, typename Key>
+        std::optional<std::vector<Record>> MergeRows(std::span<const RegionalResponse<std::vector<Record>>> responses, Key key) {
+            std::optional<std::vector<Record>> merged;
+
+            auto contains = [&](std::string_view name) {
+                return std::any_of(merged->begin(), merged->end(), [&](Record const& record) { return key(record) == name; });
+            };
+
+            for (RegionalResponse<std::vector<Record>> const& response : responses) {
+                if (!response.Value.has_value())
+                    continue;
+
+                if (!merged.has_value())
+                    merged.emplace();
+
+                std::string name = fmt::format("{}", response.Origin);
+                for (Record const& record : *response.Value) {
+                    if (key(record) == name && !contains(name))
+                        merged->push_back(record);
+                }
+            }
+
+            for (RegionalResponse<std::vector<Record>> const& response : responses) {
+                if (!response.Value.has_value())
+                    continue;
+
+                for (Record const& record : *response.Value) {
+                    if (!contains(key(record)))
+                        merged->push_back(record);
+                }
+            }
+
+            return merged;
+        }
+    }
+
+    std::optional<types::Summary> Merge(std::span<const RegionalResponse<types::Summary>> responses) {
+        std::optional<types::Summary> merged;
+
+        for (RegionalResponse<types::Summary> const& response : responses) {
+            if (!response.Value.has_value())
+                continue;
+
+            if (!merged.has_value())
+                merged.emplace();
+
+            for (types::summary::Record const& record : *response.Value) {
+                auto itr = std::find_if(merged->begin(), merged->end(), [&](types::summary::Record const& other) {
+                    return other.Product == record.Product && other.Flags == record.Flags;
+                });
+
+                if (itr == merged->end())
+                    merged->push_back(record);
+                else
+                    itr->SequenceID = std::max(itr->SequenceID, record.SequenceID);
+            }
+        }
+
+        return merged;
+    }
+
+    std::optional<types::Versions> Merge(std::span<const RegionalResponse<types::Versions>> responses) {
+        std::vector<RegionalResponse<std::vector<types::versions::Record>>> rows;
+        std::size_t sequenceID = 0;
+
+        for (RegionalResponse<types::Versions> const& response : responses) {
+            if (response.Value.has_value()) {
+                rows.push_back({ response.Origin, response.Value->Records });
+                sequenceID = std::max(sequenceID, response.Value->SequenceID);
+            }
+        }
+
+        auto records = MergeRows<types::versions::Record>(std::span<const RegionalResponse<std::vector<types::versions::Record>>> { rows },
+            [](types::versions::Record const& record) -> std::string_view { return record.Region; });
+        if (!records.has_value())
+            return std::nullopt;
+
+        return types::Versions { std::move(*records), sequenceID };
+    }
+
+    std::optional<types::CDNs> Merge(std::span<const RegionalResponse<types::CDNs>> responses) {
+        return MergeRows<types::cdns::Record>(responses, [](types::cdns::Record const& record) -> std::string_view { return record.Name; });
+    }
+
+    std::optional<types::BGDL> Merge(std::span<const RegionalResponse<types::BGDL>> responses) {
+        return MergeRows<types::bgdl::Record>(responses, [](types::bgdl::Record const& record) -> std::string_view { return record.Region; });
+    }
+}
@@ -0,0 +1,154 @@
+#pragma once
+
+#include "libtactmon/detail/Export.hpp"
+#include "libtactmon/ribbit/Commands.hpp"
+#include "libtactmon/ribbit/Enums.hpp"
+#include "libtactmon/ribbit/types/BGDL.hpp"
+#include "libtactmon/ribbit/types/CDNs.hpp"
+#include "libtactmon/ribbit/types/Summary.hpp"
+#include "libtactmon/ribbit/types/Versions.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/redirect_error.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/strand.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <spdlog/logger.h>
+
+namespace libtactmon::ribbit {
+    //! Every region served by Ribbit.
+    constexpr const std::array<Region, 5> AllRegions { Region::US, Region::EU, Region::KR, Region::TW, Region::CN };
+
+    //! Time allotted to a single regional request by default.
+    constexpr const std::chrono::steady_clock::duration DefaultTimeout = std::chrono::seconds { 10 };
+
+    /**
+     * The response of a single region.
+     */
+    template <typename T>
+    struct RegionalResponse {
+        Region Origin;
+
+        //! Empty if the region did not answer in time.
+        std::optional<T> Value;
+    };
+
+    /**
+     * Merges the responses of several regions.
+     *
+     * Each region is authoritative for its own rows (summaries excepted, where the highest sequence number of every
+     * product wins, so that an update is noticed as soon as a single region reports it). Rows about regions that did not
+     * answer are taken from the first response that mentions them.
+     *
+     * @returns The merged response, or an empty optional if no region answered.
+     */
+    LIBTACTMON_API std::optional<types::Summary> Merge(std::span<const RegionalResponse<types::Summary>> responses);
+    LIBTACTMON_API std::optional<types::Versions> Merge(std::span<const RegionalResponse<types::Versions>> responses);
+    LIBTACTMON_API std::optional<types::CDNs> Merge(std::span<const RegionalResponse<types::CDNs>> responses);
+    LIBTACTMON_API std::optional<types::BGDL> Merge(std::span<const RegionalResponse<types::BGDL>> responses);
+
+    namespace detail {
+        template <typename Executor, typename... Args>
+        auto ExecuteAllImpl(std::vector<Region> regions, std::chrono::steady_clock::duration timeout, spdlog::logger* logger, Args... args)
+            -> boost::asio::awaitable<std::vector<RegionalResponse<typename Executor::ValueType>>>
+        {
+            using ResponseType = RegionalResponse<typename Executor::ValueType>;
+
+            // This coroutine runs on a strand; requests are spawned on it as well so that completions can be counted.
+            boost::asio::any_io_executor executor = co_await boost::asio::this_coro::executor;
+
+            // Cancelled whenever a request completes, to wake this coroutine up.
+            auto event = std::make_shared<boost::asio::steady_timer>(executor, std::chrono::steady_clock::time_point::max());
+
+            auto responses = std::make_shared<std::vector<ResponseType>>();
+            auto pending = std::make_shared<std::size_t>(regions.size());
+            for (Region region : regions)
+                responses->push_back(ResponseType { region, std::nullopt });
+
+            for (std::size_t i = 0; i < regions.size(); ++i) {
+                boost::asio::co_spawn(executor, [=]() -> boost::asio::awaitable<void> {
+                    // Arguments are captured by the closure, which outlives the request.
+                    (*responses)[i].Value = co_await Executor::ExecuteAsync(timeout, logger, regions[i], args...);
+                }, [=](std::exception_ptr exception) {
+                    // A request that threw is counted as a region that did not answer; it still has to be counted.
+                    if (exception != nullptr && logger != nullptr)
+                        logger->error("An unexpected error occured while querying region {}.", regions[i]);
+
+                    if (--*pending == 0)
+                        event->cancel();
+                });
+            }
+
+            while (*pending != 0) {
+                boost::system::error_code ec;
+                co_await event->async_wait(boost::asio::redirect_error(boost::asio::use_awaitable, ec));
+            }
+
+            co_return std::move(*responses);
+        }
+    }
+
+    /**
+     * Queries several regions concurrently.
+     *
+     * @tparam Executor A command executor, such as @c ribbit::Versions<>.
+     *
+     * @param[in] regions The regions to query.
+     * @param[in] timeout Time allotted to each regional request.
+     * @param[in] logger  An (optional) logger.
+     * @param[in] args    Arguments of the command; they are copied.
+     *
+     * @returns The response of every region, in the order of @p regions. The coroutine completes once every region
+     *          answered or timed out.
+     */
+    template <typename Executor, typename... Args>
+    auto ExecuteAllAsync(std::span<const Region> regions, std::chrono::steady_clock::duration timeout, spdlog::logger* logger, Args... args)
+        -> boost::asio::awaitable<std::vector<RegionalResponse<typename Executor::ValueType>>>
+    {
+        boost::asio::any_io_executor executor = co_await boost::asio::this_coro::executor;
+
+        co_return co_await boost::asio::co_spawn(boost::asio::make_strand(executor),
+            detail::ExecuteAllImpl<Executor>(std::vector<Region> { regions.begin(), regions.end() }, timeout, logger, std::string { args }...),
+            boost::asio::use_awaitable);
+    }
+
+    /**
+     * Queries several regions concurrently. The calling thread is blocked until every region answered or timed out; the
+     * requests are driven by this thread on a private context.
+     *
+     * @see ExecuteAllAsync
+     */
+    template <typename Executor, typename... Args>
+    auto ExecuteAll(std::span<const Region> regions, std::chrono::steady_clock::duration timeout, spdlog::logger* logger, Args... args)
+        -> std::vector<RegionalResponse<typename Executor::ValueType>>
+    {
+        std::vector<RegionalResponse<typename Executor::ValueType>> responses;
+
+        boost::asio::io_context context;
+        boost::asio::co_spawn(context,
+            detail::ExecuteAllImpl<Executor>(std::vector<Region> { regions.begin(), regions.end() }, timeout, logger, std::string { args }...),
+            [&](std::exception_ptr exception, std::vector<RegionalResponse<typename Executor::ValueType>> value) {
+                if (exception == nullptr)
+                    responses = std::move(value);
+            });
+
+        context.run();
+        return responses;
+    }
+}
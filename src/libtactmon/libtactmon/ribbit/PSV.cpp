@@ -0,0 +1,195 @@
+#include "libtactmon/ribbit/PSV.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <span>
+
+namespace libtactmon::ribbit {
+    namespace {
+        bool EqualsIgnoreCase(std::string_view left, std::string_view right) {
+            return std::equal(left.begin(), left.end(), right.begin(), right.end(), [](char l, char r) {
+                return (l | 0x20) == (r | 0x20);
+            });
+        }
+
+        std::string_view Trim(std::string_view value) {
+            while (!value.empty() && (value.front() == ' ' || value.front() == '\t'))
+                value.remove_prefix(1);
+            while (!value.empty() && (value.back() == ' ' || value.back() == '\t'))
+                value.remove_suffix(1);
+            return value;
+        }
+
+        /**
+         * Splits a line on pipes, storing at most @p fields.size() of them.
+         *
+         * @returns The amount of fields in the line.
+         */
+        std::size_t Split(std::string_view line, std::span<std::string_view> fields) {
+            std::size_t count = 0;
+            for (;;) {
+                char const* separator = line.empty() ? nullptr : static_cast<char const*>(std::memchr(line.data(), '|', line.size()));
+                std::size_t length = separator != nullptr ? static_cast<std::size_t>(separator - line.data()) : line.size();
+
+                if (count < fields.size())
+                    fields[count] = line.substr(0, length);
+                ++count;
+
+                if (separator == nullptr)
+                    return count;
+
+                line.remove_prefix(length + 1);
+            }
+        }
+    }
+
+    namespace detail {
+        std::string_view NextLine(std::string_view& document) {
+            char const* terminator = document.empty() ? nullptr : static_cast<char const*>(std::memchr(document.data(), '\n', document.size()));
+            std::size_t length = terminator != nullptr ? static_cast<std::size_t>(terminator - document.data()) : document.size();
+
+            std::string_view line = document.substr(0, length);
+            document.remove_prefix(std::min(length + 1, document.size()));
+
+            if (line.ends_with('\r'))
+                line.remove_suffix(1);
+
+            return line;
+        }
+
+        std::optional<std::string_view> ReadMimeHeaders(std::string_view& message) {
+            std::optional<std::string_view> boundary;
+
+            while (!message.empty()) {
+                std::string_view line = NextLine(message);
+                if (line.empty())
+                    break;
+
+                std::size_t colon = line.find(':');
+                if (colon == std::string_view::npos || !EqualsIgnoreCase(Trim(line.substr(0, colon)), "Content-Type"))
+                    continue;
+
+                // multipart/<subtype>; boundary="<boundary>"
+                std::string_view value = Trim(line.substr(colon + 1));
+                if (value.size() < 10 || !EqualsIgnoreCase(value.substr(0, 10), "multipart/"))
+                    return std::nullopt;
+
+                std::size_t parameter = value.find("boundary=");
+                if (parameter == std::string_view::npos)
+                    return std::nullopt;
+
+                value = Trim(value.substr(parameter + 9));
+                std::size_t end = value.find(';');
+                value = Trim(value.substr(0, end));
+                if (value.size() >= 2 && (value.front() == '"' || value.front() == '\'') && value.back() == value.front())
+                    value = value.substr(1, value.size() - 2);
+
+                if (!value.empty())
+                    boundary = value;
+            }
+
+            return boundary;
+        }
+    }
+
+    PSV::PSV(std::string_view document) {
+        // The header is the first line that is neither empty nor a comment.
+        std::string_view header;
+        while (!document.empty() && header.empty()) {
+            std::string_view line = detail::NextLine(document);
+            if (!line.starts_with('#'))
+                header = line;
+        }
+
+        if (header.empty())
+            return;
+
+        _fieldCount = Split(header, _columns);
+        _columnCount = std::min(_fieldCount, MaxColumns);
+
+        for (std::size_t i = 0; i < _columnCount; ++i) {
+            // Name!TYPE:size
+            std::size_t type = _columns[i].find('!');
+            if (type == std::string_view::npos) {
+                // Not a table header.
+                _columnCount = 0;
+                return;
+            }
+
+            _columns[i] = _columns[i].substr(0, type);
+        }
+
+        // Comments between the header and the first row carry metadata.
+        while (!document.empty()) {
+            std::string_view remainder = document;
+            std::string_view line = detail::NextLine(document);
+            if (line.empty())
+                continue;
+
+            if (!line.starts_with('#')) {
+                document = remainder;
+                break;
+            }
+
+            // ## seqn = 12345
+            line.remove_prefix(std::min(line.find_first_not_of('#'), line.size()));
+            line = Trim(line);
+            if (line.starts_with("seqn")) {
+                line = Trim(line.substr(4));
+                if (line.starts_with('='))
+                    line = Trim(line.substr(1));
+
+                auto [ptr, ec] = std::from_chars(line.data(), line.data() + line.size(), _sequenceID);
+                if (ec != std::errc { })
+                    _sequenceID = 0;
+            }
+        }
+
+        _body = document;
+    }
+
+    std::optional<std::size_t> PSV::Column(std::string_view name) const {
+        for (std::size_t i = 0; i < _columnCount; ++i) {
+            if (EqualsIgnoreCase(_columns[i], name))
+                return i;
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<std::string_view> PSV::Row::operator [] (std::string_view column) const {
+        std::optional<std::size_t> index = _owner->Column(column);
+        if (!index.has_value())
+            return std::nullopt;
+
+        return _fields[*index];
+    }
+
+    PSV::iterator::iterator(PSV const* owner, std::string_view remainder) : _remainder(remainder), _done(false) {
+        _row._owner = owner;
+        if (owner->_columnCount == 0)
+            _remainder = { };
+
+        ++*this;
+    }
+
+    PSV::iterator& PSV::iterator::operator ++ () {
+        while (!_remainder.empty()) {
+            std::string_view line = detail::NextLine(_remainder);
+            if (line.empty() || line.starts_with('#'))
+                continue;
+
+            // Malformed rows are skipped.
+            if (Split(line, _row._fields) != _row._owner->_fieldCount)
+                continue;
+
+            return *this;
+        }
+
+        // Compare equal to end().
+        _remainder = { };
+        _done = true;
+        return *this;
+    }
+}
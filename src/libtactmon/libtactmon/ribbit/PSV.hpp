@@ -0,0 +1,166 @@
+#pragma once
+
+#include "libtactmon/detail/Export.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <optional>
+#include <string_view>
+
+namespace libtactmon::ribbit {
+    /**
+     * A single-pass reader over a pipe-separated values table, as served by Ribbit:
+     *
+     * @code
+     * Region!STRING:0|BuildConfig!HEX:16|...
+     * ## seqn = 12345
+     * us|0123456789abcdef0123456789abcdef|...
+     * @endcode
+     *
+     * The header is parsed once, on construction; rows are then split as they are iterated. Every value is a view
+     * into the document, which must outlive the table and its rows. Nothing is allocated.
+     */
+    struct LIBTACTMON_API PSV final {
+        //! Columns past this amount are ignored.
+        constexpr static const std::size_t MaxColumns = 16;
+
+        explicit PSV(std::string_view document);
+
+        /**
+         * Returns true if the document starts with a table header.
+         */
+        [[nodiscard]] explicit operator bool() const { return _columnCount != 0; }
+
+        /**
+         * Returns the index of a column, looked up by name (case-insensitive), or an empty optional if the table has no
+         * such column.
+         */
+        [[nodiscard]] std::optional<std::size_t> Column(std::string_view name) const;
+
+        /**
+         * Returns the sequence number given by a `## seqn = ...` comment between the header and the first row, or zero.
+         */
+        [[nodiscard]] uint64_t SequenceID() const { return _sequenceID; }
+
+        struct Row {
+            /**
+             * Returns the value of a column, or an empty optional if the table has no such column.
+             */
+            [[nodiscard]] std::optional<std::string_view> operator [] (std::string_view column) const;
+            [[nodiscard]] std::string_view operator [] (std::size_t column) const { return _fields[column]; }
+
+            [[nodiscard]] std::size_t size() const { return _owner->_columnCount; }
+
+        private:
+            friend struct PSV;
+
+            PSV const* _owner = nullptr;
+            std::array<std::string_view, MaxColumns> _fields;
+        };
+
+        struct iterator {
+            using iterator_category = std::input_iterator_tag;
+            using value_type = Row;
+            using difference_type = std::ptrdiff_t;
+            using pointer = Row const*;
+            using reference = Row const&;
+
+            iterator() = default;
+
+            reference operator * () const { return _row; }
+            pointer operator -> () const { return &_row; }
+
+            iterator& operator ++ ();
+            iterator operator ++ (int) { iterator copy = *this; ++*this; return copy; }
+
+            friend bool operator == (iterator const& left, iterator const& right) { return left._remainder.data() == right._remainder.data() && left._done == right._done; }
+
+        private:
+            friend struct PSV;
+
+            iterator(PSV const* owner, std::string_view remainder);
+
+            Row _row;
+            std::string_view _remainder;
+            bool _done = true;
+        };
+
+        [[nodiscard]] iterator begin() const { return iterator { this, _body }; }
+        [[nodiscard]] iterator end() const { return iterator { }; }
+
+    private:
+        std::array<std::string_view, MaxColumns> _columns;
+        std::size_t _columnCount = 0;
+
+        //! Amount of fields of the header, including those past MaxColumns. Rows with a different amount are skipped.
+        std::size_t _fieldCount = 0;
+
+        uint64_t _sequenceID = 0;
+
+        //! Remainder of the document, starting at the first row.
+        std::string_view _body;
+    };
+
+    /**
+     * Enumerates the parts of a Ribbit v1 response, a MIME multipart message, without copying it.
+     *
+     * @param[in] message The response.
+     * @param[in] handler Called with the body of every part, until it returns true.
+     *
+     * @returns false if the message is not a multipart message.
+     */
+    template <typename Handler>
+    bool ForEachMimePart(std::string_view message, Handler&& handler);
+
+    namespace detail {
+        /**
+         * Splits the next line off a document, stripping its terminator.
+         */
+        LIBTACTMON_API std::string_view NextLine(std::string_view& document);
+
+        /**
+         * Returns the boundary of a multipart message, and removes its headers from @p message.
+         */
+        LIBTACTMON_API std::optional<std::string_view> ReadMimeHeaders(std::string_view& message);
+    }
+
+    template <typename Handler>
+    bool ForEachMimePart(std::string_view message, Handler&& handler) {
+        std::optional<std::string_view> boundary = detail::ReadMimeHeaders(message);
+        if (!boundary.has_value())
+            return false;
+
+        // Parts are introduced by "--boundary" lines; "--boundary--" terminates the message.
+        std::optional<std::string_view> part;
+        while (!message.empty()) {
+            char const* lineStart = message.data();
+            std::string_view line = detail::NextLine(message);
+
+            if (!line.starts_with("--") || !line.substr(2).starts_with(*boundary))
+                continue;
+
+            std::string_view suffix = line.substr(2 + boundary->size());
+            if (!suffix.empty() && suffix != "--")
+                continue;
+
+            if (part.has_value()) {
+                std::string_view body { part->data(), static_cast<std::size_t>(lineStart - part->data()) };
+                if (handler(body))
+                    return true;
+            }
+
+            if (suffix == "--")
+                break;
+
+            // Skip the headers of the part.
+            while (!message.empty() && !detail::NextLine(message).empty())
+                continue;
+
+            part = message;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,79 @@
+#include "libtactmon/ribbit/ResponseCache.hpp"
+
+#include <iterator>
+
+namespace libtactmon::ribbit {
+    ResponseCache::ResponseCache() : ResponseCache(Options { }) { }
+
+    ResponseCache::ResponseCache(Options options) : _options(options) { }
+
+    /* static */ ResponseCache& ResponseCache::Default() {
+        static ResponseCache instance;
+        return instance;
+    }
+
+    /* static */ std::string ResponseCache::SequenceKey(Region region, std::string_view product, std::string_view flags) {
+        return fmt::format("{}/{}/{}", region, product, flags);
+    }
+
+    void ResponseCache::Update(Region region, types::Summary const& summary) {
+        Clock::time_point now = Clock::now();
+
+        std::lock_guard<std::mutex> guard { _lock };
+        for (types::summary::Record const& record : summary) {
+            std::string sequenceKey = SequenceKey(region, record.Product, record.Flags);
+
+            Sequence& sequence = _sequences[sequenceKey];
+            if (sequence.SequenceID != record.SequenceID) {
+                // Responses obtained with any other sequence number are stale.
+                for (auto itr = _entries.begin(); itr != _entries.end(); ) {
+                    if (itr->second.SequenceKey == sequenceKey && itr->second.SequenceID != record.SequenceID)
+                        itr = _entries.erase(itr);
+                    else
+                        itr = std::next(itr);
+                }
+            }
+
+            sequence.SequenceID = record.SequenceID;
+            sequence.ObservedAt = now;
+        }
+    }
+
+    void ResponseCache::Clear() {
+        std::lock_guard<std::mutex> guard { _lock };
+        _entries.clear();
+        _sequences.clear();
+    }
+
+    std::shared_ptr<const void> ResponseCache::Find(std::string const& key) {
+        Clock::time_point now = Clock::now();
+
+        std::lock_guard<std::mutex> guard { _lock };
+        auto entry = _entries.find(key);
+        if (entry == _entries.end())
+            return nullptr;
+
+        auto sequence = _sequences.find(entry->second.SequenceKey);
+        bool current = sequence != _sequences.end() && now - sequence->second.ObservedAt < _options.TimeToLive
+            ? entry->second.SequenceID == sequence->second.SequenceID
+            : now - entry->second.ReceivedAt < _options.TimeToLive;
+
+        if (!current) {
+            _entries.erase(entry);
+            return nullptr;
+        }
+
+        return entry->second.Value;
+    }
+
+    uint64_t ResponseCache::SequenceOf(std::string const& sequenceKey) {
+        std::lock_guard<std::mutex> guard { _lock };
+        auto sequence = _sequences.find(sequenceKey);
+        return sequence != _sequences.end() ? sequence->second.SequenceID : 0;
+    }
+
+    void ResponseCache::Store(std::string key, std::string sequenceKey, uint64_t sequenceID, std::shared_ptr<const void> value) {
+        std::lock_guard<std::mutex> guard { _lock };
+        _entries.insert_or_assign(std::move(key), Entry { std::move(value), std::move(sequenceKey), sequenceID, Clock::now() });
+    }
+}
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "libtactmon/detail/Export.hpp"
+#include "libtactmon/ribbit/Commands.hpp"
+#include "libtactmon/ribbit/Enums.hpp"
+#include "libtactmon/ribbit/types/Summary.hpp"
+#include "libtactmon/utility/SingleFlight.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include <boost/asio/any_io_executor.hpp>
+
+#include <fmt/format.h>
+
+#include <spdlog/logger.h>
+
+namespace libtactmon::ribbit {
+    /**
+     * Caches responses of Ribbit product commands (versions, cdns, bgdl).
+     *
+     * Every summary obtained through the cache records the sequence number of each product's responses. A cached
+     * response is then reused for as long as the latest summary reports the sequence number it was obtained with, and
+     * discarded as soon as that sequence number changes. If no summary was obtained for longer than
+     * @ref Options::TimeToLive, responses are instead reused until they are that old.
+     *
+     * Concurrent requests for a response that is not cached share a single round trip to Ribbit.
+     */
+    struct LIBTACTMON_API ResponseCache final {
+        struct Options {
+            //! How long sequence numbers from a summary, or responses when no summary is current, are trusted.
+            std::chrono::steady_clock::duration TimeToLive = std::chrono::minutes { 5 };
+        };
+
+        ResponseCache();
+        explicit ResponseCache(Options options);
+
+        ResponseCache(ResponseCache const&) = delete;
+        ResponseCache& operator = (ResponseCache const&) = delete;
+
+        /**
+         * Returns the process-wide instance.
+         */
+        static ResponseCache& Default();
+
+        /**
+         * Requests the summary of all products from Ribbit, and records the sequence numbers it carries. Summaries are
+         * never cached.
+         *
+         * @tparam Executor A summary command executor, such as @c ribbit::Summary<>.
+         */
+        template <typename Executor>
+        requires (Executor::CommandType == Command::Summary)
+        auto Execute(boost::asio::any_io_executor const& executor, spdlog::logger* logger, Region region)
+            -> std::optional<typename Executor::ValueType>
+        {
+            auto summary = Executor::Execute(executor, logger, region);
+            if (summary.has_value())
+                Update(region, *summary);
+
+            return summary;
+        }
+
+        /**
+         * Returns the response of a product command, requesting it from Ribbit if it is not cached or no longer current.
+         *
+         * @tparam Executor A product command executor, such as @c ribbit::CDNs<> or @c ribbit::Versions<>.
+         */
+        template <typename Executor>
+        requires (Executor::CommandType != Command::Summary)
+        auto Execute(boost::asio::any_io_executor const& executor, spdlog::logger* logger, Region region, std::string_view product)
+            -> std::optional<typename Executor::ValueType>
+        {
+            using ValueType = typename Executor::ValueType;
+
+            std::string key = fmt::format("{}/{}", region, Executor::FormatCommand(product));
+            std::string sequenceKey = SequenceKey(region, product, Executor::CommandTraits::SummaryFlags);
+
+            if (std::shared_ptr<const void> value = Find(key))
+                return *std::static_pointer_cast<const ValueType>(value);
+
+            return utility::SingleFlight::Default().Run("ribbit:" + key, [&]() -> std::optional<ValueType> {
+                // The response may have been stored by a request that completed since the lookup above.
+                if (std::shared_ptr<const void> value = Find(key))
+                    return *std::static_pointer_cast<const ValueType>(value);
+
+                uint64_t sequenceID = SequenceOf(sequenceKey);
+
+                std::optional<ValueType> response = Executor::Execute(executor, logger, region, product);
+                if (!response.has_value())
+                    return std::nullopt;
+
+                // Versions carry their own sequence number, which is more accurate: Ribbit may serve a response older
+                // than the summary.
+                if constexpr (requires { response->SequenceID; })
+                    sequenceID = response->SequenceID;
+
+                Store(key, sequenceKey, sequenceID, std::make_shared<const ValueType>(*response));
+                return response;
+            }).get();
+        }
+
+        /**
+         * Records the sequence numbers of a summary, discarding cached responses that are no longer current.
+         */
+        void Update(Region region, types::Summary const& summary);
+
+        /**
+         * Discards all cached responses and sequence numbers.
+         */
+        void Clear();
+
+    private:
+        static std::string SequenceKey(Region region, std::string_view product, std::string_view flags);
+
+        /**
+         * Returns a cached response if it is still current.
+         */
+        std::shared_ptr<const void> Find(std::string const& key);
+
+        /**
+         * Returns the current sequence number of a product's responses, or zero if unknown.
+         */
+        uint64_t SequenceOf(std::string const& sequenceKey);
+
+        void Store(std::string key, std::string sequenceKey, uint64_t sequenceID, std::shared_ptr<const void> value);
+
+        using Clock = std::chrono::steady_clock;
+
+        struct Entry {
+            std::shared_ptr<const void> Value;
+            std::string SequenceKey;
+            uint64_t SequenceID = 0;
+            Clock::time_point ReceivedAt;
+        };
+
+        struct Sequence {
+            uint64_t SequenceID = 0;
+            Clock::time_point ObservedAt;
+        };
+
+        Options _options;
+
+        std::mutex _lock;
+        std::map<std::string, Entry> _entries;
+        std::map<std::string, Sequence> _sequences;
+    };
+}
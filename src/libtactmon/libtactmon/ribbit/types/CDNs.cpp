@@ -1,22 +1,23 @@
-#include "libtactmon/detail/Tokenizer.hpp"
 #include "libtactmon/ribbit/types/CDNs.hpp"
-#include "libtactmon/ribbit/Commands.hpp"
 
 #include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/split.hpp>
 
 namespace libtactmon::ribbit::types::cdns {
-    std::optional<Record> Record::Parse(std::string_view input) {
-        std::vector<std::string_view> tokens = libtactmon::detail::Tokenize(input, '|', false);
-        if (tokens.size() != 5)
+    std::optional<Record> Record::Parse(PSV::Row const& row) {
+        auto name = row["Name"];
+        auto path = row["Path"];
+        auto hosts = row["Hosts"];
+        if (!name || !path || !hosts)
             return std::nullopt;
 
         Record record{ };
-        record.Name = tokens[0];
-        record.Path = tokens[1];
-        boost::split(record.Hosts, tokens[2], boost::is_any_of(" "), boost::token_compress_on);
-        boost::split(record.Servers, tokens[3], boost::is_any_of(" "), boost::token_compress_on);
-        record.ConfigPath = tokens[4];
+        record.Name = *name;
+        record.Path = *path;
+        boost::split(record.Hosts, *hosts, boost::is_any_of(" "), boost::token_compress_on);
+        if (auto servers = row["Servers"]; servers.has_value())
+            boost::split(record.Servers, *servers, boost::is_any_of(" "), boost::token_compress_on);
+        record.ConfigPath = row["ConfigPath"].value_or("");
 
         return record;
     }
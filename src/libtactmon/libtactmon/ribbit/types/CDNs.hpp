@@ -1,5 +1,7 @@
 #pragma once
 
+#include "libtactmon/ribbit/PSV.hpp"
+
 #include <optional>
 #include <string>
 #include <string_view>
@@ -14,7 +16,10 @@ namespace libtactmon::ribbit::types {
             std::vector<std::string> Servers;
             std::string ConfigPath;
 
-            static std::optional<Record> Parse(std::string_view input);
+            /**
+             * Parses a row of the table, looking columns up by name.
+             */
+            static std::optional<Record> Parse(PSV::Row const& row);
         };
     }
 
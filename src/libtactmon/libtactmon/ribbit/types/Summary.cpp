@@ -1,23 +1,19 @@
 #include "libtactmon/ribbit/types/Summary.hpp"
-#include "libtactmon/ribbit/Commands.hpp"
-#include "libtactmon/detail/Tokenizer.hpp"
 
 #include <charconv>
 
-#include <boost/tokenizer.hpp>
-
 namespace libtactmon::ribbit::types::summary {
-    std::optional<Record> Record::Parse(std::string_view input) {
-        std::vector<std::string_view> tokens = libtactmon::detail::Tokenize(input, '|', false);
-        if (tokens.size() != 3 && tokens.size() != 2)
+    std::optional<Record> Record::Parse(PSV::Row const& row) {
+        auto product = row["Product"];
+        auto sequenceID = row["Seqn"];
+        if (!product || !sequenceID)
             return std::nullopt;
 
         Record rec { };
-        rec.Product = tokens[0];
-
-        rec.Flags = tokens.size() == 3 ? tokens[2] : "";
+        rec.Product = *product;
+        rec.Flags = row["Flags"].value_or("");
 
-        auto [ptr, ec] = std::from_chars(tokens[1].data(), tokens[1].data() + tokens[1].size(), rec.SequenceID);
+        auto [ptr, ec] = std::from_chars(sequenceID->data(), sequenceID->data() + sequenceID->size(), rec.SequenceID);
         if (ec != std::errc{ })
             return std::nullopt;
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include "libtactmon/ribbit/PSV.hpp"
+
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -13,7 +15,10 @@ namespace libtactmon::ribbit::types {
             uint32_t SequenceID = 0;
             std::string Flags;
 
-            static std::optional<Record> Parse(std::string_view input);
+            /**
+             * Parses a row of the table, looking columns up by name.
+             */
+            static std::optional<Record> Parse(PSV::Row const& row);
         };
     }
 
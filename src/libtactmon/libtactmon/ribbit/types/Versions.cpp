@@ -1,26 +1,28 @@
-#include "libtactmon/detail/Tokenizer.hpp"
 #include "libtactmon/ribbit/types/Versions.hpp"
-#include "libtactmon/ribbit/Commands.hpp"
 
 #include <charconv>
 #include <string_view>
 
 namespace libtactmon::ribbit::types::versions {
-    std::optional<Record> Record::Parse(std::string_view input) {
-        std::vector<std::string_view> tokens = libtactmon::detail::Tokenize(input, '|', false);
-        if (tokens.size() != 7)
+    std::optional<Record> Record::Parse(PSV::Row const& row) {
+        auto region = row["Region"];
+        auto buildConfig = row["BuildConfig"];
+        auto cdnConfig = row["CDNConfig"];
+        auto buildID = row["BuildId"];
+        auto versionsName = row["VersionsName"];
+        if (!region || !buildConfig || !cdnConfig || !buildID || !versionsName)
             return std::nullopt;
 
         Record rec{ };
-        rec.Region = tokens[0];
-        rec.BuildConfig = tokens[1];
-        rec.CDNConfig = tokens[2];
-        rec.KeyRing = tokens[3];
+        rec.Region = *region;
+        rec.BuildConfig = *buildConfig;
+        rec.CDNConfig = *cdnConfig;
+        rec.KeyRing = row["KeyRing"].value_or("");
 
-        rec.VersionsName = tokens[5];
-        rec.ProductConfig = tokens[6];
+        rec.VersionsName = *versionsName;
+        rec.ProductConfig = row["ProductConfig"].value_or("");
 
-        auto [ptr, ec] = std::from_chars(tokens[4].data(), tokens[4].data() + tokens[4].size(), rec.BuildID);
+        auto [ptr, ec] = std::from_chars(buildID->data(), buildID->data() + buildID->size(), rec.BuildID);
         if (ec != std::errc { })
             return std::nullopt;
 
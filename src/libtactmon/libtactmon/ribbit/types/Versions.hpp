@@ -1,5 +1,7 @@
 #pragma once
 
+#include "libtactmon/ribbit/PSV.hpp"
+
 #include <cstdint>
 #include <optional>
 #include <string>
@@ -16,7 +18,10 @@ namespace libtactmon::ribbit::types {
             std::string VersionsName;
             std::string ProductConfig;
 
-            static std::optional<Record> Parse(std::string_view input);
+            /**
+             * Parses a row of the table, looking columns up by name.
+             */
+            static std::optional<Record> Parse(PSV::Row const& row);
         };
     }
 
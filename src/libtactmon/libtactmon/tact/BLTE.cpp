@@ -1,8 +1,11 @@
 #include "libtactmon/io/IStream.hpp"
+#include "libtactmon/io/SpanReader.hpp"
 #include "libtactmon/tact/BLTE.hpp"
+#include "libtactmon/tact/BLTEDecoder.hpp"
 #include "libtactmon/crypto/Hash.hpp"
 #include "libtactmon/utility/Endian.hpp"
 
+#include <algorithm>
 #include <bit>
 #include <cstdint>
 #include <vector>
@@ -27,13 +30,21 @@ namespace libtactmon::tact {
         return _Parse(fstream, &ekey, &ckey);
     }
 
+    std::optional<BLTE> BLTE::Parse(io::IReadableStream& fstream, tact::EKey const& ekey) {
+        return _Parse(fstream, &ekey, nullptr);
+    }
+
     std::optional<BLTE> BLTE::_Parse(io::IReadableStream& fstream, tact::EKey const* ekey, tact::CKey const* ckey) {
-        uint32_t magic = fstream.Read<uint32_t>(std::endian::big);
+        io::SpanReader reader { fstream, io::AccessPattern::Sequential };
+        if (!reader.CanRead(4 + 4 + 4))
+            return std::nullopt;
+
+        uint32_t magic = reader.Read<uint32_t, std::endian::big>();
         if (magic != 'BLTE')
             return std::nullopt;
 
-        uint32_t headerSize = fstream.Read<uint32_t>(std::endian::big);
-        uint32_t flagsChunkCount = fstream.Read<uint32_t>(std::endian::big);
+        uint32_t headerSize = reader.Read<uint32_t, std::endian::big>();
+        uint32_t flagsChunkCount = reader.Read<uint32_t, std::endian::big>();
 
         // Validate EKey
         crypto::MD5 engine;
@@ -44,15 +55,19 @@ namespace libtactmon::tact {
         uint8_t flags = (flagsChunkCount & 0xFF000000) >> 24;
         uint32_t chunkCount = flagsChunkCount & 0x00FFFFFF;
 
+        if (!reader.CanRead(chunkCount * (4 + 4 + 16)))
+            return std::nullopt;
+
         std::unique_ptr<ChunkHeader[]> chunks = std::make_unique<ChunkHeader[]>(chunkCount);
         
         for (std::size_t i = 0; i < chunkCount; ++i) {
-            chunks[i].CompressedSize = fstream.Read<uint32_t>(std::endian::big);
-            chunks[i].DecompressedSize = fstream.Read<uint32_t>(std::endian::big);
-            fstream.Read(chunks[i].Checksum, std::endian::little);
+            chunks[i].CompressedSize = reader.Read<uint32_t, std::endian::big>();
+            chunks[i].DecompressedSize = reader.Read<uint32_t, std::endian::big>();
+            reader.ReadArray(std::span<uint8_t> { chunks[i].Checksum });
 
-            engine.UpdateData(utility::byteswap(chunks[i].CompressedSize));
-            engine.UpdateData(utility::byteswap(chunks[i].DecompressedSize));
+            // Sizes are hashed as they are stored: 32-bit big endian integers.
+            engine.UpdateData(utility::byteswap(static_cast<uint32_t>(chunks[i].CompressedSize)));
+            engine.UpdateData(utility::byteswap(static_cast<uint32_t>(chunks[i].DecompressedSize)));
             engine.UpdateData(chunks[i].Checksum);
 
             chunks[i].Offset = i == 0
@@ -69,10 +84,21 @@ namespace libtactmon::tact {
             return std::nullopt;
         }
         
+        // The decompressed size of every chunk is known up front; allocate the output once. Sizes from a header that was
+        // not checked against an EKey can be anything, so the allocation is then limited to the size of the input; the
+        // buffer still grows as chunks are decompressed.
+        std::size_t decompressedSize = 0;
+        for (std::size_t i = 0; i < chunkCount; ++i)
+            decompressedSize += chunks[i].DecompressedSize;
+
+        if (ekey == nullptr)
+            decompressedSize = std::min(decompressedSize, reader.size());
+
         BLTE blte { };
+        blte._dataBuffer.Reserve(decompressedSize);
         for (std::size_t i = 0; i < chunkCount; ++i) {
-            fstream.SeekRead(chunks[i].Offset);
-            if (!blte.LoadChunk(fstream, chunks[i].CompressedSize, chunks[i].DecompressedSize, chunks[i].Checksum)) {
+            reader.Seek(chunks[i].Offset);
+            if (!blte.LoadChunk(reader.ReadSpan<uint8_t>(chunks[i].CompressedSize), chunks[i].DecompressedSize, chunks[i].Checksum)) {
                 if (ekey != nullptr)
                     spdlog::critical("Failed to read a chunk from BLTE archive {}: checksum mismatch.", ekey->ToString());
 
@@ -92,12 +118,10 @@ namespace libtactmon::tact {
 
     BLTE::BLTE() = default;
 
-    bool BLTE::LoadChunk(io::IReadableStream& stream, std::size_t compressedSize, std::size_t decompressedSize, std::array<uint8_t, 16> checksum) {
-        if (stream.GetReadCursor() + compressedSize > stream.GetLength())
+    bool BLTE::LoadChunk(std::span<const uint8_t> chunkSpan, std::size_t decompressedSize, std::array<uint8_t, 16> checksum) {
+        if (chunkSpan.empty())
             return false;
 
-        std::span<const uint8_t> chunkSpan = stream.Data<uint8_t>().subspan(0, compressedSize);
-
         // Ensure data matches checksum
         crypto::MD5::Digest digest = crypto::MD5::Of(chunkSpan);
         if (!std::equal(digest.begin(), digest.end(), checksum.begin(), checksum.end()))
@@ -151,8 +175,17 @@ namespace libtactmon::tact {
             }
             case 'F':
             {
-                // Recursive BLTE file. Not implemented.
-                return false;
+                // Recursive BLTE file; its decoded contents make up this chunk.
+                std::size_t writeCursor = _dataBuffer.GetWriteCursor();
+
+                BLTEDecoder decoder { [&](std::span<const uint8_t> data) {
+                    return _dataBuffer.Write(data, std::endian::little) == data.size();
+                } };
+
+                if (!decoder.Feed(std::as_bytes(chunkSpan.subspan(1))) || !decoder.Finish())
+                    return false;
+
+                return _dataBuffer.GetWriteCursor() - writeCursor == decompressedSize;
             }
             default:
                 spdlog::critical("Encountered unsupported encoding mode {} in BLTE archive. See additional information below.", char(chunkSpan[0]));
@@ -3,6 +3,7 @@
 #include <array>
 #include <cstdint>
 #include <optional>
+#include <span>
 
 #include "libtactmon/detail/Export.hpp"
 #include "libtactmon/io/MemoryStream.hpp"
@@ -28,6 +29,19 @@ namespace libtactmon::tact {
          */
         static std::optional<BLTE> Parse(io::IReadableStream& fstream, tact::EKey const& ekey, tact::CKey const& ckey);
 
+        /**
+         * Parses a BLTE archive from the given stream, validating its header against the ekey provided, and returning the
+         * decompressed data stream if successful.
+         *
+         * @param[in] fstream An input stream.
+         * @param[in] ekey    An encoding key.
+         *
+         * @returns The decompressed data stream, or an empty optional if decompression was unsuccessful.
+         *
+         * @remarks This function is not lazy; the contents of the decompressed file are loaded to memory.
+         */
+        static std::optional<BLTE> Parse(io::IReadableStream& fstream, tact::EKey const& ekey);
+
         /**
          * Parses a BLTE archive from the given stream, and returning the decompressed data stream if successful.
          *
@@ -44,7 +58,7 @@ namespace libtactmon::tact {
 
         explicit BLTE();
 
-        bool LoadChunk(io::IReadableStream& stream, std::size_t compressedSize, std::size_t decompressedSize, std::array<uint8_t, 16> checksum);
+        bool LoadChunk(std::span<const uint8_t> chunkSpan, std::size_t decompressedSize, std::array<uint8_t, 16> checksum);
         bool Validate(tact::CKey const& ckey) const;
 
     public:
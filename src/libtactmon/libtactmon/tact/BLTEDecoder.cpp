@@ -0,0 +1,221 @@
+#include "libtactmon/tact/BLTEDecoder.hpp"
+#include "libtactmon/utility/Endian.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include <zlib.h>
+
+#include <spdlog/spdlog.h>
+
+namespace libtactmon::tact {
+    namespace {
+        //! 'BLTE', as a big endian integer.
+        constexpr const uint32_t Signature = 0x424C5445;
+
+        uint32_t ReadBigEndian(uint8_t const* data) {
+            uint32_t value;
+            std::memcpy(&value, data, sizeof(value));
+            return utility::to_endianness<std::endian::native, std::endian::big>(value);
+        }
+    }
+
+    BLTEDecoder::BLTEDecoder(OutputHandler handler) : _handler(std::move(handler)) { }
+
+    BLTEDecoder::BLTEDecoder(OutputHandler handler, tact::EKey const& ekey, tact::CKey const& ckey)
+        : _handler(std::move(handler)), _encodingKey(ekey), _contentKey(ckey)
+    { }
+
+    BLTEDecoder::~BLTEDecoder() = default;
+
+    bool BLTEDecoder::Feed(std::span<const std::byte> data) {
+        if (_state == State::Failed)
+            return false;
+
+        // Reclaim consumed input before growing the buffer.
+        if (_cursor != 0 && _cursor * 2 >= _buffer.size()) {
+            _buffer.erase(_buffer.begin(), _buffer.begin() + _cursor);
+            _cursor = 0;
+        }
+
+        std::size_t offset = _buffer.size();
+        _buffer.resize(offset + data.size());
+        std::memcpy(_buffer.data() + offset, data.data(), data.size());
+
+        if (!Process()) {
+            _state = State::Failed;
+            return false;
+        }
+
+        return true;
+    }
+
+    bool BLTEDecoder::Finish() {
+        if (_state != State::Done)
+            return false;
+
+        if (_contentKey.has_value()) {
+            _contentHash.Finalize();
+            if (*_contentKey != _contentHash.GetDigest()) {
+                if (_encodingKey.has_value())
+                    spdlog::critical("Validation of BLTE archive {} failed: CKey does not match contents checksum.", _encodingKey->ToString());
+
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool BLTEDecoder::Process() {
+        for (;;) {
+            std::span<const uint8_t> input { _buffer.data() + _cursor, _buffer.size() - _cursor };
+
+            switch (_state) {
+                case State::Header:
+                {
+                    if (input.size() < 4 + 4 + 4)
+                        return true;
+
+                    if (ReadBigEndian(input.data()) != Signature)
+                        return false;
+
+                    _headerSize = ReadBigEndian(input.data() + 4);
+                    _state = State::ChunkTable;
+                    break;
+                }
+                case State::ChunkTable:
+                {
+                    uint32_t chunkCount = ReadBigEndian(input.data() + 8) & 0x00FFFFFF;
+                    std::size_t tableSize = 4 + 4 + 4 + std::size_t { chunkCount } * (4 + 4 + 16);
+                    if (chunkCount == 0 || _headerSize < tableSize)
+                        return false;
+
+                    if (input.size() < _headerSize)
+                        return true;
+
+                    if (_encodingKey.has_value()) {
+                        crypto::MD5::Digest checksum = crypto::MD5::Of(input.subspan(0, tableSize));
+                        if (*_encodingKey != checksum) {
+                            spdlog::critical("Validation of BLTE archive {} failed: EKey key does not match header checksum.", _encodingKey->ToString());
+                            return false;
+                        }
+                    }
+
+                    _chunks.resize(chunkCount);
+                    for (std::size_t i = 0; i < chunkCount; ++i) {
+                        uint8_t const* entry = input.data() + 12 + i * (4 + 4 + 16);
+
+                        _chunks[i].CompressedSize = ReadBigEndian(entry);
+                        _chunks[i].DecompressedSize = ReadBigEndian(entry + 4);
+                        std::copy_n(entry + 8, 16, _chunks[i].Checksum.begin());
+                    }
+
+                    _cursor += _headerSize;
+                    _state = State::Chunks;
+                    break;
+                }
+                case State::Chunks:
+                {
+                    if (_nextChunk == _chunks.size()) {
+                        _state = State::Done;
+                        break;
+                    }
+
+                    Chunk const& chunk = _chunks[_nextChunk];
+                    if (input.size() < chunk.CompressedSize)
+                        return true;
+
+                    std::span<const uint8_t> chunkData = input.subspan(0, chunk.CompressedSize);
+                    crypto::MD5::Digest digest = crypto::MD5::Of(chunkData);
+                    if (!std::equal(digest.begin(), digest.end(), chunk.Checksum.begin(), chunk.Checksum.end())) {
+                        if (_encodingKey.has_value())
+                            spdlog::critical("Failed to read a chunk from BLTE archive {}: checksum mismatch.", _encodingKey->ToString());
+
+                        return false;
+                    }
+
+                    // A chunk that does not decode to the size announced by the chunk table fails here rather than at the
+                    // content key check, which only happens once everything was decoded.
+                    std::size_t decodedSize = _decodedSize;
+                    if (!DecodeChunk(chunkData))
+                        return false;
+
+                    if (_decodedSize - decodedSize != chunk.DecompressedSize) {
+                        if (_encodingKey.has_value())
+                            spdlog::critical("Failed to read a chunk from BLTE archive {}: size mismatch.", _encodingKey->ToString());
+
+                        return false;
+                    }
+
+                    _cursor += chunk.CompressedSize;
+                    ++_nextChunk;
+                    break;
+                }
+                case State::Done:
+                    // Trailing bytes are ignored.
+                    _cursor = _buffer.size();
+                    return true;
+                case State::Failed:
+                    return false;
+            }
+        }
+    }
+
+    bool BLTEDecoder::DecodeChunk(std::span<const uint8_t> data) {
+        if (data.empty())
+            return false;
+
+        switch (data[0]) {
+            case 'N':
+                return Emit(data.subspan(1));
+            case 'Z':
+            {
+                z_stream strm { };
+                strm.next_in = const_cast<uint8_t*>(data.data() + 1);
+                strm.avail_in = static_cast<uInt>(data.size() - 1);
+                int ret = inflateInit(&strm);
+                if (ret != Z_OK)
+                    return false;
+
+                // zlib may still hold output once all of the input was consumed, so inflate is called until the stream
+                // ends or no progress can be made; a stream cut short is caught by the size check of the caller.
+                std::array<uint8_t, 64 * 1024> decompressedBuffer;
+                do {
+                    strm.avail_out = decompressedBuffer.size();
+                    strm.next_out = decompressedBuffer.data();
+
+                    ret = inflate(&strm, Z_NO_FLUSH);
+                    if ((ret < 0 && ret != Z_BUF_ERROR) || !Emit(std::span { decompressedBuffer.data(), decompressedBuffer.size() - strm.avail_out })) {
+                        inflateEnd(&strm);
+                        return false;
+                    }
+                } while (ret != Z_STREAM_END && ret != Z_BUF_ERROR);
+
+                inflateEnd(&strm);
+                return true;
+            }
+            case 'F':
+            {
+                // Nested archive; its output is ours.
+                BLTEDecoder nested { [this](std::span<const uint8_t> decoded) { return Emit(decoded); } };
+                return nested.Feed(std::as_bytes(data.subspan(1))) && nested.Finish();
+            }
+            default:
+                spdlog::critical("Encountered unsupported encoding mode {} in BLTE archive.", char(data[0]));
+                return false;
+        }
+    }
+
+    bool BLTEDecoder::Emit(std::span<const uint8_t> data) {
+        if (data.empty())
+            return true;
+
+        if (_contentKey.has_value())
+            _contentHash.UpdateData(data);
+
+        _decodedSize += data.size();
+        return _handler(data);
+    }
+}
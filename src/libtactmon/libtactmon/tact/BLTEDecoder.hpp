@@ -0,0 +1,98 @@
+#pragma once
+
+#include "libtactmon/crypto/Hash.hpp"
+#include "libtactmon/detail/Export.hpp"
+#include "libtactmon/tact/CKey.hpp"
+#include "libtactmon/tact/EKey.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace libtactmon::tact {
+    /**
+     * Decodes a BLTE archive incrementally, as its bytes become available (for instance, while it is being downloaded).
+     * Each chunk is decoded as soon as it was entirely received, and its decoded bytes are handed to a callable; they are
+     * not retained.
+     */
+    struct LIBTACTMON_API BLTEDecoder final {
+        /**
+         * Receives decoded bytes, in order. Returning false aborts decoding.
+         */
+        using OutputHandler = std::function<bool(std::span<const uint8_t>)>;
+
+        explicit BLTEDecoder(OutputHandler handler);
+
+        /**
+         * Creates a decoder that validates the archive against an encoding key and a content key.
+         */
+        BLTEDecoder(OutputHandler handler, tact::EKey const& ekey, tact::CKey const& ckey);
+
+        BLTEDecoder(BLTEDecoder const&) = delete;
+        BLTEDecoder& operator = (BLTEDecoder const&) = delete;
+
+        ~BLTEDecoder();
+
+        /**
+         * Consumes bytes of the archive.
+         *
+         * @returns false if the archive is malformed, if a checksum does not match, or if the output handler aborted
+         *          decoding. Once this happened, every call fails.
+         */
+        bool Feed(std::span<const std::byte> data);
+
+        /**
+         * Signals that the entire archive was fed to this decoder.
+         *
+         * @returns true if every chunk was decoded and, if keys were provided, the archive was validated.
+         */
+        bool Finish();
+
+        /**
+         * Returns the amount of decoded bytes produced so far.
+         */
+        [[nodiscard]] std::size_t decodedSize() const { return _decodedSize; }
+
+    private:
+        enum class State {
+            Header,
+            ChunkTable,
+            Chunks,
+            Done,
+            Failed
+        };
+
+        struct Chunk {
+            uint32_t CompressedSize = 0;
+            uint32_t DecompressedSize = 0;
+            std::array<uint8_t, 16> Checksum;
+        };
+
+        /**
+         * Processes as much of the buffered input as possible.
+         */
+        bool Process();
+        bool DecodeChunk(std::span<const uint8_t> data);
+        bool Emit(std::span<const uint8_t> data);
+
+        OutputHandler _handler;
+        std::optional<tact::EKey> _encodingKey;
+        std::optional<tact::CKey> _contentKey;
+        crypto::MD5 _contentHash;
+
+        State _state = State::Header;
+        uint32_t _headerSize = 0;
+        std::vector<Chunk> _chunks;
+        std::size_t _nextChunk = 0;
+        std::size_t _decodedSize = 0;
+
+        //! Input not consumed yet starts at _cursor.
+        std::vector<uint8_t> _buffer;
+        std::size_t _cursor = 0;
+    };
+}
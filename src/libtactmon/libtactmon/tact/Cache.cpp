@@ -1,7 +1,14 @@
 #include "libtactmon/tact/Cache.hpp"
 
 namespace libtactmon::tact {
-    Cache::Cache(const std::filesystem::path& root) : _root(root) {
+    Cache::Cache(const std::filesystem::path& root) : _root(root), _files(std::make_unique<io::AsyncFileService>()) {
+        if (!std::filesystem::is_directory(root))
+            std::filesystem::create_directories(root);
+    }
+
+    Cache::Cache(const std::filesystem::path& root, boost::asio::any_io_executor executor)
+        : _root(root), _files(std::make_unique<io::AsyncFileService>(std::move(executor)))
+    {
         if (!std::filesystem::is_directory(root))
             std::filesystem::create_directories(root);
     }
@@ -28,4 +35,21 @@ namespace libtactmon::tact {
     void Cache::Delete(std::string_view relativePath) const {
         std::filesystem::remove(GetAbsolutePath(relativePath));
     }
+
+    boost::future<io::AsyncFileService::ReadResult> Cache::ReadAsync(std::string_view relativePath) const {
+        return _files->ReadFile(GetAbsolutePath(relativePath));
+    }
+
+    std::vector<boost::future<io::AsyncFileService::ReadResult>> Cache::ReadAsync(std::span<const std::string> relativePaths) const {
+        std::vector<std::filesystem::path> absolutePaths;
+        absolutePaths.reserve(relativePaths.size());
+        for (std::string const& relativePath : relativePaths)
+            absolutePaths.push_back(GetAbsolutePath(relativePath));
+
+        return _files->ReadFiles(absolutePaths);
+    }
+
+    boost::future<bool> Cache::WriteAsync(std::string_view relativePath, std::vector<std::byte> data) const {
+        return _files->WriteFile(GetAbsolutePath(relativePath), std::move(data));
+    }
 }
@@ -1,12 +1,21 @@
 #pragma once
 
 #include "libtactmon/detail/Export.hpp"
+#include "libtactmon/io/AsyncFileService.hpp"
 #include "libtactmon/io/FileStream.hpp"
 
+#include <cstddef>
 #include <filesystem>
 #include <functional>
+#include <memory>
 #include <optional>
+#include <span>
+#include <string>
 #include <string_view>
+#include <vector>
+
+#include <boost/asio/any_io_executor.hpp>
+#include <boost/thread/future.hpp>
 
 namespace libtactmon::tact {
     /**
@@ -20,6 +29,14 @@ namespace libtactmon::tact {
          */
         explicit Cache(const std::filesystem::path& root);
 
+        /**
+         * Construct a cache with its root located at a provided path on disk.
+         *
+         * @param[in] root     Root of the cache on disk.
+         * @param[in] executor The executor on which completion handlers of asynchronous file operations are invoked.
+         */
+        Cache(const std::filesystem::path& root, boost::asio::any_io_executor executor);
+
         /**
          * Resolves a resource on disk.
          *
@@ -37,7 +54,8 @@ namespace libtactmon::tact {
                 return std::nullopt;
 
             try {
-                io::FileStream fstream { fullResourcePath };
+                // Parsers advise the stream of their access pattern; manifests are large enough to benefit from huge pages.
+                io::FileStream fstream { fullResourcePath, io::FileMappingOptions { .HugePages = true } };
                 return handler(fstream);
             } catch (std::exception const& ex) {
                 Delete(resourcePath);
@@ -71,7 +89,38 @@ namespace libtactmon::tact {
          */
         void Delete(std::string_view relativePath) const;
 
+        /**
+         * Reads a file from the cache asynchronously.
+         *
+         * @param[in] relativePath Relative path to the file.
+         * @returns A future holding the contents of the file, or an empty optional if it could not be read.
+         */
+        [[nodiscard]] boost::future<io::AsyncFileService::ReadResult> ReadAsync(std::string_view relativePath) const;
+
+        /**
+         * Reads several files from the cache asynchronously. All reads are submitted at once.
+         *
+         * @param[in] relativePaths Relative paths to the files.
+         * @returns One future per file, in the same order as @p relativePaths.
+         */
+        [[nodiscard]] std::vector<boost::future<io::AsyncFileService::ReadResult>> ReadAsync(std::span<const std::string> relativePaths) const;
+
+        /**
+         * Writes a file to the cache asynchronously, replacing it if it exists.
+         *
+         * @param[in] relativePath Relative path to the file.
+         * @param[in] data         The contents of the file.
+         * @returns A future holding true if the file was written.
+         */
+        boost::future<bool> WriteAsync(std::string_view relativePath, std::vector<std::byte> data) const;
+
+        /**
+         * Returns the service performing asynchronous file operations for this cache.
+         */
+        [[nodiscard]] io::AsyncFileService& files() const { return *_files; }
+
     private:
         std::filesystem::path _root;
+        std::unique_ptr<io::AsyncFileService> _files;
     };
 }
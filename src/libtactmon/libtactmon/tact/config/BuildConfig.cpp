@@ -2,9 +2,10 @@
 #include "libtactmon/tact/config/BuildConfig.hpp"
 #include "libtactmon/io/IReadableStream.hpp"
 
+#include <array>
 #include <charconv>
+#include <span>
 #include <string_view>
-#include <vector>
 
 using namespace std::string_view_literals;
 
@@ -12,14 +13,14 @@ namespace libtactmon::tact::config {
     struct ConfigHandler {
         std::string_view Token;
 
-        using HandlerType = bool(*)(BuildConfig&, std::vector<std::string_view>);
+        using HandlerType = bool(*)(BuildConfig&, std::span<const std::string_view>);
         HandlerType Handler;
     };
 
     // Not all properties are modeled here.
     static const ConfigHandler Handlers[] = {
         { "root",
-            [](BuildConfig& cfg, std::vector<std::string_view> tokens) {
+            [](BuildConfig& cfg, std::span<const std::string_view> tokens) {
                 if (tokens.size() != 2)
                     return false;
 
@@ -29,20 +30,20 @@ namespace libtactmon::tact::config {
                 return true;
             }
         }, { "install",
-            [](BuildConfig& cfg, std::vector<std::string_view> tokens) {
+            [](BuildConfig& cfg, std::span<const std::string_view> tokens) {
                 if (tokens.size() != 3 && tokens.size() != 2)
                     return false;
 
                 if (!CKey::TryParse(tokens[1], cfg.Install.Key.ContentKey))
                     return false;
 
-                if (!EKey::TryParse(tokens[2], cfg.Install.Key.EncodingKey))
+                if (tokens.size() == 3 && !EKey::TryParse(tokens[2], cfg.Install.Key.EncodingKey))
                     return false;
 
                 return true;
             }
         }, { "install-size",
-            [](BuildConfig& cfg, std::vector<std::string_view> tokens) {
+            [](BuildConfig& cfg, std::span<const std::string_view> tokens) {
                 if (tokens.size() != 3 && tokens.size() != 2)
                     return false;
 
@@ -61,20 +62,20 @@ namespace libtactmon::tact::config {
                 return true;
             }
         }, { "encoding", 
-            [](BuildConfig& cfg, std::vector<std::string_view> tokens) {
+            [](BuildConfig& cfg, std::span<const std::string_view> tokens) {
                 if (tokens.size() != 3 && tokens.size() != 2)
                     return false;
 
                 if (!CKey::TryParse(tokens[1], cfg.Encoding.Key.ContentKey))
                     return false;
 
-                if (!EKey::TryParse(tokens[2], cfg.Encoding.Key.EncodingKey))
+                if (tokens.size() == 3 && !EKey::TryParse(tokens[2], cfg.Encoding.Key.EncodingKey))
                     return false;
 
                 return true;
             }
         }, { "encoding-size",
-            [](BuildConfig& cfg, std::vector<std::string_view> tokens) {
+            [](BuildConfig& cfg, std::span<const std::string_view> tokens) {
                 if (tokens.size() != 3 && tokens.size() != 2)
                     return false;
 
@@ -93,7 +94,7 @@ namespace libtactmon::tact::config {
                 return true;
             }
         }, { "build-name",
-            [](BuildConfig& cfg, std::vector<std::string_view> tokens) {
+            [](BuildConfig& cfg, std::span<const std::string_view> tokens) {
                 if (tokens.size() != 2)
                     return false;
 
@@ -107,24 +108,31 @@ namespace libtactmon::tact::config {
         stream.SeekRead(0);
         
         std::string_view contents { stream.Data<char>().data(), stream.GetLength() };
-        std::vector<std::string_view> lines = libtactmon::detail::Tokenize(contents, '\n', false);
-        if (lines.empty())
+        if (contents.empty())
             return std::nullopt;
 
         BuildConfig config { };
 
-        for (std::string_view line : lines) {
+        for (std::string_view line : libtactmon::detail::Split(contents, '\n', true)) {
             if (line[0] == '#')
                 continue;
 
-            static const char Separators[] = { ' ', '=' };
-            std::vector<std::string_view> tokens = libtactmon::detail::Tokenize(line, std::span { Separators }, true);
+            auto tokens = libtactmon::detail::Split(line, " =", true);
+            auto token = tokens.begin();
+            if (token == tokens.end())
+                continue;
 
             for (auto&& handler : Handlers) {
-                if (tokens[0] != handler.Token)
+                if (*token != handler.Token)
                     continue;
 
-                if (!handler.Handler(config, std::move(tokens)))
+                // Modeled properties have at most three tokens; handlers reject longer lines.
+                std::array<std::string_view, 4> values;
+                std::size_t valueCount = 0;
+                for (; token != tokens.end() && valueCount < values.size(); ++token)
+                    values[valueCount++] = *token;
+
+                if (!handler.Handler(config, std::span { values.data(), valueCount }))
                     return std::nullopt;
                 break;
             }
@@ -3,9 +3,7 @@
 #include "libtactmon/io/IReadableStream.hpp"
 
 #include <charconv>
-#include <functional>
 #include <string_view>
-#include <vector>
 
 using namespace std::string_view_literals;
 
@@ -14,48 +12,54 @@ namespace libtactmon::tact::config {
         stream.SeekRead(0);
 
         std::string_view contents { stream.Data<char>().data(), stream.GetLength() };
-        std::vector<std::string_view> lines = detail::Tokenize(contents, '\n', true);
-
-        if (lines.empty())
+        if (contents.empty())
             return std::nullopt;
 
         CDNConfig config;
-        for (std::string_view line : lines) {
+        for (std::string_view line : detail::Split(contents, '\n', true)) {
             if (line[0] == '#')
                 continue;
 
-            static const char Separators[] = { ' ', '=' };
-            std::vector<std::string_view> tokens = detail::Tokenize(line, std::span { Separators }, true);
+            auto tokens = detail::Split(line, " =", true);
+            auto token = tokens.begin();
+            if (token == tokens.end())
+                continue;
 
-            if (tokens[0] == "archives") {
-                config.archives.resize(tokens.size() - 1);
-                for (std::size_t i = 1; i < tokens.size(); ++i)
-                    config.archives[i - 1].Name = tokens[i];
+            std::string_view key = *token++;
+            if (key == "archives") {
+                // Thousands of archives are listed on a single line.
+                for (; token != tokens.end(); ++token)
+                    config.archives.emplace_back().Name = *token;
             }
-            else if (tokens[0] == "archives-index-size") {
-                for (std::size_t i = 1; i < tokens.size(); ++i) {
-                    auto [ptr, ec] = std::from_chars(tokens[i].data(), tokens[i].data() + tokens[i].size(), config.archives[i - 1].Size);
+            else if (key == "archives-index-size") {
+                for (std::size_t i = 0; token != tokens.end(); ++token, ++i) {
+                    if (i >= config.archives.size())
+                        return std::nullopt;
+
+                    std::string_view size = *token;
+                    auto [ptr, ec] = std::from_chars(size.data(), size.data() + size.size(), config.archives[i].Size);
                     if (ec != std::errc{ })
                         return std::nullopt;
                 }
             }
-            else if (tokens[0] == "file-index") {
-                if (tokens.size() == 1)
+            else if (key == "file-index") {
+                if (token == tokens.end())
                     return std::nullopt;
 
                 if (!config.fileIndex.has_value())
                     config.fileIndex.emplace();
 
-                config.fileIndex->Name = tokens[1];
+                config.fileIndex->Name = *token;
             }
-            else if (tokens[0] == "file-index-size") {
-                if (tokens.size() == 1)
+            else if (key == "file-index-size") {
+                if (token == tokens.end())
                     return std::nullopt;
 
                 if (!config.fileIndex.has_value())
                     config.fileIndex.emplace();
 
-                auto [ptr, ec] = std::from_chars(tokens[1].data(), tokens[1].data() + tokens[1].size(), config.fileIndex->Size);
+                std::string_view size = *token;
+                auto [ptr, ec] = std::from_chars(size.data(), size.data() + size.size(), config.fileIndex->Size);
                 if (ec != std::errc{ })
                     return std::nullopt;
             }
@@ -1,50 +1,40 @@
 #include "libtactmon/io/IReadableStream.hpp"
 #include "libtactmon/tact/data/Encoding.hpp"
 
-#include <array>
 #include <memory>
 
 #include <assert.hpp>
 
 namespace libtactmon::tact::data {
-    uint64_t ReadUInt40(io::IReadableStream& stream, std::endian endianness) {
-        std::array<uint8_t, 5> bytes;
-        stream.Read(std::span<uint8_t> { bytes.data(), 5 }, endianness);
-
-        uint64_t value = 0;
-        for (uint8_t byte : bytes)
-            value = (value << 8) | byte;
-        return value;
-    }
-
-    Encoding::Header::Header(io::IReadableStream& stream) {
-        if (!stream.CanRead(2 + 1 + 1 + 1 + 2 + 2 + 4 + 4 + 1 + 4))
+    Encoding::Header::Header(io::SpanReader& reader) {
+        if (!reader.CanRead(2 + 1 + 1 + 1 + 2 + 2 + 4 + 4 + 1 + 4))
             return;
 
-        Signature          = stream.Read<uint16_t>(std::endian::big);
-        Version            = stream.Read<uint8_t>();
-        EncodingKeySize    = stream.Read<uint8_t>();
-        ContentKeySize     = stream.Read<uint8_t>();
-        CEKey.PageSize     = stream.Read<uint16_t>(std::endian::big) * 1024;
-        EKeySpec.PageSize  = stream.Read<uint16_t>(std::endian::big) * 1024;
-        CEKey.PageCount    = stream.Read<uint32_t>(std::endian::big);
-        EKeySpec.PageCount = stream.Read<uint32_t>(std::endian::big);
-        uint8_t unknown    = stream.Read<uint8_t>(); // Asserted to be zero by agent.
+        Signature          = reader.Read<uint16_t, std::endian::big>();
+        Version            = reader.Read<uint8_t>();
+        EncodingKeySize    = reader.Read<uint8_t>();
+        ContentKeySize     = reader.Read<uint8_t>();
+        CEKey.PageSize     = reader.Read<uint16_t, std::endian::big>() * 1024;
+        EKeySpec.PageSize  = reader.Read<uint16_t, std::endian::big>() * 1024;
+        CEKey.PageCount    = reader.Read<uint32_t, std::endian::big>();
+        EKeySpec.PageCount = reader.Read<uint32_t, std::endian::big>();
+        uint8_t unknown    = reader.Read<uint8_t>(); // Asserted to be zero by agent.
         DEBUG_ASSERT(unknown == 0, "Encoding header unknown has to be zero");
-        ESpecBlockSize     = stream.Read<uint32_t>(std::endian::big);
+        ESpecBlockSize     = reader.Read<uint32_t, std::endian::big>();
     }
 
-    Encoding::CEKeyPageTable::CEKeyPageTable(io::IReadableStream& stream, Header const& header)
+    Encoding::CEKeyPageTable::CEKeyPageTable(io::SpanReader& reader, Header const& header)
     {
-        _keyCount = stream.Read<uint8_t>();
-        _fileSize = ReadUInt40(stream, std::endian::big);
+        _keyCount = reader.Read<uint8_t>();
+        _fileSize = reader.ReadUInt<std::endian::big>(5);
 
         _ckey.resize(header.ContentKeySize);
-        stream.Read(std::span { _ckey }, std::endian::little);
+        reader.ReadArray(std::span { _ckey });
 
         if (_keyCount * header.EncodingKeySize > 0) {
             _ekeys.resize(header.EncodingKeySize * _keyCount);
-            stream.Read(std::span { _ekeys }, std::endian::little);
+            if (!reader.ReadArray(std::span { _ekeys }))
+                _ekeys.clear();
         }
     }
 
@@ -105,16 +95,16 @@ namespace libtactmon::tact::data {
         return !_ekey.empty();
     }
 
-    Encoding::EKeySpecPageTable::EKeySpecPageTable(io::IReadableStream& stream, Header const& header) {
+    Encoding::EKeySpecPageTable::EKeySpecPageTable(io::SpanReader& reader, Header const& header) {
         std::size_t encodingKeySize = HashSize(header);
-        if (!stream.CanRead(encodingKeySize + 4 + 5))
+        if (!reader.CanRead(encodingKeySize + 4 + 5))
             return;
 
         _ekey.resize(encodingKeySize);
-        stream.Read(std::span { _ekey.data(), encodingKeySize }, std::endian::little);
+        reader.ReadArray(std::span { _ekey.data(), encodingKeySize });
 
-        _especIndex = stream.Read<uint32_t>(std::endian::big);
-        _fileSize = ReadUInt40(stream, std::endian::big);
+        _especIndex = reader.Read<uint32_t, std::endian::big>();
+        _fileSize = reader.ReadUInt<std::endian::big>(5);
     }
 
     /* static */ std::size_t Encoding::EKeySpecPageTable::HashSize(Header const& header) {
@@ -123,13 +113,16 @@ namespace libtactmon::tact::data {
 
     // ^^^ EKeySpecPageTable / Encoding vvv
 
-    Encoding::Encoding(io::IReadableStream& stream) : _header{ stream } {
+    Encoding::Encoding(io::IReadableStream& stream) : Encoding(io::SpanReader { stream, io::AccessPattern::Sequential }) {
+    }
+
+    Encoding::Encoding(io::SpanReader reader) : _header{ reader } {
         if (_header.Signature != 0x454E)
             return;
 
-        stream.SkipRead(_header.ESpecBlockSize); // Skip ESpec strings
+        reader.Skip(_header.ESpecBlockSize); // Skip ESpec strings
 
-        std::size_t pageStart = stream.GetReadCursor() + static_cast<std::size_t>(_header.CEKey.PageCount) * (0x10uLL + _header.EncodingKeySize);
+        std::size_t pageStart = reader.cursor() + static_cast<std::size_t>(_header.CEKey.PageCount) * (0x10uLL + _header.EncodingKeySize);
 
         _cekeyPages.reserve(_header.CEKey.PageCount);
 
@@ -137,10 +130,15 @@ namespace libtactmon::tact::data {
             std::size_t pageOffset = pageStart + i * _header.CEKey.PageSize;
             std::size_t pageEnd = pageOffset + _header.CEKey.PageSize;
 
-            _cekeyPages.emplace_back(stream, _header, pageOffset, pageEnd);
+            _cekeyPages.emplace_back(reader, _header, pageOffset, pageEnd);
         }
     }
 
+    Encoding::Encoding(Header header, std::vector<Page<CEKeyPageTable, false>> cekeyPages)
+        : _header(header), _cekeyPages(std::move(cekeyPages))
+    {
+    }
+
     Encoding::Encoding(Encoding&& other) noexcept
         : _header(other._header), _cekeyPages(std::move(other._cekeyPages)), _keySpecPageTables(std::move(other._keySpecPageTables))
     {
@@ -179,4 +177,114 @@ namespace libtactmon::tact::data {
 
         return std::nullopt;
     }
+
+    // ^^^ Encoding / Encoding::Parser vvv
+
+    namespace {
+        constexpr std::size_t HeaderSize = 2 + 1 + 1 + 1 + 2 + 2 + 4 + 4 + 1 + 4;
+    }
+
+    Encoding::Parser::Parser() = default;
+    Encoding::Parser::~Parser() = default;
+
+    Encoding::Parser::Parser(Parser&& other) noexcept = default;
+    Encoding::Parser& Encoding::Parser::operator = (Parser&& other) noexcept = default;
+
+    bool Encoding::Parser::Feed(std::span<const uint8_t> data) {
+        if (_state == State::Done)
+            return true;
+
+        // Reclaim consumed input before growing the buffer.
+        if (_cursor != 0 && _cursor * 2 >= _buffer.size()) {
+            _buffer.erase(_buffer.begin(), _buffer.begin() + _cursor);
+            _cursor = 0;
+        }
+
+        _buffer.insert(_buffer.end(), data.begin(), data.end());
+        return Process();
+    }
+
+    bool Encoding::Parser::Process() {
+        for (;;) {
+            std::span<const std::byte> input = std::as_bytes(std::span { _buffer }).subspan(_cursor);
+
+            switch (_state) {
+                case State::Header:
+                {
+                    if (input.size() < HeaderSize)
+                        return true;
+
+                    io::SpanReader reader { input };
+                    _header.emplace(reader);
+                    if (_header->Signature != 0x454E || _header->CEKey.PageSize == 0)
+                        return false;
+
+                    _cursor += HeaderSize;
+                    _state = State::ESpec;
+                    break;
+                }
+                case State::ESpec:
+                {
+                    // ESpec strings are not used.
+                    if (input.size() < _header->ESpecBlockSize)
+                        return true;
+
+                    _cursor += _header->ESpecBlockSize;
+                    _state = State::PageIndex;
+                    break;
+                }
+                case State::PageIndex:
+                {
+                    std::size_t indexSize = static_cast<std::size_t>(_header->CEKey.PageCount) * (0x10uLL + _header->EncodingKeySize);
+                    if (input.size() < indexSize)
+                        return true;
+
+                    _pageIndex.assign(_buffer.begin() + _cursor, _buffer.begin() + _cursor + indexSize);
+                    _pages.reserve(_header->CEKey.PageCount);
+
+                    _cursor += indexSize;
+                    _state = State::Pages;
+                    break;
+                }
+                case State::Pages:
+                {
+                    if (_pages.size() == _header->CEKey.PageCount) {
+                        _state = State::Done;
+                        break;
+                    }
+
+                    if (input.size() < _header->CEKey.PageSize)
+                        return true;
+
+                    // Pages expect to be preceded by their entry in the page index.
+                    std::size_t entrySize = 0x10uLL + _header->EncodingKeySize;
+                    std::vector<uint8_t> page;
+                    page.reserve(entrySize + _header->CEKey.PageSize);
+                    page.insert(page.end(), _pageIndex.begin() + _pages.size() * entrySize, _pageIndex.begin() + (_pages.size() + 1) * entrySize);
+                    page.insert(page.end(), _buffer.begin() + _cursor, _buffer.begin() + _cursor + _header->CEKey.PageSize);
+
+                    io::SpanReader reader { std::as_bytes(std::span { page }) };
+                    _pages.emplace_back(reader, *_header, entrySize, entrySize + _header->CEKey.PageSize);
+
+                    _cursor += _header->CEKey.PageSize;
+                    break;
+                }
+                case State::Done:
+                {
+                    // The remainder of the manifest is not used.
+                    _buffer.clear();
+                    _cursor = 0;
+                    return true;
+                }
+            }
+        }
+    }
+
+    std::optional<Encoding> Encoding::Parser::Finish() {
+        if (_state != State::Done && !(_state == State::Pages && _pages.size() == _header->CEKey.PageCount))
+            return std::nullopt;
+
+        _state = State::Done;
+        return Encoding { *_header, std::move(_pages) };
+    }
 }
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "libtactmon/detail/Export.hpp"
+#include "libtactmon/io/SpanReader.hpp"
 #include "libtactmon/tact/CKey.hpp"
 #include "libtactmon/tact/EKey.hpp"
 #include "libtactmon/tact/data/FileLocation.hpp"
@@ -17,6 +18,8 @@ namespace libtactmon::io {
 
 namespace libtactmon::tact::data {
     struct LIBTACTMON_API Encoding final {
+        struct Parser;
+
         explicit Encoding(io::IReadableStream& stream);
         Encoding(Encoding&& other) noexcept;
 
@@ -32,6 +35,8 @@ namespace libtactmon::tact::data {
         [[nodiscard]] std::optional<tact::data::FileLocation> FindFile(tact::CKey const& ckey) const;
 
     private:
+        explicit Encoding(io::SpanReader reader);
+
         struct Empty { };
 
         struct Header {
@@ -45,7 +50,7 @@ namespace libtactmon::tact::data {
             uint32_t ContentKeySize = 0;
             uint32_t ESpecBlockSize = 0;
 
-            explicit Header(io::IReadableStream& stream);
+            explicit Header(io::SpanReader& reader);
         };
 
 
@@ -53,31 +58,31 @@ namespace libtactmon::tact::data {
         struct Page {
             Page() = default;
 
-            Page(io::IReadableStream& stream, Header const& header, std::size_t pageOffset, std::size_t pageEnd) {
+            Page(io::SpanReader& reader, Header const& header, std::size_t pageOffset, std::size_t pageEnd) {
                 std::size_t hashSize = T::HashSize(header);
 
                 if constexpr (!Indexed) {
-                    stream.SkipRead(hashSize + 0x10);
+                    reader.Skip(hashSize + 0x10);
                 }
                 else {
                     _index = std::make_unique<uint8_t[]>(hashSize + 0x10);
-                    stream.Read(std::span{ _index.get(), hashSize + 0x10 }, std::endian::little);
+                    reader.ReadArray(std::span { _index.get(), hashSize + 0x10 });
                 }
 
-                std::size_t position = stream.GetReadCursor();
-                stream.SeekRead(pageOffset);
+                // Pages are parsed through their own reader so that the page index cursor is left untouched.
+                io::SpanReader pageReader { reader };
+                pageReader.Seek(pageOffset);
 
-                while (stream.GetReadCursor() < pageEnd) {
-                    T pageEntry { stream, header };
+                while (pageReader.cursor() < pageEnd && pageReader.remaining() != 0) {
+                    T pageEntry { pageReader, header };
                     // Stop if the entry read was mostly padding bytes, or if we read past the end of the page in the process (alignment bytes)
-                    if (!pageEntry || stream.GetReadCursor() > pageEnd)
+                    if (!pageEntry || pageReader.cursor() > pageEnd)
                         break;
 
                     _entries.emplace_back(std::move(pageEntry));
                 }
 
                 _entries.shrink_to_fit();
-                stream.SeekRead(position);
             }
 
             [[nodiscard]] T const& operator [] (std::size_t index) const { return _entries.at(index); }
@@ -94,7 +99,7 @@ namespace libtactmon::tact::data {
         };
 
         struct CEKeyPageTable final {
-            CEKeyPageTable(io::IReadableStream& stream, Header const& header);
+            CEKeyPageTable(io::SpanReader& reader, Header const& header);
             CEKeyPageTable(CEKeyPageTable&& other) noexcept;
 
             CEKeyPageTable& operator = (CEKeyPageTable&& other) noexcept;
@@ -119,7 +124,7 @@ namespace libtactmon::tact::data {
         };
 
         struct EKeySpecPageTable final {
-            EKeySpecPageTable(io::IReadableStream& stream, Header const& header);
+            EKeySpecPageTable(io::SpanReader& reader, Header const& header);
             EKeySpecPageTable(EKeySpecPageTable&& other) noexcept;
 
             EKeySpecPageTable& operator = (EKeySpecPageTable&& other) noexcept;
@@ -134,9 +139,58 @@ namespace libtactmon::tact::data {
             uint64_t _fileSize = 0;   // Of the encoded version of the file.
         };
 
+        Encoding(Header header, std::vector<Page<CEKeyPageTable, false>> cekeyPages);
+
         Header _header;
 
         std::vector<Page<CEKeyPageTable, false>> _cekeyPages;
         std::vector<Page<EKeySpecPageTable, false>> _keySpecPageTables;
     };
+
+    /**
+     * Parses an encoding manifest incrementally, as its decoded bytes become available (see @ref tact::BLTEDecoder). Each
+     * page of content keys is parsed as soon as it was entirely received.
+     */
+    struct LIBTACTMON_API Encoding::Parser final {
+        Parser();
+        ~Parser();
+
+        Parser(Parser&& other) noexcept;
+        Parser& operator = (Parser&& other) noexcept;
+
+        /**
+         * Consumes bytes of the manifest.
+         *
+         * @returns false if the data is not an encoding manifest.
+         */
+        bool Feed(std::span<const uint8_t> data);
+
+        /**
+         * Returns the manifest, or an empty optional if it was not entirely received.
+         */
+        std::optional<Encoding> Finish();
+
+    private:
+        enum class State {
+            Header,
+            ESpec,
+            PageIndex,
+            Pages,
+            Done
+        };
+
+        /**
+         * Processes as much of the buffered input as possible.
+         */
+        bool Process();
+
+        State _state = State::Header;
+        std::optional<Header> _header;
+        std::vector<uint8_t> _pageIndex;
+        std::vector<Page<CEKeyPageTable, false>> _pages;
+
+        //! Input not consumed yet starts at _cursor.
+        std::vector<uint8_t> _buffer;
+        std::size_t _cursor = 0;
+    };
 }
@@ -1,8 +1,11 @@
 #include "libtactmon/crypto/Hash.hpp"
 #include "libtactmon/io/IReadableStream.hpp"
+#include "libtactmon/io/SpanReader.hpp"
 #include "libtactmon/tact/data/Index.hpp"
 #include "libtactmon/utility/Hex.hpp"
 
+#include <algorithm>
+
 namespace libtactmon::tact::data {
     Index::Index(std::string_view hash, io::IReadableStream& stream)
         : _archiveName(hash), _keySizeBytes(0)
@@ -10,15 +13,24 @@ namespace libtactmon::tact::data {
         std::vector<uint8_t> hashBytes(hash.size() / 2u, 0x00);
         libtactmon::utility::unhex(hash, std::span { hashBytes });
 
+        // The footer is read first, followed by every block in order.
+        std::size_t maxFooterSize = 0x10 * 2 + sizeof(uint8_t) * 8 + sizeof(uint32_t);
+        stream.Prefetch(stream.GetLength() - std::min(stream.GetLength(), maxFooterSize), maxFooterSize);
+
+        stream.SeekRead(0);
+        io::SpanReader reader { stream, io::AccessPattern::Sequential };
+
         std::size_t checksumSize = 0x10;
         while (checksumSize > 0) {
             std::size_t footerSize = checksumSize * 2 + sizeof(uint8_t) * 8 + sizeof(uint32_t);
-
-            stream.SeekRead(stream.GetLength() - footerSize);
-            if (!stream.CanRead(footerSize)) // Protect against underflow
+            if (footerSize > reader.size()) { // Protect against underflow
+                --checksumSize;
                 continue;
+            }
 
-            std::span<const uint8_t> footerData = stream.Data<uint8_t>().subspan(0, footerSize);
+            reader.Seek(reader.size() - footerSize);
+
+            std::span<const uint8_t> footerData = reader.Data<uint8_t>().subspan(0, footerSize);
             auto digest = crypto::MD5::Of(footerData);
 
             if (std::equal(hashBytes.begin(), hashBytes.end(), digest.begin(), digest.end()))
@@ -32,21 +44,20 @@ namespace libtactmon::tact::data {
             return;
 
         std::size_t footerSize = checksumSize * 2 + sizeof(uint8_t) * 8 + sizeof(uint32_t);
-        stream.SeekRead(stream.GetLength() - footerSize);
+        reader.Seek(reader.size() - footerSize);
 
         // Read footer
-        std::span<const uint8_t> tocHash = stream.Data<uint8_t>().subspan(0, checksumSize);
-        stream.SkipRead(checksumSize);
-
-        uint8_t version = stream.Read<uint8_t>();
-        uint8_t _11 = stream.Read<uint8_t>();
-        uint8_t _12 = stream.Read<uint8_t>();
-        uint8_t blockSizeKb = stream.Read<uint8_t>();
-        uint8_t offsetBytes = stream.Read<uint8_t>();
-        uint8_t sizeBytes = stream.Read<uint8_t>();
-        _keySizeBytes = stream.Read<uint8_t>();
-        stream.Read<uint8_t>(); // checksumSize, validate!
-        uint32_t numElements = stream.Read<uint32_t>();
+        std::span<const uint8_t> tocHash = reader.ReadSpan<uint8_t>(checksumSize);
+
+        uint8_t version = reader.Read<uint8_t>();
+        uint8_t _11 = reader.Read<uint8_t>();
+        uint8_t _12 = reader.Read<uint8_t>();
+        uint8_t blockSizeKb = reader.Read<uint8_t>();
+        uint8_t offsetBytes = reader.Read<uint8_t>();
+        uint8_t sizeBytes = reader.Read<uint8_t>();
+        _keySizeBytes = reader.Read<uint8_t>();
+        reader.Skip(sizeof(uint8_t)); // checksumSize, validate!
+        uint32_t numElements = reader.Read<uint32_t>();
         // We don't read the footer checksum (but probably should)
         // > footerChecksum is calculated over the footer beginning with version when footerChecksum is zeroed
         //   ????
@@ -60,7 +71,7 @@ namespace libtactmon::tact::data {
         // Compute block count. Integrate a block's data in the TOC to do the math, since there is only one
         // TOC entry per block (well, technically, two entries; one corresponding to the last EKey of a block,
         // and one corresponding to the lower part of the MD5 of a block)
-        std::size_t blockCount = (stream.GetLength() - footerSize) / (blockSize + (_keySizeBytes + checksumSize));
+        std::size_t blockCount = (reader.size() - footerSize) / (blockSize + (_keySizeBytes + checksumSize));
 
         // Block data is stored flattened.
         // We collapse all the encoding keys in a single buffer, and just index into it when keying the file entries.
@@ -69,22 +80,21 @@ namespace libtactmon::tact::data {
         _keyBuffer.reserve(entryCount * _keySizeBytes * blockCount);
 
         for (std::size_t i = 0; i < blockCount; ++i) {
-            stream.SeekRead(i * blockSize);
-            std::span<const uint8_t> rawBlockData = stream.Data<uint8_t>().subspan(0, blockSize);
+            reader.Seek(i * blockSize);
+            std::span<const uint8_t> rawBlockData = reader.Data<uint8_t>().subspan(0, blockSize);
 
             // Skip over TOC's first array, effectively getting to the block hash of this block
-            stream.SeekRead(blockCount * blockSize + blockCount * _keySizeBytes + i * checksumSize);
-            std::span<const uint8_t> checksum = stream.Data<uint8_t>().subspan(0, checksumSize);
+            reader.Seek(blockCount * blockSize + blockCount * _keySizeBytes + i * checksumSize);
+            std::span<const uint8_t> checksum = reader.Data<uint8_t>().subspan(0, checksumSize);
             crypto::MD5::Digest digest = crypto::MD5::Of(rawBlockData);
             if (!std::equal(digest.begin(), digest.begin() + checksumSize, checksum.begin(), checksum.end()))
                 continue;
 
             for (std::size_t j = 0; j < entryCount; ++j) {
-                stream.SeekRead(i * blockSize + j * entrySize);
+                reader.Seek(i * blockSize + j * entrySize);
 
                 // Read the key and insert it into storage
-                std::span<const uint8_t> keyData = stream.Data<uint8_t>().subspan(0, _keySizeBytes);
-                stream.SkipRead(_keySizeBytes);
+                std::span<const uint8_t> keyData = reader.ReadSpan<uint8_t>(_keySizeBytes);
 
                 // If the key is all 0s, that's an end marker
                 if (std::ranges::all_of(keyData, [](uint8_t b){ return b == 0; }))
@@ -92,26 +102,18 @@ namespace libtactmon::tact::data {
 
                 std::size_t keyOfs = _keyBuffer.size();
                 _keyBuffer.insert(_keyBuffer.end(), keyData.begin(), keyData.end());
-                _entries.emplace_back(stream, sizeBytes, offsetBytes, keyOfs);
+                _entries.emplace_back(reader, sizeBytes, offsetBytes, keyOfs);
             }
         }
 
         _keyBuffer.shrink_to_fit();
     }
 
-    Index::Entry::Entry(io::IReadableStream& stream, std::size_t sizeBytes, std::size_t offsetBytes, std::size_t keyOffset)
+    Index::Entry::Entry(io::SpanReader& reader, std::size_t sizeBytes, std::size_t offsetBytes, std::size_t keyOffset)
         : _keyOffset(keyOffset)
     {
-        std::span<const uint8_t> dataBytes = stream.Data<uint8_t>().subspan(0, sizeBytes + offsetBytes);
-        stream.SkipRead(sizeBytes + offsetBytes);
-
-        for (std::size_t i = 0; i < sizeBytes; ++i) {
-            _size = (_size << 8) | dataBytes[i];
-        }
-
-        for (std::size_t i = 0; i < offsetBytes; ++i) {
-            _offset = (_offset << 8) | dataBytes[sizeBytes + i];
-        }
+        _size = reader.ReadUInt<std::endian::big>(sizeBytes);
+        _offset = reader.ReadUInt<std::endian::big>(offsetBytes);
     }
 
     std::span<const uint8_t> Index::Entry::key(Index const& index) const {
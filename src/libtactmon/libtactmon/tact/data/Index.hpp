@@ -10,6 +10,7 @@
 
 namespace libtactmon::io {
     struct IReadableStream;
+    struct SpanReader;
 }
 
 namespace libtactmon::tact::data {
@@ -21,7 +22,7 @@ namespace libtactmon::tact::data {
         struct Entry {
             friend struct Index;
 
-            Entry(io::IReadableStream& stream, std::size_t sizeBytes, std::size_t offsetBytes, std::size_t keyOffset);
+            Entry(io::SpanReader& reader, std::size_t sizeBytes, std::size_t offsetBytes, std::size_t keyOffset);
 
         public:
             [[nodiscard]] std::size_t size() const { return _size; }
@@ -1,120 +1,188 @@
 #include "libtactmon/tact/data/Install.hpp"
 #include "libtactmon/io/IReadableStream.hpp"
+#include "libtactmon/io/SpanReader.hpp"
+#include "libtactmon/utility/Path.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
 
 namespace libtactmon::tact::data {
     /* static */ std::optional<Install> Install::Parse(io::IReadableStream& stream) {
-        if (!stream.CanRead(2 + 1 + 1 + 2 + 4))
+        io::SpanReader reader { stream, io::AccessPattern::Sequential };
+        if (!reader.CanRead(2 + 1 + 1 + 2 + 4))
+            return std::nullopt;
+
+        uint16_t signature = reader.Read<uint16_t, std::endian::big>();
+        uint8_t version = reader.Read<uint8_t>();
+        uint8_t hashSize = reader.Read<uint8_t>();
+        uint16_t numTags = reader.Read<uint16_t, std::endian::big>();
+        uint32_t numEntries = reader.Read<uint32_t, std::endian::big>();
+
+        std::size_t maskSize = (numEntries + 7) / 8;
+
+        // Everything that is not a fixed-size field is a null-terminated name; size the name storage accordingly.
+        std::size_t fixedSize = numTags * (2 + maskSize) + numEntries * (hashSize + 4);
+        if (!reader.CanRead(fixedSize))
             return std::nullopt;
 
-        uint16_t signature = stream.Read<uint16_t>(std::endian::big);
-        uint8_t version = stream.Read<uint8_t>();
-        uint8_t hashSize = stream.Read<uint8_t>();
-        uint16_t numTags = stream.Read<uint16_t>(std::endian::big);
-        uint32_t numEntries = stream.Read<uint32_t>(std::endian::big);
+        std::size_t namesSize = reader.remaining() - fixedSize;
 
         Install instance { };
+        instance._names = std::make_unique<char[]>(namesSize);
+
+        char* nameCursor = instance._names.get();
+        auto readName = [&]() -> std::optional<std::string_view> {
+            std::string_view name = reader.ReadCString();
+
+            if (name.size() > namesSize - static_cast<std::size_t>(nameCursor - instance._names.get()))
+                return std::nullopt;
+
+            std::memcpy(nameCursor, name.data(), name.size());
+            nameCursor += name.size();
+            return std::string_view { nameCursor - name.size(), name.size() };
+        };
 
         instance._tags.reserve(numTags);
         for (std::size_t i = 0; i < numTags; ++i) {
-            std::string tagName;
-            stream.ReadCString(tagName);
+            std::optional<std::string_view> tagName = readName();
+            if (!tagName.has_value() || !reader.CanRead(2 + maskSize))
+                return std::nullopt;
 
-            instance._tags.emplace_back(stream, numEntries, std::move(tagName));
+            instance._tags.emplace_back(reader, numEntries, *tagName);
         }
 
         instance._entries.reserve(numEntries);
+        instance._nameIndex.reserve(numEntries);
         for (std::size_t i = 0; i < numEntries; ++i) {
-            std::string name;
-            stream.ReadCString(name);
+            std::optional<std::string_view> name = readName();
+            if (!name.has_value() || !reader.CanRead(hashSize + 4))
+                return std::nullopt;
 
-            instance._entries.emplace_back(stream, hashSize, name);
+            instance._entries.emplace_back(reader, hashSize, *name);
+            instance._nameIndex.emplace(utility::path_hash(*name), i);
         }
 
-        // Buggy, disabled for now.
-        // for (auto&& [name, tag] : instance._tags) {
-        //     auto itr = instance._entries.begin();
-        //     for (std::size_t i = 0; i < instance._entries.size(); ++i, ++itr) {
-        //         if (tag.Matches(i))
-        //             itr->_tags.push_back(std::addressof(tag));
-        //     }
-        // }
-
+        stream.SkipRead(reader.cursor());
         return instance;
     }
 
     Install::Install() = default;
 
-    Install::Entry::Entry(io::IReadableStream& stream, std::size_t hashSize, std::string const& name)
-        : _hash(stream.Data<uint8_t>().subspan(0, hashSize)), _name(name)
-    {
-        stream.SkipRead(hashSize);
-
-        _fileSize = stream.Read<uint32_t>(std::endian::big);
-    }
+    Install::Entry::Entry(io::SpanReader& reader, std::size_t hashSize, std::string_view name)
+        // Braced arguments are evaluated in order: the hash is stored before the file size.
+        : Entry { reader.ReadSpan<uint8_t>(hashSize), reader.Read<uint32_t, std::endian::big>(), name }
+    { }
 
-    Install::Tag::Tag(Tag const& other)
-        : _bitmask(std::make_unique<uint8_t[]>(other._bitmaskSize))
-    {
-        _name = other._name;
-        _bitmaskSize = other._bitmaskSize;
-        _type = other._type;
+    Install::Entry::Entry(std::span<const uint8_t> hash, std::size_t fileSize, std::string_view name)
+        : _name(name), _fileSize(fileSize), _hash(hash)
+    { }
 
-        std::copy_n(other._bitmask.get(), _bitmaskSize, _bitmask.get());
+    static uint8_t ReverseBits(uint8_t value) {
+        value = static_cast<uint8_t>((value & 0xF0) >> 4 | (value & 0x0F) << 4);
+        value = static_cast<uint8_t>((value & 0xCC) >> 2 | (value & 0x33) << 2);
+        value = static_cast<uint8_t>((value & 0xAA) >> 1 | (value & 0x55) << 1);
+        return value;
     }
 
-    Install::Tag& Install::Tag::operator = (Tag const& other) {
-        _name = other._name;
-        _bitmaskSize = other._bitmaskSize;
-        _type = other._type;
+    Install::Tag::Tag(io::SpanReader& reader, std::size_t fileCount, std::string_view name) : _name(name) {
+        _type = reader.Read<uint16_t, std::endian::big>();
+
+        // On disk, the first file maps to the most significant bit of the first byte. Repack into words where the first
+        // file maps to the least significant bit, so that masks can be combined and scanned a word at a time.
+        std::size_t maskSize = (fileCount + 7) / 8;
+        std::span<const uint8_t> mask = reader.ReadSpan<uint8_t>(maskSize);
 
-        _bitmask = std::make_unique<uint8_t[]>(_bitmaskSize);
-        std::copy_n(other._bitmask.get(), _bitmaskSize, _bitmask.get());
+        _mask.resize((fileCount + 63) / 64);
+        for (std::size_t i = 0; i < maskSize; ++i)
+            _mask[i / 8] |= static_cast<uint64_t>(ReverseBits(mask[i])) << (8 * (i % 8));
 
-        return *this;
+        if (fileCount % 64 != 0)
+            _mask.back() &= (uint64_t { 1 } << (fileCount % 64)) - 1;
     }
 
-    Install::Tag::Tag(io::IReadableStream& stream, std::size_t bitmaskSize, std::string&& name) : _name(std::move(name)) {
-        _type = stream.Read<uint16_t>(std::endian::big);
-        _bitmaskSize = bitmaskSize;
+    Install::Tag const* Install::FindTag(std::string_view tagName) const {
+        auto itr = std::find_if(_tags.begin(), _tags.end(), [&](Tag const& tag) {
+            return tag.name() == tagName;
+        });
 
-        _bitmask = std::make_unique<uint8_t[]>((bitmaskSize + 7) / 8);
-        stream.Read(std::span<uint8_t> { _bitmask.get(), (bitmaskSize + 7) / 8 }, std::endian::little);
-    }
+        if (itr != _tags.end())
+            return std::addressof(*itr);
 
-    Install::Tag::Tag(Tag&& other) noexcept
-        : _name(other._name), _type(other._type), _bitmaskSize(other._bitmaskSize), _bitmask(std::move(other._bitmask))
-    {
-        other._bitmaskSize = 0;
+        return nullptr;
     }
 
-    Install::Tag& Install::Tag::operator = (Install::Tag&& other) noexcept {
-        _name = std::move(other._name);
-        _type = other._type;
-        _bitmaskSize = other._bitmaskSize;
-        _bitmask = std::move(other._bitmask);
+    std::optional<tact::CKey> Install::FindFile(std::string_view fileName) const {
+        auto [begin, end] = _nameIndex.equal_range(utility::path_hash(fileName));
+        for (auto itr = begin; itr != end; ++itr) {
+            Entry const& entry = _entries[itr->second];
+            if (utility::path_equals(entry.name(), fileName))
+                return entry.ckey();
+        }
 
-        other._bitmaskSize = 0;
-        return *this;
+        return std::nullopt;
     }
 
-    std::optional<tact::CKey> Install::FindFile(std::string_view fileName) const {
-        auto itr = std::find_if(_entries.begin(), _entries.end(), [&](Entry const& entry) {
-            return entry.name() == fileName;
+    std::optional<std::vector<uint64_t>> Install::Select(std::span<const std::string_view> tagNames) const {
+        std::vector<Tag const*> tags;
+        tags.reserve(tagNames.size());
+        for (std::string_view tagName : tagNames) {
+            Tag const* tag = FindTag(tagName);
+            if (tag == nullptr)
+                return std::nullopt;
+
+            tags.push_back(tag);
+        }
+
+        std::stable_sort(tags.begin(), tags.end(), [](Tag const* left, Tag const* right) {
+            return left->type() < right->type();
         });
 
-        if (itr != _entries.end())
-            return itr->ckey();
+        std::size_t wordCount = (_entries.size() + 63) / 64;
+        std::vector<uint64_t> selection(wordCount, ~uint64_t { 0 });
+        if (_entries.size() % 64 != 0)
+            selection.back() = (uint64_t { 1 } << (_entries.size() % 64)) - 1;
+
+        // Tags of the same type are alternatives (OR), and each type further restricts the selection (AND).
+        std::vector<uint64_t> group(wordCount);
+        for (auto itr = tags.begin(); itr != tags.end(); ) {
+            uint16_t type = (*itr)->type();
+
+            std::fill(group.begin(), group.end(), 0);
+            for (; itr != tags.end() && (*itr)->type() == type; ++itr) {
+                uint64_t const* mask = (*itr)->_mask.data();
+                for (std::size_t i = 0; i < wordCount; ++i)
+                    group[i] |= mask[i];
+            }
+
+            for (std::size_t i = 0; i < wordCount; ++i)
+                selection[i] &= group[i];
+        }
 
-        return std::nullopt;
+        return selection;
+    }
+
+    bool Install::ForEachFile(std::span<const std::string_view> tagNames,
+        std::function<void(std::string_view, tact::CKey const&, std::size_t)> const& handler) const
+    {
+        std::optional<std::vector<uint64_t>> selection = Select(tagNames);
+        if (!selection.has_value())
+            return false;
+
+        for (std::size_t i = 0; i < selection->size(); ++i) {
+            for (uint64_t word = (*selection)[i]; word != 0; word &= word - 1) {
+                Entry const& entry = _entries[i * 64 + std::countr_zero(word)];
+                handler(entry.name(), entry.ckey(), entry._fileSize);
+            }
+        }
+
+        return true;
     }
 
     bool Install::Tag::Matches(std::size_t fileIndex) const {
-        return false;
+        if (fileIndex / 64 >= _mask.size())
+            return false;
 
-        // Buggy, disabled for now.
-        // std::size_t byteIndex = fileIndex / sizeof(uint8_t);
-        // std::size_t bitIndex = fileIndex % sizeof(uint8_t);
-        //
-        // return (_bitmask[byteIndex] & (1 << bitIndex)) != 0;
+        return (_mask[fileIndex / 64] >> (fileIndex % 64)) & 1;
     }
 }
@@ -4,16 +4,17 @@
 #include "libtactmon/tact/CKey.hpp"
 
 #include <cstdint>
-#include <list>
+#include <functional>
 #include <memory>
 #include <optional>
-#include <string>
+#include <span>
 #include <string_view>
 #include <unordered_map>
 #include <vector>
 
 namespace libtactmon::io {
     struct IReadableStream;
+    struct SpanReader;
 }
 
 namespace libtactmon::tact::data {
@@ -23,26 +24,29 @@ namespace libtactmon::tact::data {
         struct LIBTACTMON_API Tag final {
             friend struct Install;
 
-            Tag(io::IReadableStream& stream, std::size_t bitmaskSize, std::string&& name);
-
-            Tag(Tag&& other) noexcept;
-            Tag& operator = (Tag&& other) noexcept;
-
-            Tag(Tag const&);
-            Tag& operator = (Tag const&);
+            Tag(io::SpanReader& reader, std::size_t fileCount, std::string_view name);
 
         public:
             [[nodiscard]] std::string_view name() const { return _name; }
-            [[nodiscard]] uint8_t type() const { return _type; }
+            [[nodiscard]] uint16_t type() const { return _type; }
 
+            /**
+             * Determines if this tag applies to a given file.
+             *
+             * @param[in] fileIndex The index of the file in the manifest.
+             */
             [[nodiscard]] bool Matches(std::size_t fileIndex) const;
 
+            /**
+             * Returns the files this tag applies to, as a bitset where bit @c i of word @c i/64 is set for the @c i -th file.
+             */
+            [[nodiscard]] std::span<const uint64_t> mask() const { return _mask; }
+
         private:
-            std::string _name;
-            uint8_t _type;
+            std::string_view _name;
+            uint16_t _type;
 
-            std::size_t _bitmaskSize;
-            std::unique_ptr<uint8_t[]> _bitmask;
+            std::vector<uint64_t> _mask;
         };
 
         /**
@@ -50,36 +54,71 @@ namespace libtactmon::tact::data {
          */
         [[nodiscard]] std::size_t size() const { return _entries.size(); }
 
+        /**
+         * Returns the tags declared by this manifest.
+         */
+        [[nodiscard]] std::span<const Tag> tags() const { return _tags; }
+
+        /**
+         * Returns a tag given its name, or nullptr if this manifest does not declare it.
+         */
+        [[nodiscard]] Tag const* FindTag(std::string_view tagName) const;
+
         /**
          * Returns the content key of a file in this install manifest, or an empty manifest if no information could be found for said file.
          *
-         * @param[in] fileName The complete path to the file for which the caller expects a content key.
+         * @param[in] fileName The complete path to the file for which the caller expects a content key. Case and path separators are not significant.
          */
         [[nodiscard]] std::optional<tact::CKey> FindFile(std::string_view fileName) const;
 
+        /**
+         * Computes the set of files selected by a combination of tags: a file is selected if, for each tag type involved,
+         * it matches at least one of the given tags of that type (i.e. "Windows", "x86_64" and "enUS" selects files for
+         * the 64-bit Windows client in english).
+         *
+         * @param[in] tagNames The names of the tags.
+         * @returns A bitset of the selected files (see @ref Tag::mask), or an empty optional if a tag is unknown.
+         */
+        [[nodiscard]] std::optional<std::vector<uint64_t>> Select(std::span<const std::string_view> tagNames) const;
+
+        /**
+         * Enumerates the files selected by a combination of tags (see @ref Select).
+         *
+         * @param[in] tagNames The names of the tags.
+         * @param[in] handler  A callable receiving the name, content key and size of each selected file.
+         * @returns false if a tag is unknown.
+         */
+        bool ForEachFile(std::span<const std::string_view> tagNames,
+            std::function<void(std::string_view, tact::CKey const&, std::size_t)> const& handler) const;
+
     private:
         Install();
 
         struct Entry {
             friend struct Install;
 
-            Entry(io::IReadableStream& stream, std::size_t hashSize, std::string const& name);
+            Entry(io::SpanReader& reader, std::size_t hashSize, std::string_view name);
+            Entry(std::span<const uint8_t> hash, std::size_t fileSize, std::string_view name);
 
             [[nodiscard]] std::string_view name() const { return _name; }
 
             [[nodiscard]] tact::CKey const& ckey() const { return _hash; }
 
         private:
-            std::string _name;
+            std::string_view _name;
             std::size_t _fileSize;
-            
-            tact::CKey _hash;
 
-            std::vector<Tag*> _tags;
+            tact::CKey _hash;
         };
 
+        //! Storage for the names of tags and entries, allocated once per manifest.
+        std::unique_ptr<char[]> _names;
+
         std::vector<Tag> _tags;
 
         std::vector<Entry> _entries;
+
+        //! Indices of entries, keyed by the hash of their normalized name.
+        std::unordered_multimap<uint64_t, std::size_t> _nameIndex;
     };
 }
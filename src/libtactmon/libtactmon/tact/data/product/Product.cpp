@@ -1,13 +1,20 @@
 #include "libtactmon/io/MemoryStream.hpp"
 #include "libtactmon/net/DownloadTask.hpp"
+#include "libtactmon/net/ConnectionPool.hpp"
+#include "libtactmon/net/FileDownloadTask.hpp"
+#include "libtactmon/net/HostScoreboard.hpp"
 #include "libtactmon/net/MemoryDownloadTask.hpp"
 #include "libtactmon/ribbit/Commands.hpp"
+#include "libtactmon/ribbit/ResponseCache.hpp"
 #include "libtactmon/tact/data/Encoding.hpp"
 #include "libtactmon/tact/data/product/Product.hpp"
 #include "libtactmon/tact/EKey.hpp"
 
+#include <algorithm>
 #include <filesystem>
 #include <future>
+#include <map>
+#include <utility>
 
 #include <boost/asio/thread_pool.hpp>
 #include <boost/thread/future.hpp>
@@ -23,18 +30,27 @@ namespace libtactmon::tact::data::product {
     }
 
     bool Product::Load(std::string_view buildConfig, std::string_view cdnConfig) noexcept {
-        // **Always** refresh CDN
-        _cdns = ribbit::CDNs<>::Execute(_executor, nullptr, ribbit::Region::US, _productName);
+        StageTimer stages { *this };
+
+        // Refresh CDNs; the response is reused until Ribbit's summary reports a new sequence number for it.
+        stages.Enter("cdns");
+        if (_fixedCDNs.has_value())
+            _cdns = _fixedCDNs;
+        else
+            _cdns = ribbit::ResponseCache::Default().Execute<ribbit::CDNs<>>(_executor, nullptr, ribbit::Region::US, _productName);
+
         if (!_cdns.has_value())
             return false;
 
         // Load build config and cdn config; abort if invalid or not found.
+        stages.Enter("build-config");
         _buildConfig = ResolveCachedConfig(buildConfig, [](io::FileStream& fstream) {
             return tact::config::BuildConfig::Parse(fstream);
         });
         if (!_buildConfig.has_value())
             return false;
 
+        stages.Enter("cdn-config");
         _cdnConfig = ResolveCachedConfig(cdnConfig, [](io::FileStream& fstream) {
             return tact::config::CDNConfig::Parse(fstream);
         });
@@ -49,18 +65,11 @@ namespace libtactmon::tact::data::product {
             _logger->info("({}) Detected root manifest: {}.", _buildConfig->BuildName, _buildConfig->Root.ToString());
         }
 
-        _encoding = ResolveCachedData(_buildConfig->Encoding.Key.EncodingKey.ToString(),
-            [&key = _buildConfig->Encoding.Key](io::FileStream& fstream) -> std::optional<tact::data::Encoding>
-            {
-                if (!fstream)
-                    return std::nullopt;
-
-                std::optional<tact::BLTE> compressedArchive = tact::BLTE::Parse(fstream, key.EncodingKey, key.ContentKey);
-                if (!compressedArchive.has_value())
-                    return std::nullopt;
-
-                return tact::data::Encoding { compressedArchive->GetStream() };
-            });
+        // Manifests are decoded and parsed while they are downloaded.
+        stages.Enter("encoding");
+        _encoding = ResolveDecodedData(_buildConfig->Encoding.Key.EncodingKey, _buildConfig->Encoding.Key.ContentKey, []() {
+            return tact::data::Encoding::Parser { };
+        });
 
         if (!_encoding.has_value()) {
             if (_logger != nullptr)
@@ -71,17 +80,10 @@ namespace libtactmon::tact::data::product {
         if (_logger != nullptr)
             _logger->info("({}) {} entries found in encoding manifest.", _buildConfig->BuildName, _encoding->count());
 
-        _install = ResolveCachedData(_buildConfig->Install.Key.EncodingKey.ToString(),
-            [&key = _buildConfig->Install.Key](io::FileStream& fstream) -> std::optional<tact::data::Install> {
-                if (!fstream)
-                    return std::nullopt;
-
-                std::optional<tact::BLTE> compressedArchive = tact::BLTE::Parse(fstream, key.EncodingKey, key.ContentKey);
-                if (!compressedArchive.has_value())
-                    return std::nullopt;
-
-                return tact::data::Install::Parse(compressedArchive->GetStream());
-            });
+        stages.Enter("install");
+        _install = ResolveDecodedData(_buildConfig->Install.Key.EncodingKey, _buildConfig->Install.Key.ContentKey, []() {
+            return BufferingParser { [](io::IReadableStream& stream) { return tact::data::Install::Parse(stream); } };
+        });
 
         if (!_install.has_value()) {
             if (_logger != nullptr)
@@ -92,19 +94,37 @@ namespace libtactmon::tact::data::product {
         if (_logger != nullptr)
             _logger->info("({}) {} entries found in install manifest.", _buildConfig->BuildName, _install->size());
 
-        using index_parse_task = boost::packaged_task<std::optional<tact::data::Index>>;
-        std::list<boost::future<std::optional<tact::data::Index>>> archiveFutures;
+        stages.Enter("indices");
+        using index_parse_task = boost::packaged_task<std::vector<tact::data::Index>>;
+        std::list<boost::future<std::vector<tact::data::Index>>> archiveFutures;
+
+        // Archive indices that are already cached are read in a single batch of asynchronous reads.
+        std::vector<std::string> indexPaths;
+        if (!_cdns->empty()) {
+            indexPaths.reserve(_cdnConfig->archives.size());
+            for (config::CDNConfig::Archive const& archive : _cdnConfig->archives) {
+                std::string key = fmt::format("{}.index", archive.Name);
+                indexPaths.push_back(fmt::format("/{}/data/{}/{}/{}", _cdns->front().Path, key.substr(0, 2), key.substr(2, 2), key));
+            }
+        }
+
+        std::vector<boost::future<io::AsyncFileService::ReadResult>> cachedIndices = _localCache.ReadAsync(indexPaths);
+
+        std::vector<std::size_t> missingIndices;
+        for (std::size_t i = 0; i < _cdnConfig->archives.size(); ++i) {
+            io::AsyncFileService::ReadResult data = i < cachedIndices.size() ? cachedIndices[i].get() : std::nullopt;
+            if (!data.has_value() || data->empty()) {
+                missingIndices.push_back(i);
+                continue;
+            }
 
-        for (config::CDNConfig::Archive const& archive : _cdnConfig->archives) {
             std::shared_ptr<index_parse_task> task = std::make_shared<index_parse_task>(
-                [archiveName = archive.Name, archiveSize = archive.Size, buildName = _buildConfig->BuildName, logger = _logger, this]() {
-                    return ResolveCachedData(fmt::format("{}.index", archiveName),
-                        [&](io::FileStream& fstream) -> std::optional<tact::data::Index> {
-                            if (!fstream /* || fstream.GetLength() != archiveSize */ )
-                                return std::nullopt;
-
-                            return tact::data::Index { archiveName, fstream };
-                        });
+                [archiveName = _cdnConfig->archives[i].Name, data = std::make_shared<std::vector<std::byte>>(std::move(*data))]() {
+                    io::SpanStream stream { *data };
+
+                    std::vector<tact::data::Index> indices;
+                    indices.emplace_back(archiveName, stream);
+                    return indices;
                 }
             );
 
@@ -113,6 +133,71 @@ namespace libtactmon::tact::data::product {
             boost::asio::post(_executor, [task]() { (*task)(); });
         }
 
+        // Missing indices are downloaded from the first CDN, best hosts first, spread over as many pipelined connections as the
+        // connection pool allows per host. Whatever can not be obtained that way goes through the regular resolution, which
+        // also tries the other CDNs. Downloads block the thread that runs them, and connections are leased synchronously, so
+        // groups run on a private pool rather than on the executor of this product, as in OpenFiles.
+        std::size_t groupCount = std::min(missingIndices.size(), net::ConnectionPool::Default().options().MaxConnectionsPerHost);
+        boost::asio::thread_pool indexDownloads { std::max<std::size_t>(groupCount, 1) };
+
+        for (std::size_t group = 0; group < groupCount; ++group) {
+            std::vector<std::size_t> members;
+            for (std::size_t i = group; i < missingIndices.size(); i += groupCount)
+                members.push_back(missingIndices[i]);
+
+            std::shared_ptr<index_parse_task> task = std::make_shared<index_parse_task>(
+                [members = std::move(members), &indexPaths = std::as_const(indexPaths), &indexDownloads, this]() {
+                    std::vector<tact::data::Index> indices;
+
+                    std::vector<std::size_t> pending = members;
+                    if (!_cdns->empty()) {
+                        for (std::string_view host : net::HostScoreboard::Default().Rank(_cdns->front().Hosts)) {
+                            if (pending.empty())
+                                break;
+
+                            std::vector<net::FileDownloadTask> downloads;
+                            downloads.reserve(pending.size());
+                            for (std::size_t archiveIndex : pending)
+                                downloads.emplace_back(indexPaths[archiveIndex], _localCache);
+
+                            std::vector<std::optional<io::FileStream>> results = net::FileDownloadTask::RunPipelined(downloads, indexDownloads.get_executor(), host, _logger.get());
+
+                            std::vector<std::size_t> failed;
+                            for (std::size_t i = 0; i < pending.size(); ++i) {
+                                if (results[i].has_value() && *results[i])
+                                    indices.emplace_back(_cdnConfig->archives[pending[i]].Name, *results[i]);
+                                else
+                                    failed.push_back(pending[i]);
+                            }
+
+                            pending = std::move(failed);
+                        }
+                    }
+
+                    for (std::size_t archiveIndex : pending) {
+                        std::string const& archiveName = _cdnConfig->archives[archiveIndex].Name;
+
+                        std::optional<tact::data::Index> index = ResolveCachedData(fmt::format("{}.index", archiveName),
+                            [&](io::FileStream& fstream) -> std::optional<tact::data::Index> {
+                                if (!fstream)
+                                    return std::nullopt;
+
+                                return tact::data::Index { archiveName, fstream };
+                            });
+
+                        if (index.has_value())
+                            indices.push_back(std::move(*index));
+                    }
+
+                    return indices;
+                }
+            );
+
+            archiveFutures.push_back(task->get_future());
+
+            boost::asio::post(indexDownloads, [task]() { (*task)(); });
+        }
+
         if (_cdnConfig->fileIndex.has_value()) {
             if (_logger != nullptr)
                 _logger->info("({}) Loading file index '{}'.", _buildConfig->BuildName, _cdnConfig->fileIndex->Name);
@@ -126,17 +211,32 @@ namespace libtactmon::tact::data::product {
                 });
         }
 
-        for (boost::future<std::optional<tact::data::Index>>& future : boost::when_all(archiveFutures.begin(), archiveFutures.end()).get()) {
-            std::optional<tact::data::Index> futureOutcome = future.get();
-            if (futureOutcome.has_value())
-                _indices.push_back(std::move(futureOutcome.value()));
+        for (boost::future<std::vector<tact::data::Index>>& future : boost::when_all(archiveFutures.begin(), archiveFutures.end()).get()) {
+            for (tact::data::Index& index : future.get())
+                _indices.push_back(std::move(index));
         }
 
+        indexDownloads.join();
+
         return true;
     }
 
+    void Product::StageTimer::Enter(std::string_view stage) {
+        Leave();
+
+        _stage = stage;
+        _start = std::chrono::steady_clock::now();
+    }
+
+    void Product::StageTimer::Leave() {
+        if (!_stage.empty() && _handler)
+            _handler(_stage, _start, std::chrono::steady_clock::now());
+
+        _stage = { };
+    }
+
     std::optional<ribbit::types::Versions> Product::Refresh() noexcept {
-        auto summary = ribbit::Summary<>::Execute(_executor, _logger.get(), ribbit::Region::US);
+        auto summary = ribbit::ResponseCache::Default().Execute<ribbit::Summary<>>(_executor, _logger.get(), ribbit::Region::US);
         if (!summary.has_value())
             return std::nullopt;
 
@@ -146,7 +246,7 @@ namespace libtactmon::tact::data::product {
         if (summaryItr == summary->end())
             return std::nullopt;
 
-        auto versions = ribbit::Versions<>::Execute(_executor, _logger.get(), ribbit::Region::US, _productName);
+        auto versions = ribbit::ResponseCache::Default().Execute<ribbit::Versions<>>(_executor, _logger.get(), ribbit::Region::US, _productName);
         if (!versions.has_value())
             return std::nullopt;
 
@@ -194,4 +294,206 @@ namespace libtactmon::tact::data::product {
 
         return std::nullopt;
     }
+
+    std::optional<tact::BLTE> Product::OpenFile(tact::CKey const& contentKey) const {
+        std::optional<tact::data::FileLocation> location = FindFile(contentKey);
+        if (!location.has_value())
+            return std::nullopt;
+
+        return OpenFile(*location, &contentKey);
+    }
+
+    std::optional<tact::BLTE> Product::OpenFile(std::string_view filePath) const {
+        std::optional<tact::data::FileLocation> location = FindFile(filePath);
+        if (!location.has_value())
+            return std::nullopt;
+
+        return OpenFile(*location, nullptr);
+    }
+
+    std::optional<tact::BLTE> Product::OpenFile(uint32_t fileDataID) const {
+        std::optional<tact::data::FileLocation> location = FindFile(fileDataID);
+        if (!location.has_value())
+            return std::nullopt;
+
+        return OpenFile(*location, nullptr);
+    }
+
+    std::optional<tact::BLTE> Product::OpenFile(tact::data::FileLocation const& location, tact::CKey const* contentKey) const {
+        if (!_cdns.has_value())
+            return std::nullopt;
+
+        for (std::size_t i = 0; i < location.keyCount(); ++i) {
+            tact::EKey encodingKey = location[i];
+            std::string key = encodingKey.ToString();
+
+            auto parser = [&](io::FileStream& fstream) -> std::optional<tact::BLTE> {
+                if (!fstream)
+                    return std::nullopt;
+
+                if (contentKey != nullptr)
+                    return tact::BLTE::Parse(fstream, encodingKey, *contentKey);
+
+                return tact::BLTE::Parse(fstream, encodingKey);
+            };
+
+            // Files that are not archived are listed by the file index under their own name.
+            std::optional<tact::data::ArchiveFileLocation> archive = FindArchive(encodingKey);
+            std::optional<tact::BLTE> blte = archive.has_value() && archive->name() != key
+                ? ResolveArchivedData(*_cdns, key, *archive, parser, _logger.get())
+                : ResolveCachedData(key, parser);
+
+            if (blte.has_value())
+                return blte;
+        }
+
+        return std::nullopt;
+    }
+
+    std::vector<std::optional<tact::BLTE>> Product::OpenFiles(std::span<const tact::CKey> contentKeys, BatchOptions options) const {
+        std::vector<std::optional<tact::BLTE>> files(contentKeys.size());
+        if (!_cdns.has_value() || _cdns->empty())
+            return files;
+
+        struct Fragment {
+            std::size_t File;
+            tact::EKey Key;
+            std::size_t Offset;
+            std::size_t Size;
+        };
+
+        // A range of an archive, covering consecutive fragments.
+        struct Range {
+            std::size_t Offset;
+            std::size_t Size;
+            std::size_t First;
+            std::size_t Count;
+        };
+
+        auto dataPath = [](ribbit::types::cdns::Record const& cdn, std::string_view key) {
+            return fmt::format("/{}/data/{}/{}/{}", cdn.Path, key.substr(0, 2), key.substr(2, 2), key);
+        };
+
+        std::map<std::string, std::vector<Fragment>> archives;
+        std::vector<std::size_t> individual;
+        for (std::size_t i = 0; i < contentKeys.size(); ++i) {
+            std::optional<tact::data::FileLocation> location = FindFile(contentKeys[i]);
+            if (!location.has_value() || location->keyCount() == 0)
+                continue;
+
+            tact::EKey encodingKey = (*location)[0];
+            std::string key = encodingKey.ToString();
+
+            bool cached = std::any_of(_cdns->begin(), _cdns->end(), [&](ribbit::types::cdns::Record const& cdn) {
+                return std::filesystem::exists(_localCache.GetAbsolutePath(dataPath(cdn, key)));
+            });
+
+            std::optional<tact::data::ArchiveFileLocation> archive = FindArchive(encodingKey);
+            if (!archive.has_value() || archive->name() == key || cached) {
+                individual.push_back(i);
+                continue;
+            }
+
+            archives[std::string { archive->name() }].push_back(Fragment { i, encodingKey, archive->offset(), archive->fileSize() });
+        }
+
+        // Downloads block the thread that runs them, so batches run on a private pool rather than on the executor of this
+        // product, which the calling thread may need to stay responsive. Connections bound to that pool are dropped when
+        // it is joined.
+        std::size_t threadCount = std::min(archives.size(), net::ConnectionPool::Default().options().MaxConnectionsPerHost);
+        boost::asio::thread_pool batches { std::max<std::size_t>(threadCount, 1) };
+
+        for (auto&& [archiveName, fragments] : archives) {
+            boost::asio::post(batches, [&, &archiveName = archiveName, &fragments = fragments]() {
+                std::sort(fragments.begin(), fragments.end(), [](Fragment const& left, Fragment const& right) {
+                    return left.Offset < right.Offset;
+                });
+
+                std::vector<Range> ranges;
+                for (std::size_t i = 0; i < fragments.size(); ++i) {
+                    Fragment const& fragment = fragments[i];
+                    if (!ranges.empty()) {
+                        Range& range = ranges.back();
+
+                        std::size_t end = range.Offset + range.Size;
+                        std::size_t mergedEnd = std::max(end, fragment.Offset + fragment.Size);
+                        if (fragment.Offset <= end + options.GapThreshold && mergedEnd - range.Offset <= options.MaxRangeSize) {
+                            range.Size = mergedEnd - range.Offset;
+                            ++range.Count;
+                            continue;
+                        }
+                    }
+
+                    ranges.push_back(Range { fragment.Offset, fragment.Size, i, 1 });
+                }
+
+                if (_logger != nullptr)
+                    _logger->debug("Fetching {} files from archive '{}' as {} ranges.", fragments.size(), archiveName, ranges.size());
+
+                std::vector<std::size_t> pending(ranges.size());
+                for (std::size_t i = 0; i < ranges.size(); ++i)
+                    pending[i] = i;
+
+                // Ranges that a CDN fails to provide are requested again from the next one.
+                for (ribbit::types::cdns::Record const& cdn : *_cdns) {
+                    std::string archivePath = dataPath(cdn, archiveName);
+
+                    for (std::string_view host : net::HostScoreboard::Default().Rank(cdn.Hosts)) {
+                        if (pending.empty())
+                            break;
+
+                        std::vector<net::MemoryDownloadTask> downloads;
+                        downloads.reserve(pending.size());
+                        for (std::size_t rangeIndex : pending)
+                            downloads.emplace_back(archivePath, ranges[rangeIndex].Offset, ranges[rangeIndex].Size);
+
+                        std::vector<std::optional<io::PagedMemoryStream>> results = net::MemoryDownloadTask::RunPipelined(downloads, batches.get_executor(), host, _logger.get());
+
+                        std::vector<std::size_t> failed;
+                        for (std::size_t i = 0; i < pending.size(); ++i) {
+                            Range const& range = ranges[pending[i]];
+
+                            // A server that ignores the range sends the whole archive instead.
+                            if (!results[i].has_value() || results[i]->GetLength() != range.Size) {
+                                failed.push_back(pending[i]);
+                                continue;
+                            }
+
+                            // Split the range back into files, each of which is cached like a loose data file.
+                            for (std::size_t j = range.First; j < range.First + range.Count; ++j) {
+                                Fragment const& fragment = fragments[j];
+
+                                std::vector<std::byte> data(fragment.Size);
+                                results[i]->SeekRead(fragment.Offset - range.Offset);
+                                if (results[i]->Read(std::span<std::byte> { data }) != data.size())
+                                    continue;
+
+                                io::SpanStream stream { data };
+                                files[fragment.File] = tact::BLTE::Parse(stream, fragment.Key, contentKeys[fragment.File]);
+                                if (files[fragment.File].has_value())
+                                    _localCache.WriteAsync(dataPath(cdn, fragment.Key.ToString()), std::move(data)).get();
+                            }
+                        }
+
+                        pending = std::move(failed);
+                    }
+                }
+            });
+        }
+
+        batches.join();
+
+        // Whatever was not obtained in a batch goes through the regular resolution.
+        for (auto&& [archiveName, fragments] : archives) {
+            for (Fragment const& fragment : fragments) {
+                if (!files[fragment.File].has_value())
+                    individual.push_back(fragment.File);
+            }
+        }
+
+        for (std::size_t file : individual)
+            files[file] = OpenFile(contentKeys[file]);
+
+        return files;
+    }
 }
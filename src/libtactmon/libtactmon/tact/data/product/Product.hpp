@@ -17,12 +17,15 @@
 #include "libtactmon/tact/data/Install.hpp"
 #include "libtactmon/tact/data/product/Utility.hpp"
 
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string_view>
+#include <vector>
 
 #include <boost/asio/any_io_executor.hpp>
 #include <boost/asio/io_context.hpp>
@@ -51,6 +54,11 @@ namespace libtactmon::tact::data::product {
          */
         [[nodiscard]] std::string_view name() const { return _productName; }
 
+        /**
+         * Returns the install manifest of the currently loaded configuration, if any.
+         */
+        [[nodiscard]] std::optional<tact::data::Install> const& install() const { return _install; }
+
     protected: // Resource resolution APIs
 
         /**
@@ -79,7 +87,44 @@ namespace libtactmon::tact::data::product {
             return ResourceResolver::ResolveData(*_cdns, key, resultSupplier, _logger.get());
         }
 
+        /**
+         * Resolves a BLTE-encoded data file, decoding and parsing it while it is downloaded.
+         *
+         * @param[in] encodingKey The encoding key of the file.
+         * @param[in] contentKey  The content key of the file.
+         * @param[in] makeParser  A function returning a new incremental parser (see @ref ResourceResolver::ResolveDecodedData).
+         *
+         * @returns An optional encapsulating the parsed resource.
+         */
+        template <typename Factory>
+        [[nodiscard]] auto ResolveDecodedData(tact::EKey const& encodingKey, tact::CKey const& contentKey, Factory makeParser) const
+            -> decltype(makeParser().Finish())
+        {
+            return ResourceResolver::ResolveDecodedData(*_cdns, encodingKey, contentKey, makeParser, _logger.get());
+        }
+
     public: // Front-facing API
+        using ResourceResolver::SetHedging;
+
+        /**
+         * Uses the given CDNs instead of querying Ribbit when configurations are loaded. Files are always looked up in the
+         * local cache first; a CDN without hosts restricts resolution to the local cache, which loads a product offline.
+         *
+         * @param[in] cdns The CDNs, as Ribbit would list them.
+         */
+        void SetCDNs(ribbit::types::CDNs cdns) { _fixedCDNs = std::move(cdns); }
+
+        /**
+         * A callable receiving the name of a stage of @ref Load, along with the time it started and ended at.
+         */
+        using StageHandler = std::function<void(std::string_view, std::chrono::steady_clock::time_point, std::chrono::steady_clock::time_point)>;
+
+        /**
+         * Reports the duration of each stage of @ref Load (configurations, manifests, archive indices, ...) as it
+         * completes. Stages that fail are reported as well.
+         */
+        void SetStageHandler(StageHandler handler) { _stageHandler = std::move(handler); }
+
         /**
          * Returns the version of this product that Ribbit exposes at the time this method is called.
          */
@@ -128,12 +173,100 @@ namespace libtactmon::tact::data::product {
          */
         [[nodiscard]] std::optional<tact::data::ArchiveFileLocation> FindArchive(tact::EKey const& ekey) const;
 
+        /**
+         * Opens a file by content key. If the file is stored in an archive, only its bytes are requested from the CDN
+         * rather than the entire archive; they are cached under the file's encoding key.
+         *
+         * @param[in] contentKey The content key of the file.
+         *
+         * @returns The decoded file, or an empty optional if it could not be found or obtained.
+         */
+        [[nodiscard]] std::optional<tact::BLTE> OpenFile(tact::CKey const& contentKey) const;
+
+        /**
+         * Opens a file by its path. See @ref OpenFile(tact::CKey const&).
+         *
+         * @param[in] filePath Complete path to the file.
+         *
+         * @returns The decoded file, or an empty optional if it could not be found or obtained.
+         */
+        [[nodiscard]] std::optional<tact::BLTE> OpenFile(std::string_view filePath) const;
+
+        /**
+         * Opens a file by FDID. See @ref OpenFile(tact::CKey const&).
+         *
+         * @param[in] fileDataID The ID of the file in the product's Root file.
+         *
+         * @returns The decoded file, or an empty optional if it could not be found or obtained.
+         */
+        [[nodiscard]] std::optional<tact::BLTE> OpenFile(uint32_t fileDataID) const;
+
+        struct BatchOptions {
+            //! Files of the same archive separated by at most this amount of bytes are requested as a single range.
+            std::size_t GapThreshold = 64 * 1024;
+
+            //! Upper bound of the size of a merged range.
+            std::size_t MaxRangeSize = 8 * 1024 * 1024;
+        };
+
+        /**
+         * Opens many files at once. Files are grouped by archive; within an archive, files close to each other are fetched
+         * with a single range request, and requests are pipelined. Files that are not archived, already cached, or whose
+         * range could not be obtained are opened individually (see @ref OpenFile(tact::CKey const&)).
+         *
+         * Archives are fetched in parallel on threads owned by this call. Writes to the local cache still complete on
+         * the executor of this product, so this function must not be called from one of its threads.
+         *
+         * @param[in] contentKeys The content keys of the files.
+         * @param[in] options     Controls how ranges are merged.
+         *
+         * @returns The decoded files, in the same order as @p contentKeys.
+         */
+        [[nodiscard]] std::vector<std::optional<tact::BLTE>> OpenFiles(std::span<const tact::CKey> contentKeys, BatchOptions options) const;
+        [[nodiscard]] std::vector<std::optional<tact::BLTE>> OpenFiles(std::span<const tact::CKey> contentKeys) const {
+            return OpenFiles(contentKeys, BatchOptions { });
+        }
+
+    protected:
+        /**
+         * Times the stages of a call to @ref Load: entering a stage ends the previous one, and the last stage ends when
+         * this object is destroyed.
+         */
+        struct StageTimer final {
+            explicit StageTimer(Product const& product) : _handler(product._stageHandler) { }
+            ~StageTimer() { Leave(); }
+
+            StageTimer(StageTimer const&) = delete;
+            StageTimer& operator = (StageTimer const&) = delete;
+
+            void Enter(std::string_view stage);
+            void Leave();
+
+        private:
+            StageHandler const& _handler;
+
+            std::string_view _stage;
+            std::chrono::steady_clock::time_point _start;
+        };
+
+    private:
+        /**
+         * Opens the first of the encoded copies of a file that can be obtained.
+         *
+         * @param[in] location   The location of the file.
+         * @param[in] contentKey The content key of the file, if known; the decoded file is validated against it.
+         */
+        std::optional<tact::BLTE> OpenFile(tact::data::FileLocation const& location, tact::CKey const* contentKey) const;
+
     private:
         std::string _productName;
 
     private:
         Cache& _localCache;
 
+        std::optional<ribbit::types::CDNs> _fixedCDNs;
+        StageHandler _stageHandler;
+
     protected:
         std::shared_ptr<spdlog::logger> _logger;
 
@@ -1,16 +1,31 @@
 #pragma once
 
 #include "libtactmon/io/FileStream.hpp"
+#include "libtactmon/io/MemoryStream.hpp"
 #include "libtactmon/net/FileDownloadTask.hpp"
+#include "libtactmon/net/HostScoreboard.hpp"
+#include "libtactmon/net/SegmentedDownload.hpp"
 #include "libtactmon/ribbit/types/CDNs.hpp"
+#include "libtactmon/tact/BLTEDecoder.hpp"
 #include "libtactmon/tact/Cache.hpp"
+#include "libtactmon/tact/data/FileLocation.hpp"
+#include "libtactmon/utility/SingleFlight.hpp"
 
+#include <bit>
+#include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
+#include <span>
+#include <string>
 #include <string_view>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 #include <boost/asio/any_io_executor.hpp>
+#include <boost/asio/awaitable.hpp>
 
 #include <fmt/core.h>
 #include <fmt/format.h>
@@ -18,14 +33,43 @@
 #include <spdlog/logger.h>
 
 namespace libtactmon::tact::data::product {
+    /**
+     * Adapts a parser that needs an entire file for use with @ref ResourceResolver::ResolveDecodedData: decoded bytes are
+     * accumulated in memory as they arrive, and parsed once the file was entirely decoded.
+     */
+    template <typename Handler>
+    struct BufferingParser {
+        explicit BufferingParser(Handler handler) : _handler(std::move(handler)) { }
+
+        bool Feed(std::span<const uint8_t> data) {
+            return _stream.Write(data, std::endian::little) == data.size();
+        }
+
+        auto Finish() -> std::invoke_result_t<Handler&, io::IReadableStream&> {
+            return _handler(_stream);
+        }
+
+    private:
+        Handler _handler;
+        io::GrowableMemoryStream _stream;
+    };
+
     /**
      * Exposes utility methods to resolve files from Blizzard CDNs.
+     *
+     * Hosts of a CDN are tried from best to worst, as scored by @ref net::HostScoreboard::Default.
      */
     struct ResourceResolver {
         ResourceResolver(boost::asio::any_io_executor executor, tact::Cache& localCache)
             : _executor(std::move(executor)), _localCache(localCache)
         { }
 
+        /**
+         * Enables hedged requests: if a host takes longer than usual to respond, the same request is sent to another host
+         * and whichever responds first is used (see @ref net::RunHedged).
+         */
+        void SetHedging(bool enabled) { _hedging = enabled; }
+
         /**
          * Resolves a configuration file.
          * 
@@ -45,7 +89,8 @@ namespace libtactmon::tact::data::product {
         }
 
         /**
-         * Resolves a data file.
+         * Resolves a data file. Large files are downloaded as several ranges fetched concurrently from all of the hosts of
+         * a CDN (see @ref net::SegmentedDownload).
          * 
          * @param[in] cdns   A list of available CDNs, as provided by Ribbit.
          * @param[in] key    The configuration file's key.
@@ -59,26 +104,306 @@ namespace libtactmon::tact::data::product {
             std::string_view key, Handler parser, spdlog::logger* logger = nullptr) const
             -> std::invoke_result_t<Handler, io::FileStream&>
         {
-            return Resolve(cdns, key, "/{}/data/{}/{}/{}", parser, logger);
+            return Resolve(cdns, key, "/{}/data/{}/{}/{}", parser, logger, true);
+        }
+
+        /**
+         * Resolves a data file stored in an archive. Only the bytes of the file are requested from the archive, or read from
+         * it if the archive is cached in its entirety; they are cached as if they were the loose data file, so that later
+         * calls to @ref ResolveData find them as well.
+         *
+         * @param[in] cdns     A list of available CDNs, as provided by Ribbit.
+         * @param[in] key      The data file's key.
+         * @param[in] location The location of the file in its archive (see @ref Product::FindArchive).
+         * @param[in] parser   A callable in charge of parsing the file.
+         * @param[in] logger   A logger for errors that occur during download.
+         *
+         * @returns The parsed file or an empty optional if unable to.
+         */
+        template <typename Handler>
+        auto ResolveArchivedData(ribbit::types::CDNs const& cdns,
+            std::string_view key, tact::data::ArchiveFileLocation const& location, Handler parser, spdlog::logger* logger = nullptr) const
+            -> std::invoke_result_t<Handler, io::FileStream&>
+        {
+            return Resolve(cdns, key, "/{}/data/{}/{}/{}", parser, logger, false, &location);
+        }
+
+        /**
+         * Resolves a BLTE-encoded data file, decoding it while it is downloaded: each chunk is decoded as soon as it was
+         * received, and decoded bytes are handed to an incremental parser right away, while the encoded file is written to
+         * the cache in the background.
+         *
+         * The parser type must provide <tt>bool Feed(std::span<const uint8_t>)</tt>, called with decoded bytes in order,
+         * and <tt>std::optional<T> Finish()</tt>, called once the whole file was decoded.
+         *
+         * @param[in] cdns        A list of available CDNs, as provided by Ribbit.
+         * @param[in] encodingKey The data file's encoding key.
+         * @param[in] contentKey  The data file's content key.
+         * @param[in] makeParser  A callable returning a new parser; it is called again whenever decoding restarts.
+         * @param[in] logger      A logger for errors that occur during download.
+         *
+         * @returns The parsed file or an empty optional if unable to.
+         */
+        template <typename Factory>
+        auto ResolveDecodedData(ribbit::types::CDNs const& cdns,
+            tact::EKey const& encodingKey, tact::CKey const& contentKey,
+            Factory makeParser, spdlog::logger* logger = nullptr) const
+            -> decltype(makeParser().Finish())
+        {
+            return Coalesce(cdns, encodingKey.ToString(), "/{}/data/{}/{}/{}",
+                [&](ribbit::types::cdns::Record const& cdn, std::string const& relativePath) {
+                    return FetchDecoded(cdn, relativePath, encodingKey, contentKey, makeParser, logger);
+                },
+                [&](std::string const& relativePath) {
+                    return DecodeCached(relativePath, encodingKey, contentKey, makeParser);
+                });
+        }
+
+        /**
+         * Resolves a configuration file asynchronously.
+         *
+         * @param[in] cdns   A list of available CDNs, as provided by Ribbit. Must outlive the returned awaitable.
+         * @param[in] key    The configuration file's key.
+         * @param[in] parser A callable in charge of parsing the file.
+         * @param[in] logger A logger for errors that occur during download.
+         *
+         * @returns The parsed file or an empty optional if unable to.
+         */
+        template <typename Handler>
+        auto ResolveConfigurationAsync(ribbit::types::CDNs const& cdns,
+            std::string key, Handler parser, spdlog::logger* logger = nullptr) const
+            -> boost::asio::awaitable<std::invoke_result_t<Handler, io::FileStream&>>
+        {
+            return ResolveAsync(cdns, std::move(key), "/{}/config/{}/{}/{}", std::move(parser), logger);
+        }
+
+        /**
+         * Resolves a data file asynchronously. Downloads do not block the calling thread, which allows many files to be
+         * resolved concurrently on a small amount of threads.
+         *
+         * @param[in] cdns   A list of available CDNs, as provided by Ribbit. Must outlive the returned awaitable.
+         * @param[in] key    The data file's key.
+         * @param[in] parser A callable in charge of parsing the file.
+         * @param[in] logger A logger for errors that occur during download.
+         *
+         * @returns The parsed file or an empty optional if unable to.
+         */
+        template <typename Handler>
+        auto ResolveDataAsync(ribbit::types::CDNs const& cdns,
+            std::string key, Handler parser, spdlog::logger* logger = nullptr) const
+            -> boost::asio::awaitable<std::invoke_result_t<Handler, io::FileStream&>>
+        {
+            return ResolveAsync(cdns, std::move(key), "/{}/data/{}/{}/{}", std::move(parser), logger);
         }
 
     private:
+        template <typename Handler>
+        auto ResolveAsync(ribbit::types::CDNs const& cdns,
+            std::string key, std::string_view formatString,
+            Handler parser,
+            spdlog::logger* logger) const
+            -> boost::asio::awaitable<std::invoke_result_t<Handler, io::FileStream&>>
+        {
+            using ResultType = std::invoke_result_t<Handler, io::FileStream&>;
+
+            for (ribbit::types::cdns::Record const& cdn : cdns) {
+                std::string relativePath{ fmt::format(fmt::runtime(formatString), cdn.Path, key.substr(0, 2), key.substr(2, 2), key) };
+
+                ResultType value;
+                if constexpr (std::is_copy_constructible_v<ResultType>) {
+                    value = co_await utility::SingleFlight::Default().RunAsync(relativePath, [&]() {
+                        return FetchAsync(cdn, relativePath, parser, logger);
+                    });
+                }
+                else {
+                    // The parsed value cannot be shared; share the download and parse the file again from the cache.
+                    bool fetched = co_await utility::SingleFlight::Default().RunAsync(relativePath, [&]() -> boost::asio::awaitable<bool> {
+                        value = co_await FetchAsync(cdn, relativePath, parser, logger);
+                        co_return value.has_value();
+                    });
+
+                    if (!value.has_value() && fetched)
+                        value = _localCache.Resolve(relativePath, parser);
+                }
+
+                if (value.has_value())
+                    co_return value;
+            }
+
+            co_return std::nullopt;
+        }
+
+        template <typename Handler>
+        auto FetchAsync(ribbit::types::cdns::Record const& cdn,
+            std::string relativePath,
+            Handler parser,
+            spdlog::logger* logger) const
+            -> boost::asio::awaitable<std::invoke_result_t<Handler, io::FileStream&>>
+        {
+            auto cachedValue = _localCache.Resolve(relativePath, parser);
+            if (cachedValue.has_value())
+                co_return cachedValue;
+
+            for (std::string const& host : net::HostScoreboard::Default().Rank(cdn.Hosts)) {
+                net::FileDownloadTask downloadTask{ relativePath, _localCache };
+                auto taskResult = co_await downloadTask.RunAsync(host, logger);
+                if (taskResult.has_value()) {
+                    auto parsedValue = parser(*taskResult);
+
+                    if (parsedValue.has_value())
+                        co_return parsedValue;
+                }
+            }
+
+            co_return std::nullopt;
+        }
+
         template <typename Handler>
         auto Resolve(ribbit::types::CDNs const& cdns,
             std::string_view key, std::string_view formatString,
             Handler parser,
-            spdlog::logger* logger = nullptr) const
+            spdlog::logger* logger = nullptr,
+            bool segmented = false,
+            tact::data::ArchiveFileLocation const* archive = nullptr) const
             -> std::invoke_result_t<Handler, io::FileStream&>
         {
+            return Coalesce(cdns, key, formatString,
+                [&](ribbit::types::cdns::Record const& cdn, std::string const& relativePath) {
+                    return Fetch(cdn, relativePath, parser, logger, segmented, archive);
+                },
+                [&](std::string const& relativePath) {
+                    return _localCache.Resolve(relativePath, parser);
+                });
+        }
+
+        /**
+         * Resolves a file from each CDN in turn. Concurrent resolutions of the same file share a single download (see
+         * @ref utility::SingleFlight). If the parsed value can be copied, it is shared as well; otherwise, every caller
+         * parses the downloaded file.
+         *
+         * @param[in] fetch  Obtains and parses the file from a CDN, given the path of the file in the cache.
+         * @param[in] reload Parses the file from the cache.
+         */
+        template <typename Fetcher, typename Reloader>
+        auto Coalesce(ribbit::types::CDNs const& cdns,
+            std::string_view key, std::string_view formatString,
+            Fetcher fetch, Reloader reload) const
+            -> std::invoke_result_t<Fetcher&, ribbit::types::cdns::Record const&, std::string const&>
+        {
+            using ResultType = std::invoke_result_t<Fetcher&, ribbit::types::cdns::Record const&, std::string const&>;
+
             for (ribbit::types::cdns::Record const& cdn : cdns) {
                 std::string relativePath{ fmt::format(fmt::runtime(formatString), cdn.Path, key.substr(0, 2), key.substr(2, 2), key) };
 
-                auto cachedValue = _localCache.Resolve(relativePath, parser);
-                if (cachedValue.has_value())
-                    return cachedValue;
+                ResultType value;
+                if constexpr (std::is_copy_constructible_v<ResultType>) {
+                    value = utility::SingleFlight::Default().Run(relativePath, [&]() {
+                        return fetch(cdn, relativePath);
+                    }).get();
+                }
+                else {
+                    // The parsed value cannot be shared; share the download and parse the file again from the cache.
+                    bool fetched = utility::SingleFlight::Default().Run(relativePath, [&]() {
+                        value = fetch(cdn, relativePath);
+                        return value.has_value();
+                    }).get();
+
+                    if (!value.has_value() && fetched)
+                        value = reload(relativePath);
+                }
+
+                if (value.has_value())
+                    return value;
+            }
 
-                for (std::string_view host : cdn.Hosts) {
-                    net::FileDownloadTask downloadTask{ relativePath, _localCache };
+            return std::nullopt;
+        }
+
+        template <typename Factory>
+        auto DecodeCached(std::string const& relativePath,
+            tact::EKey const& encodingKey, tact::CKey const& contentKey,
+            Factory& makeParser) const
+            -> decltype(makeParser().Finish())
+        {
+            return _localCache.Resolve(relativePath, [&](io::FileStream& fstream) -> decltype(makeParser().Finish()) {
+                if (!fstream)
+                    return std::nullopt;
+
+                auto parser = makeParser();
+                tact::BLTEDecoder decoder { [&](std::span<const uint8_t> data) { return parser.Feed(data); }, encodingKey, contentKey };
+                if (!decoder.Feed(fstream.Data()) || !decoder.Finish())
+                    return std::nullopt;
+
+                return parser.Finish();
+            });
+        }
+
+        template <typename Factory>
+        auto FetchDecoded(ribbit::types::cdns::Record const& cdn,
+            std::string const& relativePath,
+            tact::EKey const& encodingKey, tact::CKey const& contentKey,
+            Factory& makeParser,
+            spdlog::logger* logger) const
+            -> decltype(makeParser().Finish())
+        {
+            auto cachedValue = DecodeCached(relativePath, encodingKey, contentKey, makeParser);
+            if (cachedValue.has_value())
+                return cachedValue;
+
+            for (std::string_view host : net::HostScoreboard::Default().Rank(cdn.Hosts)) {
+                auto parser = makeParser();
+                tact::BLTEDecoder decoder { [&](std::span<const uint8_t> data) { return parser.Feed(data); }, encodingKey, contentKey };
+
+                net::FileDownloadTask downloadTask{ relativePath, _localCache };
+                downloadTask.Observe([&](std::span<const std::byte> data) { return decoder.Feed(data); });
+
+                auto taskResult = downloadTask.Run(_executor, host, logger);
+                if (taskResult.has_value() && decoder.Finish()) {
+                    auto parsedValue = parser.Finish();
+
+                    if (parsedValue.has_value())
+                        return parsedValue;
+                }
+            }
+
+            return std::nullopt;
+        }
+
+        template <typename Handler>
+        auto Fetch(ribbit::types::cdns::Record const& cdn,
+            std::string const& relativePath,
+            Handler& parser,
+            spdlog::logger* logger,
+            bool segmented,
+            tact::data::ArchiveFileLocation const* archive) const
+            -> std::invoke_result_t<Handler, io::FileStream&>
+        {
+            auto cachedValue = _localCache.Resolve(relativePath, parser);
+            if (cachedValue.has_value())
+                return cachedValue;
+
+            if (archive != nullptr) {
+                std::string_view archiveName = archive->name();
+                std::string archivePath{ fmt::format("/{}/data/{}/{}/{}", cdn.Path, archiveName.substr(0, 2), archiveName.substr(2, 2), archiveName) };
+
+                // An archive that is cached in its entirety provides the bytes of the file without going through the network.
+                bool extracted = _localCache.Resolve(archivePath, [&](io::FileStream& archiveStream) -> std::optional<bool> {
+                    std::span<const std::byte> archiveData = archiveStream.Data();
+                    if (!archiveStream || archive->offset() + archive->fileSize() > archiveData.size())
+                        return std::nullopt;
+
+                    archiveData = archiveData.subspan(archive->offset(), archive->fileSize());
+                    return _localCache.WriteAsync(relativePath, std::vector<std::byte> { archiveData.begin(), archiveData.end() }).get();
+                }).value_or(false);
+
+                if (extracted) {
+                    auto extractedValue = _localCache.Resolve(relativePath, parser);
+                    if (extractedValue.has_value())
+                        return extractedValue;
+                }
+
+                for (std::string_view host : net::HostScoreboard::Default().Rank(cdn.Hosts)) {
+                    net::FileDownloadTask downloadTask{ archivePath, archive->offset(), archive->fileSize(), _localCache, relativePath };
                     auto taskResult = downloadTask.Run(_executor, host, logger);
                     if (taskResult.has_value()) {
                         auto parsedValue = parser(*taskResult);
@@ -87,6 +412,28 @@ namespace libtactmon::tact::data::product {
                             return parsedValue;
                     }
                 }
+
+                return std::nullopt;
+            }
+
+            if (segmented || _hedging) {
+                net::SegmentedDownload download { relativePath, _localCache, net::SegmentedDownload::Options { .Hedge = _hedging } };
+                auto downloadResult = download.Run(_executor, cdn.Hosts, logger);
+                if (downloadResult.has_value())
+                    return parser(*downloadResult);
+
+                return std::nullopt;
+            }
+
+            for (std::string_view host : net::HostScoreboard::Default().Rank(cdn.Hosts)) {
+                net::FileDownloadTask downloadTask{ relativePath, _localCache };
+                auto taskResult = downloadTask.Run(_executor, host, logger);
+                if (taskResult.has_value()) {
+                    auto parsedValue = parser(*taskResult);
+
+                    if (parsedValue.has_value())
+                        return parsedValue;
+                }
             }
 
             return std::nullopt;
@@ -94,6 +441,7 @@ namespace libtactmon::tact::data::product {
 
     protected:
         boost::asio::any_io_executor _executor;
+        bool _hedging = false;
 
     public:
         tact::Cache& _localCache;
@@ -0,0 +1,528 @@
+#include "libtactmon/io/IReadableStream.hpp"
+#include "libtactmon/tact/data/product/wow/Listfile.hpp"
+#include "libtactmon/utility/Path.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <numeric>
+
+namespace libtactmon::tact::data::product::wow {
+    struct ListfileHeader {
+        uint32_t Signature;
+        uint32_t Version;
+        uint32_t EntryCount;
+        uint32_t BucketCount;
+        uint32_t Seed;
+        uint32_t ArenaSize;
+    };
+
+    constexpr static const uint32_t ListfileSignature = 0x5846494C; // 'LIFX'
+    constexpr static const uint32_t ListfileVersion = 1;
+
+    constexpr static const std::size_t BlockSize = 16;  // Amount of paths per front-coded block.
+    constexpr static const std::size_t BucketLoad = 4;  // Average amount of paths per perfect hash bucket.
+    constexpr static const uint32_t MaxDisplacement = 1u << 24;
+    constexpr static const uint32_t MaxSeedAttempts = 16;
+
+    // Buckets holding a single path directly store its slot, flagged with this bit.
+    constexpr static const uint32_t DirectSlotFlag = 0x80000000u;
+
+    static std::string NormalizePath(std::string_view path) {
+        std::string normalizedPath(path.size(), '\0');
+        std::transform(path.begin(), path.end(), normalizedPath.begin(), &utility::normalize_path_character);
+        return normalizedPath;
+    }
+
+    static uint64_t MixHash(uint64_t value) {
+        value ^= value >> 30;
+        value *= 0xBF58476D1CE4E5B9uLL;
+        value ^= value >> 27;
+        value *= 0x94D049BB133111EBuLL;
+        value ^= value >> 31;
+        return value;
+    }
+
+    static uint64_t HashPath(std::string_view normalizedPath, uint32_t seed) {
+        return MixHash(utility::path_hash(normalizedPath, seed));
+    }
+
+    static std::size_t BucketOf(uint64_t hash, std::size_t bucketCount) {
+        return (hash >> 32) % bucketCount;
+    }
+
+    static std::size_t DisplaceSlot(uint64_t hash, uint32_t displacement, std::size_t slotCount) {
+        return MixHash(hash + displacement * 0x9E3779B97F4A7C15uLL) % slotCount;
+    }
+
+    static void WriteVarInt(std::vector<uint8_t>& data, uint32_t value) {
+        while (value >= 0x80) {
+            data.push_back(static_cast<uint8_t>(value | 0x80));
+            value >>= 7;
+        }
+        data.push_back(static_cast<uint8_t>(value));
+    }
+
+    static uint32_t ReadVarInt(std::span<const uint8_t> data, std::size_t& offset) {
+        uint32_t value = 0;
+        for (uint32_t shift = 0; offset < data.size(); shift += 7) {
+            uint8_t byte = data[offset++];
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                break;
+        }
+        return value;
+    }
+
+    /**
+     * Bounds-checked counterpart of @ref ReadVarInt, used to validate images that were not built by this process.
+     *
+     * @returns The value, or an empty optional if the encoding is truncated or does not fit in 32 bits.
+     */
+    static std::optional<uint32_t> TryReadVarInt(std::span<const uint8_t> data, std::size_t& offset) {
+        uint32_t value = 0;
+        for (uint32_t shift = 0; shift < 32 && offset < data.size(); shift += 7) {
+            uint8_t byte = data[offset++];
+            if (shift == 28 && (byte & 0xF0) != 0)
+                return std::nullopt;
+
+            value |= static_cast<uint32_t>(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return value;
+        }
+        return std::nullopt;
+    }
+
+    /**
+     * Builds a minimal perfect hash over the given hashes using hash-and-displace: keys are grouped into buckets, which are
+     * placed from the largest to the smallest, looking for the first displacement that sends every key of the bucket to a
+     * free slot.
+     *
+     * @returns false if no suitable displacement could be found for a bucket; the caller should retry with another seed.
+     */
+    static bool BuildPerfectHash(std::span<const uint64_t> hashes, std::vector<uint32_t>& buckets, std::vector<uint32_t>& slots) {
+        std::size_t slotCount = hashes.size();
+        std::size_t bucketCount = buckets.size();
+
+        // Group keys by bucket.
+        std::vector<uint32_t> bucketStart(bucketCount + 1, 0);
+        for (uint64_t hash : hashes)
+            ++bucketStart[BucketOf(hash, bucketCount) + 1];
+        std::partial_sum(bucketStart.begin(), bucketStart.end(), bucketStart.begin());
+
+        std::vector<uint32_t> keys(slotCount);
+        std::vector<uint32_t> cursors(bucketStart.begin(), bucketStart.end() - 1);
+        for (uint32_t i = 0; i < slotCount; ++i)
+            keys[cursors[BucketOf(hashes[i], bucketCount)]++] = i;
+
+        std::vector<uint32_t> order(bucketCount);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](uint32_t left, uint32_t right) {
+            return bucketStart[left + 1] - bucketStart[left] > bucketStart[right + 1] - bucketStart[right];
+        });
+
+        std::vector<bool> occupied(slotCount, false);
+        std::vector<std::size_t> candidates;
+        std::size_t freeSlot = 0;
+
+        for (uint32_t bucket : order) {
+            std::span<const uint32_t> bucketKeys { keys.data() + bucketStart[bucket], bucketStart[bucket + 1] - bucketStart[bucket] };
+            if (bucketKeys.empty())
+                break;
+
+            if (bucketKeys.size() == 1) {
+                while (occupied[freeSlot])
+                    ++freeSlot;
+
+                occupied[freeSlot] = true;
+                slots[freeSlot] = bucketKeys[0];
+                buckets[bucket] = DirectSlotFlag | static_cast<uint32_t>(freeSlot);
+                continue;
+            }
+
+            for (uint32_t displacement = 0; ; ++displacement) {
+                if (displacement == MaxDisplacement)
+                    return false;
+
+                candidates.clear();
+                for (uint32_t key : bucketKeys) {
+                    std::size_t slot = DisplaceSlot(hashes[key], displacement, slotCount);
+                    if (occupied[slot] || std::find(candidates.begin(), candidates.end(), slot) != candidates.end())
+                        break;
+
+                    candidates.push_back(slot);
+                }
+
+                if (candidates.size() != bucketKeys.size())
+                    continue;
+
+                for (std::size_t i = 0; i < candidates.size(); ++i) {
+                    occupied[candidates[i]] = true;
+                    slots[candidates[i]] = bucketKeys[i];
+                }
+                buckets[bucket] = displacement;
+                break;
+            }
+        }
+
+        return true;
+    }
+
+    template <typename T>
+    static void AppendImage(std::vector<std::byte>& image, std::span<const T> data) {
+        if (data.empty())
+            return;
+
+        std::size_t offset = image.size();
+        image.resize(offset + data.size_bytes());
+        std::memcpy(image.data() + offset, data.data(), data.size_bytes());
+    }
+
+    std::optional<Listfile> Listfile::Parse(io::IReadableStream& stream) {
+        struct Record {
+            uint32_t FileDataID;
+            std::size_t Offset;
+            std::size_t Length;
+        };
+
+        stream.Advise(io::AccessPattern::Sequential);
+        stream.Prefetch(stream.GetReadCursor(), stream.GetLength() - stream.GetReadCursor());
+
+        std::span<const std::byte> data = stream.Data();
+        std::string_view contents { reinterpret_cast<const char*>(data.data()), data.size() };
+
+        std::string paths;
+        std::vector<Record> records;
+        while (!contents.empty()) {
+            std::size_t lineEnd = contents.find('\n');
+            std::string_view line = contents.substr(0, lineEnd);
+            contents.remove_prefix(lineEnd == std::string_view::npos ? contents.size() : lineEnd + 1);
+
+            if (!line.empty() && line.back() == '\r')
+                line.remove_suffix(1);
+
+            std::size_t separator = line.find(';');
+            if (separator == std::string_view::npos || separator + 1 == line.size())
+                continue;
+
+            uint32_t fileDataID = 0;
+            auto [ptr, ec] = std::from_chars(line.data(), line.data() + separator, fileDataID);
+            if (ec != std::errc{ } || ptr != line.data() + separator)
+                continue;
+
+            std::string_view path = line.substr(separator + 1);
+            records.push_back(Record { fileDataID, paths.size(), path.size() });
+            std::transform(path.begin(), path.end(), std::back_inserter(paths), &utility::normalize_path_character);
+        }
+        stream.SkipRead(data.size());
+
+        if (records.empty() || records.size() >= DirectSlotFlag)
+            return std::nullopt;
+
+        auto pathOf = [&paths](Record const& record) {
+            return std::string_view { paths }.substr(record.Offset, record.Length);
+        };
+
+        std::stable_sort(records.begin(), records.end(), [&](Record const& left, Record const& right) {
+            return pathOf(left) < pathOf(right);
+        });
+        records.erase(std::unique(records.begin(), records.end(), [&](Record const& left, Record const& right) {
+            return pathOf(left) == pathOf(right);
+        }), records.end());
+
+        std::size_t entryCount = records.size();
+        std::size_t blockCount = (entryCount + BlockSize - 1) / BlockSize;
+
+        std::vector<uint32_t> fileDataIDs(entryCount);
+        std::vector<uint32_t> blockOffsets(blockCount);
+        std::vector<uint8_t> arena;
+        std::vector<uint64_t> hashes(entryCount);
+
+        std::string_view previousPath;
+        for (std::size_t i = 0; i < entryCount; ++i) {
+            std::string_view path = pathOf(records[i]);
+            fileDataIDs[i] = records[i].FileDataID;
+
+            if (i % BlockSize == 0) {
+                blockOffsets[i / BlockSize] = static_cast<uint32_t>(arena.size());
+                WriteVarInt(arena, static_cast<uint32_t>(path.size()));
+                arena.insert(arena.end(), path.begin(), path.end());
+            }
+            else {
+                std::size_t sharedLength = std::mismatch(previousPath.begin(), previousPath.end(), path.begin(), path.end()).first - previousPath.begin();
+                WriteVarInt(arena, static_cast<uint32_t>(sharedLength));
+                WriteVarInt(arena, static_cast<uint32_t>(path.size() - sharedLength));
+                arena.insert(arena.end(), path.begin() + sharedLength, path.end());
+            }
+
+            previousPath = path;
+        }
+
+        std::vector<uint32_t> byFileDataID(entryCount);
+        std::iota(byFileDataID.begin(), byFileDataID.end(), 0);
+        std::stable_sort(byFileDataID.begin(), byFileDataID.end(), [&](uint32_t left, uint32_t right) {
+            return fileDataIDs[left] < fileDataIDs[right];
+        });
+
+        std::vector<uint32_t> buckets(std::max<std::size_t>(1, (entryCount + BucketLoad - 1) / BucketLoad));
+        std::vector<uint32_t> slots(entryCount);
+
+        uint32_t seed = 0;
+        for (;; ++seed) {
+            if (seed == MaxSeedAttempts)
+                return std::nullopt;
+
+            for (std::size_t i = 0; i < entryCount; ++i)
+                hashes[i] = HashPath(pathOf(records[i]), seed);
+
+            std::fill(buckets.begin(), buckets.end(), 0);
+            if (BuildPerfectHash(hashes, buckets, slots))
+                break;
+        }
+
+        ListfileHeader header {
+            .Signature = ListfileSignature,
+            .Version = ListfileVersion,
+            .EntryCount = static_cast<uint32_t>(entryCount),
+            .BucketCount = static_cast<uint32_t>(buckets.size()),
+            .Seed = seed,
+            .ArenaSize = static_cast<uint32_t>(arena.size())
+        };
+
+        Listfile instance;
+        instance._storage.reserve(sizeof(ListfileHeader)
+            + sizeof(uint32_t) * (fileDataIDs.size() + byFileDataID.size() + blockOffsets.size() + buckets.size() + slots.size())
+            + arena.size());
+
+        AppendImage(instance._storage, std::span<const ListfileHeader> { &header, 1 });
+        AppendImage<uint32_t>(instance._storage, fileDataIDs);
+        AppendImage<uint32_t>(instance._storage, byFileDataID);
+        AppendImage<uint32_t>(instance._storage, blockOffsets);
+        AppendImage<uint32_t>(instance._storage, buckets);
+        AppendImage<uint32_t>(instance._storage, slots);
+        AppendImage<uint8_t>(instance._storage, arena);
+
+        if (!instance.Bind(instance._storage))
+            return std::nullopt;
+
+        return instance;
+    }
+
+    std::optional<Listfile> Listfile::Load(io::FileStream const& stream) {
+        if (!stream)
+            return std::nullopt;
+
+        Listfile instance;
+        instance._mapping.emplace(stream);
+        instance._mapping->SeekRead(0);
+
+        // Lookups hit arbitrary blocks of the image; reading ahead around them would only waste memory.
+        instance._mapping->Advise(io::AccessPattern::Random);
+
+        if (!instance.Bind(instance._mapping->Data()))
+            return std::nullopt;
+
+        return instance;
+    }
+
+    bool Listfile::Save(std::filesystem::path const& filePath) const {
+        std::ofstream outputStream(filePath, std::ios::binary | std::ios::trunc);
+        if (!outputStream)
+            return false;
+
+        outputStream.write(reinterpret_cast<const char*>(_image.data()), static_cast<std::streamsize>(_image.size()));
+        return outputStream.good();
+    }
+
+    bool Listfile::Bind(std::span<const std::byte> image) {
+        if (image.size() < sizeof(ListfileHeader))
+            return false;
+
+        ListfileHeader header;
+        std::memcpy(&header, image.data(), sizeof(ListfileHeader));
+        if (header.Signature != ListfileSignature || header.Version != ListfileVersion)
+            return false;
+
+        std::size_t entryCount = header.EntryCount;
+        std::size_t blockCount = (entryCount + BlockSize - 1) / BlockSize;
+        if (header.BucketCount == 0 || entryCount >= DirectSlotFlag)
+            return false;
+
+        std::size_t imageSize = sizeof(ListfileHeader)
+            + sizeof(uint32_t) * (entryCount * 3 + blockCount + header.BucketCount)
+            + header.ArenaSize;
+        if (image.size() < imageSize)
+            return false;
+
+        std::size_t offset = sizeof(ListfileHeader);
+        auto bindArray = [&](std::size_t count) {
+            std::span<const uint32_t> array { reinterpret_cast<const uint32_t*>(image.data() + offset), count };
+            offset += count * sizeof(uint32_t);
+            return array;
+        };
+
+        _fileDataIDs = bindArray(entryCount);
+        _byFileDataID = bindArray(entryCount);
+        _blockOffsets = bindArray(blockCount);
+        _buckets = bindArray(header.BucketCount);
+        _slots = bindArray(entryCount);
+        _arena = std::span { reinterpret_cast<const uint8_t*>(image.data() + offset), header.ArenaSize };
+
+        // Lookups index these arrays and decode the arena without bounds checks; reject any image that would let them
+        // reach past the mapping.
+        auto inRange = [entryCount](uint32_t index) { return index < entryCount; };
+        if (!std::all_of(_byFileDataID.begin(), _byFileDataID.end(), inRange) || !std::all_of(_slots.begin(), _slots.end(), inRange))
+            return false;
+
+        for (uint32_t bucket : _buckets)
+            if ((bucket & DirectSlotFlag) && !inRange(bucket & ~DirectSlotFlag))
+                return false;
+
+        if (!ValidateArena())
+            return false;
+
+        _image = image.subspan(0, imageSize);
+        _seed = header.Seed;
+        return true;
+    }
+
+    bool Listfile::ValidateArena() const {
+        std::size_t offset = 0;
+        std::size_t pathLength = 0;
+        for (std::size_t i = 0; i < _fileDataIDs.size(); ++i) {
+            if (i % BlockSize == 0) {
+                if (_blockOffsets[i / BlockSize] != offset)
+                    return false;
+
+                std::optional<uint32_t> length = TryReadVarInt(_arena, offset);
+                if (!length.has_value() || *length > _arena.size() - offset)
+                    return false;
+
+                pathLength = *length;
+                offset += *length;
+            }
+            else {
+                std::optional<uint32_t> sharedLength = TryReadVarInt(_arena, offset);
+                if (!sharedLength.has_value() || *sharedLength > pathLength)
+                    return false;
+
+                std::optional<uint32_t> suffixLength = TryReadVarInt(_arena, offset);
+                if (!suffixLength.has_value() || *suffixLength > _arena.size() - offset)
+                    return false;
+
+                pathLength = *sharedLength + *suffixLength;
+                offset += *suffixLength;
+            }
+        }
+
+        return true;
+    }
+
+    std::size_t Listfile::FindSlot(std::string_view normalizedPath) const {
+        uint64_t hash = HashPath(normalizedPath, _seed);
+
+        uint32_t bucket = _buckets[BucketOf(hash, _buckets.size())];
+        if (bucket & DirectSlotFlag)
+            return bucket & ~DirectSlotFlag;
+
+        return DisplaceSlot(hash, bucket, _slots.size());
+    }
+
+    std::string_view Listfile::BlockHead(std::size_t blockIndex) const {
+        std::size_t offset = _blockOffsets[blockIndex];
+        uint32_t length = ReadVarInt(_arena, offset);
+        return std::string_view { reinterpret_cast<const char*>(_arena.data() + offset), length };
+    }
+
+    void Listfile::DecodePath(std::size_t index, std::string& path) const {
+        std::size_t blockIndex = index / BlockSize;
+        std::size_t offset = _blockOffsets[blockIndex];
+
+        uint32_t length = ReadVarInt(_arena, offset);
+        path.assign(reinterpret_cast<const char*>(_arena.data() + offset), length);
+        offset += length;
+
+        for (std::size_t i = blockIndex * BlockSize; i < index; ++i) {
+            uint32_t sharedLength = ReadVarInt(_arena, offset);
+            uint32_t suffixLength = ReadVarInt(_arena, offset);
+
+            path.resize(sharedLength);
+            path.append(reinterpret_cast<const char*>(_arena.data() + offset), suffixLength);
+            offset += suffixLength;
+        }
+    }
+
+    std::optional<uint32_t> Listfile::FindFile(std::string_view filePath) const {
+        if (_slots.empty())
+            return std::nullopt;
+
+        std::string normalizedPath = NormalizePath(filePath);
+        uint32_t index = _slots[FindSlot(normalizedPath)];
+
+        // The perfect hash maps unknown paths to arbitrary entries; confirm the match.
+        std::string candidate;
+        DecodePath(index, candidate);
+        if (candidate != normalizedPath)
+            return std::nullopt;
+
+        return _fileDataIDs[index];
+    }
+
+    std::optional<std::string> Listfile::FindPath(uint32_t fileDataID) const {
+        auto itr = std::lower_bound(_byFileDataID.begin(), _byFileDataID.end(), fileDataID, [this](uint32_t index, uint32_t value) {
+            return _fileDataIDs[index] < value;
+        });
+        if (itr == _byFileDataID.end() || _fileDataIDs[*itr] != fileDataID)
+            return std::nullopt;
+
+        std::string path;
+        DecodePath(*itr, path);
+        return path;
+    }
+
+    void Listfile::ForEachFile(std::string_view prefix, std::function<bool(std::string_view, uint32_t)> const& handler) const {
+        std::string normalizedPrefix = NormalizePath(prefix);
+
+        // Find the first block whose head is not less than the prefix; matches may also begin in the block preceding it.
+        std::size_t first = 0;
+        std::size_t last = _blockOffsets.size();
+        while (first < last) {
+            std::size_t middle = first + (last - first) / 2;
+            if (BlockHead(middle) < normalizedPrefix)
+                first = middle + 1;
+            else
+                last = middle;
+        }
+
+        std::size_t blockIndex = first == 0 ? 0 : first - 1;
+        std::size_t offset = 0;
+        std::string path;
+        for (std::size_t i = blockIndex * BlockSize; i < _fileDataIDs.size(); ++i) {
+            if (i % BlockSize == 0) {
+                offset = _blockOffsets[i / BlockSize];
+
+                uint32_t length = ReadVarInt(_arena, offset);
+                path.assign(reinterpret_cast<const char*>(_arena.data() + offset), length);
+                offset += length;
+            }
+            else {
+                uint32_t sharedLength = ReadVarInt(_arena, offset);
+                uint32_t suffixLength = ReadVarInt(_arena, offset);
+
+                path.resize(sharedLength);
+                path.append(reinterpret_cast<const char*>(_arena.data() + offset), suffixLength);
+                offset += suffixLength;
+            }
+
+            if (path < normalizedPrefix)
+                continue;
+
+            if (!path.starts_with(normalizedPrefix))
+                break;
+
+            if (!handler(path, _fileDataIDs[i]))
+                break;
+        }
+    }
+}
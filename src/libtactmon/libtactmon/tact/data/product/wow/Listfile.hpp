@@ -0,0 +1,112 @@
+#pragma once
+
+#include "libtactmon/detail/Export.hpp"
+#include "libtactmon/io/FileStream.hpp"
+
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace libtactmon::io {
+    struct IReadableStream;
+}
+
+namespace libtactmon::tact::data::product::wow {
+    /**
+     * An index of file paths as provided by community listfiles, which are CSV files where each line is of the form `FDID;path`.
+     *
+     * Paths are normalized (lowercase, forward slashes) and stored sorted, front-coded in blocks; exact lookups go through a
+     * minimal perfect hash of the paths, while prefix enumeration binary searches over the blocks. The in-memory representation
+     * is the same as the on-disk one, so a persisted index can be memory-mapped back without parsing.
+     */
+    struct LIBTACTMON_API Listfile final {
+        /**
+         * Parses a listfile in CSV form.
+         *
+         * @param[in] stream A stream over the contents of the listfile.
+         *
+         * @returns The listfile, or an empty optional if the stream does not contain any valid entry.
+         */
+        static std::optional<Listfile> Parse(io::IReadableStream& stream);
+
+        /**
+         * Loads a listfile index that was previously persisted by @ref Save.
+         *
+         * @param[in] stream A stream over the persisted index. The mapping is shared with the returned instance.
+         *
+         * @returns The listfile, or an empty optional if the file is not a valid index.
+         */
+        static std::optional<Listfile> Load(io::FileStream const& stream);
+
+        /**
+         * Persists this index to disk.
+         *
+         * @param[in] filePath The path to the file to write.
+         * @returns true if the index was written successfully.
+         */
+        bool Save(std::filesystem::path const& filePath) const;
+
+    private:
+        Listfile() = default;
+
+    public:
+        Listfile(Listfile&& other) noexcept = default;
+        Listfile& operator = (Listfile&& other) noexcept = default;
+
+        Listfile(Listfile const&) = delete;
+        Listfile& operator = (Listfile const&) = delete;
+
+        /**
+         * Returns the number of paths in this listfile.
+         */
+        [[nodiscard]] std::size_t size() const { return _fileDataIDs.size(); }
+
+        /**
+         * Returns the file data ID associated with a path, or an empty optional if the path is unknown.
+         *
+         * @param[in] filePath The complete path to the file. Case and path separators are not significant.
+         */
+        [[nodiscard]] std::optional<uint32_t> FindFile(std::string_view filePath) const;
+
+        /**
+         * Returns the normalized path associated with a file data ID, or an empty optional if the file data ID is unknown.
+         */
+        [[nodiscard]] std::optional<std::string> FindPath(uint32_t fileDataID) const;
+
+        /**
+         * Enumerates, in lexicographic order, every path that starts with the given prefix.
+         *
+         * @param[in] prefix  The prefix to look for. Case and path separators are not significant.
+         * @param[in] handler A callable receiving each normalized path and its file data ID. The path is only valid for the
+         *                    duration of the call. Enumeration stops if the handler returns false.
+         */
+        void ForEachFile(std::string_view prefix, std::function<bool(std::string_view, uint32_t)> const& handler) const;
+
+    private:
+        bool Bind(std::span<const std::byte> image);
+        [[nodiscard]] bool ValidateArena() const;
+
+        [[nodiscard]] std::size_t FindSlot(std::string_view normalizedPath) const;
+        [[nodiscard]] std::string_view BlockHead(std::size_t blockIndex) const;
+        void DecodePath(std::size_t index, std::string& path) const;
+
+        //! Backing storage for the index; either owned, or a memory mapping of a persisted index.
+        std::vector<std::byte> _storage;
+        std::optional<io::FileStream> _mapping;
+        std::span<const std::byte> _image;
+
+        uint32_t _seed = 0;
+
+        std::span<const uint32_t> _fileDataIDs;  //< File data IDs, in path order.
+        std::span<const uint32_t> _byFileDataID; //< Indices into the path order, sorted by file data ID.
+        std::span<const uint32_t> _blockOffsets; //< Offsets of each front-coded block of paths in the arena.
+        std::span<const uint32_t> _buckets;      //< Perfect hash displacements.
+        std::span<const uint32_t> _slots;        //< Perfect hash slots, mapped to indices into the path order.
+        std::span<const uint8_t> _arena;
+    };
+}
@@ -12,6 +12,9 @@ namespace libtactmon::tact::data::product::wow {
         if (!tact::data::product::Product::Load(buildConfig, cdnConfig))
             return false;
 
+        StageTimer stages { *this };
+        stages.Enter("root");
+
         std::optional<tact::data::FileLocation> rootLocation = Base::FindFile(_buildConfig->Root);
         if (!rootLocation)
             return false;
@@ -22,14 +25,10 @@ namespace libtactmon::tact::data::product::wow {
             for (std::size_t i = 0; i < rootLocation->keyCount(); ++i) {
                 tact::EKey key = (*rootLocation)[i];
 
-                auto root = Base::ResolveCachedData(key.ToString(), [&encoding = _encoding](io::IReadableStream& fstream)
-                    -> std::optional<tact::data::product::wow::Root>
-                {
-                    std::optional<tact::BLTE> blte = tact::BLTE::Parse(fstream);
-                    if (blte.has_value())
-                        return tact::data::product::wow::Root::Parse(blte->GetStream(), encoding->GetContentKeySize());
-
-                    return std::nullopt;
+                auto root = Base::ResolveDecodedData(key, _buildConfig->Root, [contentKeySize = _encoding->GetContentKeySize()]() {
+                    return BufferingParser { [contentKeySize](io::IReadableStream& stream) {
+                        return tact::data::product::wow::Root::Parse(stream, contentKeySize);
+                    } };
                 });
                 if (root.has_value())
                     return root;
@@ -53,6 +52,17 @@ namespace libtactmon::tact::data::product::wow {
         if (parentResult.has_value())
             return parentResult;
 
+        // Try the listfile, which is an exact lookup, before scanning root. The listfile is not specific to this build,
+        // so its file data ID may be missing here while root still knows the name hash.
+        if (_listfile != nullptr) {
+            std::optional<uint32_t> fileDataID = _listfile->FindFile(fileName);
+            if (fileDataID.has_value()) {
+                std::optional<tact::data::FileLocation> listfileResult = FindFile(*fileDataID);
+                if (listfileResult.has_value())
+                    return listfileResult;
+            }
+        }
+
         std::optional<tact::CKey> contentKey = [&]() -> std::optional<tact::CKey> {
             // Try in root (which would use jenkins96 hash)
             if (_root.has_value()) {
@@ -2,10 +2,12 @@
 
 #include "libtactmon/detail/Export.hpp"
 #include "libtactmon/tact/data/product/Product.hpp"
+#include "libtactmon/tact/data/product/wow/Listfile.hpp"
 #include "libtactmon/tact/data/product/wow/Root.hpp"
 
 #include <array>
 #include <cstdint>
+#include <memory>
 #include <optional>
 #include <vector>
 
@@ -22,7 +24,20 @@ namespace libtactmon::tact::data::product::wow {
 
         bool Load(std::string_view buildConfig, std::string_view cdnConfig) noexcept override;
 
+        /**
+         * Returns the root manifest of the currently loaded configuration, if any.
+         */
+        [[nodiscard]] std::optional<tact::data::product::wow::Root> const& root() const { return _root; }
+
+        /**
+         * Sets the listfile used to resolve file paths that are not known to the install manifest.
+         *
+         * @param[in] listfile The listfile. It may be shared between products.
+         */
+        void SetListfile(std::shared_ptr<const tact::data::product::wow::Listfile> listfile) { _listfile = std::move(listfile); }
+
     private:
         std::optional<tact::data::product::wow::Root> _root;
+        std::shared_ptr<const tact::data::product::wow::Listfile> _listfile;
     };
 }
@@ -1,7 +1,13 @@
 #include "libtactmon/crypto/Jenkins.hpp"
+#include "libtactmon/io/SpanReader.hpp"
 #include "libtactmon/tact/data/product/wow/Root.hpp"
 #include "libtactmon/utility/Endian.hpp"
 
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <vector>
+
 #include <boost/asio/io_context.hpp>
 #include <boost/asio/thread_pool.hpp>
 #include <boost/thread/future.hpp>
@@ -22,41 +28,39 @@ namespace libtactmon::tact::data::product::wow {
 
         block.entries.reserve(pageInfo.numRecords);
 
-        io::SpanStream stream { pageInfo.data.value() };
+        io::SpanReader reader { pageInfo.data.value() };
 
-        std::span<uint32_t const> fileDataIDs = stream.Data<uint32_t>().subspan(0, pageInfo.numRecords);
-        stream.SkipRead(pageInfo.numRecords * sizeof(uint32_t));
+        // Delta-encoded file data IDs, converted in bulk.
+        std::vector<uint32_t> fileDataIDs(pageInfo.numRecords);
+        reader.ReadArray<uint32_t, std::endian::little>(fileDataIDs);
 
         uint32_t fileDataID = -1;
 
         if (interleave) {
             for (std::size_t i = 0; i < pageInfo.numRecords; ++i) {
-                fileDataID += utility::to_endianness<std::endian::little>(fileDataIDs[i]) + 1;
-
-                std::span<const uint8_t> hashSpan = stream.Data<uint8_t>().subspan(0, contentKeySize);
-                stream.SkipRead(contentKeySize);
+                fileDataID += fileDataIDs[i] + 1;
 
-                uint64_t nameHash = stream.Read<uint64_t>(std::endian::little); // Jenkins96 of the file's path
+                std::span<const uint8_t> hashSpan = reader.ReadSpan<uint8_t>(contentKeySize);
+                uint64_t nameHash = reader.Read<uint64_t, std::endian::little>(); // Jenkins96 of the file's path
 
                 block.entries.emplace_back(tact::CKey{ hashSpan }, fileDataID, nameHash);
             }
         }
         else {
-            std::span<const uint8_t> hashSpan = stream.Data<uint8_t>().subspan(0, pageInfo.numRecords * contentKeySize);
-            stream.SkipRead(hashSpan.size());
+            std::span<const uint8_t> hashSpan = reader.ReadSpan<uint8_t>(pageInfo.numRecords * contentKeySize);
 
             if (!canSkip || (static_cast<uint32_t>(block.Content) & static_cast<uint32_t>(Root::ContentFlags::NoNameHash)) == 0) {
                 for (std::size_t i = 0; i < pageInfo.numRecords; ++i) {
-                    fileDataID += utility::to_endianness<std::endian::little>(fileDataIDs[i]) + 1;
+                    fileDataID += fileDataIDs[i] + 1;
 
-                    uint64_t nameHash = stream.Read<uint64_t>(std::endian::little); // Jenkins96 of the file's path
+                    uint64_t nameHash = reader.Read<uint64_t, std::endian::little>(); // Jenkins96 of the file's path
 
                     block.entries.emplace_back(tact::CKey{ hashSpan.subspan(i * contentKeySize, contentKeySize) }, fileDataID, nameHash);
                 }
             }
             else {
                 for (std::size_t i = 0; i < pageInfo.numRecords; ++i) {
-                    fileDataID += utility::to_endianness<std::endian::little>(fileDataIDs[i]) + 1;
+                    fileDataID += fileDataIDs[i] + 1;
                     block.entries.emplace_back(tact::CKey{ hashSpan.subspan(i * contentKeySize, contentKeySize) }, fileDataID, 0);
                 }
             }
@@ -66,20 +70,21 @@ namespace libtactmon::tact::data::product::wow {
     }
 
     /* static */ std::optional<Root> Root::Parse(io::IReadableStream& stream, std::size_t contentKeySize) {
-        if (!stream.CanRead(sizeof(uint32_t)))
+        io::SpanReader reader { stream, io::AccessPattern::Sequential };
+        if (!reader.CanRead(sizeof(uint32_t)))
             return std::nullopt;
 
-        uint32_t magic = stream.Read<uint32_t>(std::endian::little);
+        uint32_t magic = reader.Read<uint32_t, std::endian::little>();
 
         bool interleave = true;
         bool canSkip = false;
 
         if (magic == 0x4D465354) {
-            if (!stream.CanRead(sizeof(uint32_t) * 2))
+            if (!reader.CanRead(sizeof(uint32_t) * 2))
                 return std::nullopt;
 
-            uint32_t totalFileCount = stream.Read<uint32_t>(std::endian::little);
-            uint32_t namedFileCount = stream.Read<uint32_t>(std::endian::little);
+            uint32_t totalFileCount = reader.Read<uint32_t, std::endian::little>();
+            uint32_t namedFileCount = reader.Read<uint32_t, std::endian::little>();
 
             interleave = false;
             canSkip = totalFileCount != namedFileCount;
@@ -90,14 +95,14 @@ namespace libtactmon::tact::data::product::wow {
 
         std::list<boost::future<std::optional<Block>>> futures;
 
-        while (stream.GetReadCursor() < stream.GetLength()) {
-            if (!stream.CanRead(12))
+        while (reader.remaining() != 0) {
+            if (!reader.CanRead(12))
                 return std::nullopt;
 
             PageInfo page;
-            page.numRecords = stream.Read<uint32_t>(std::endian::little);
-            page.contentFlags = static_cast<ContentFlags>(stream.Read<uint32_t>(std::endian::little));
-            page.localeFlags = static_cast<LocaleFlags>(stream.Read<uint32_t>(std::endian::little));
+            page.numRecords = reader.Read<uint32_t, std::endian::little>();
+            page.contentFlags = static_cast<ContentFlags>(reader.Read<uint32_t, std::endian::little>());
+            page.localeFlags = static_cast<LocaleFlags>(reader.Read<uint32_t, std::endian::little>());
 
             std::size_t length = sizeof(uint32_t) * page.numRecords; // u32 fileDataID[numRecords]
             if (interleave) {
@@ -111,11 +116,10 @@ namespace libtactmon::tact::data::product::wow {
                 }
             }
 
-            if (!stream.CanRead(length))
+            if (!reader.CanRead(length))
                 return std::nullopt;
 
-            page.data.emplace(stream.Data().subspan(0, length));
-            stream.SkipRead(length);
+            page.data.emplace(reader.ReadSpan(length));
 
             auto blockLoader = std::make_shared<boost::packaged_task<std::optional<Block>>>([pageInfo = std::move(page), interleave, canSkip, contentKeySize]() {
                 return ParseBlock(pageInfo, contentKeySize, interleave, canSkip);
@@ -168,6 +172,110 @@ namespace libtactmon::tact::data::product::wow {
         return *this;
     }
 
+    /**
+     * Walks the entries of a root manifest in ascending file data ID order, merging its (individually sorted) blocks.
+     */
+    struct EntryCursor final {
+        explicit EntryCursor(std::vector<Root::Block> const& blocks) : _blocks(blocks) {
+            for (std::size_t i = 0; i < _blocks.size(); ++i)
+                if (!_blocks[i].entries.empty())
+                    _heap.push(Position { _blocks[i].entries[0].FileDataID, i, 0 });
+        }
+
+        /**
+         * Collects the content keys of every entry sharing the next file data ID.
+         *
+         * @returns false if all entries have been consumed.
+         */
+        bool Next() {
+            _contentKeys.clear();
+            if (_heap.empty())
+                return false;
+
+            _fileDataID = _heap.top().FileDataID;
+            while (!_heap.empty() && _heap.top().FileDataID == _fileDataID) {
+                Position position = _heap.top();
+                _heap.pop();
+
+                std::vector<Root::Entry> const& entries = _blocks[position.Block].entries;
+                tact::CKey const& contentKey = entries[position.Entry].ContentKey;
+                if (std::ranges::none_of(_contentKeys, [&](tact::CKey const* key) { return *key == contentKey; }))
+                    _contentKeys.push_back(std::addressof(contentKey));
+
+                if (++position.Entry < entries.size()) {
+                    position.FileDataID = entries[position.Entry].FileDataID;
+                    _heap.push(position);
+                }
+            }
+
+            return true;
+        }
+
+        [[nodiscard]] uint32_t fileDataID() const { return _fileDataID; }
+        [[nodiscard]] std::vector<tact::CKey const*> const& contentKeys() const { return _contentKeys; }
+
+    private:
+        struct Position {
+            uint32_t FileDataID;
+            std::size_t Block;
+            std::size_t Entry;
+
+            friend bool operator > (Position const& left, Position const& right) { return left.FileDataID > right.FileDataID; }
+        };
+
+        std::vector<Root::Block> const& _blocks;
+        std::priority_queue<Position, std::vector<Position>, std::greater<Position>> _heap;
+
+        uint32_t _fileDataID = 0;
+        std::vector<tact::CKey const*> _contentKeys;
+    };
+
+    /* static */ void Root::Diff(Root const& previous, Root const& current, std::function<void(Change const&)> const& handler) {
+        EntryCursor previousCursor { previous._blocks };
+        EntryCursor currentCursor { current._blocks };
+
+        // Returns the first key of the left set that is missing from the right set.
+        auto findMissing = [](std::vector<tact::CKey const*> const& left, std::vector<tact::CKey const*> const& right) -> tact::CKey const* {
+            for (tact::CKey const* key : left)
+                if (std::ranges::none_of(right, [&](tact::CKey const* other) { return *other == *key; }))
+                    return key;
+
+            return nullptr;
+        };
+
+        bool hasPrevious = previousCursor.Next();
+        bool hasCurrent = currentCursor.Next();
+
+        while (hasPrevious || hasCurrent) {
+            if (!hasCurrent || (hasPrevious && previousCursor.fileDataID() < currentCursor.fileDataID())) {
+                handler(Change { ChangeType::Removed, previousCursor.fileDataID(), previousCursor.contentKeys().front(), nullptr });
+
+                hasPrevious = previousCursor.Next();
+            }
+            else if (!hasPrevious || currentCursor.fileDataID() < previousCursor.fileDataID()) {
+                handler(Change { ChangeType::Added, currentCursor.fileDataID(), nullptr, currentCursor.contentKeys().front() });
+
+                hasCurrent = currentCursor.Next();
+            }
+            else {
+                // The same file can be listed in multiple blocks (one per locale or platform); it is considered modified
+                // if the sets of content keys differ.
+                tact::CKey const* removedKey = findMissing(previousCursor.contentKeys(), currentCursor.contentKeys());
+                tact::CKey const* addedKey = findMissing(currentCursor.contentKeys(), previousCursor.contentKeys());
+
+                if (removedKey != nullptr || addedKey != nullptr) {
+                    handler(Change { ChangeType::Modified, currentCursor.fileDataID(),
+                        removedKey != nullptr ? removedKey : previousCursor.contentKeys().front(),
+                        addedKey != nullptr ? addedKey : currentCursor.contentKeys().front()
+                    });
+                }
+
+                hasPrevious = previousCursor.Next();
+                hasCurrent = currentCursor.Next();
+            }
+        }
+    }
+
     std::size_t Root::size() const {
         std::size_t result = 0;
         for (Block const& block : _blocks)
@@ -181,7 +289,7 @@ namespace libtactmon::tact::data::product::wow {
         for (Block const& block : _blocks) {
             // Can use binary search because we know fdids are ordered.
             auto itr = std::lower_bound(block.entries.begin(), block.entries.end(), fileDataID, [](Entry const& entry, uint32_t fdid) { return entry.FileDataID < fdid; });
-            if (itr != block.entries.end())
+            if (itr != block.entries.end() && itr->FileDataID == fileDataID)
                 return itr->ContentKey;
         }
 
@@ -189,7 +297,7 @@ namespace libtactmon::tact::data::product::wow {
     }
 
     std::optional<tact::CKey> Root::FindFile(std::string_view fileName) const {
-        uint32_t jenkinsHash = crypto::JenkinsHash(fileName);
+        uint64_t jenkinsHash = crypto::JenkinsHash(fileName);
 
         for (Block const& block : _blocks)
             for (Entry const& entry : block.entries)
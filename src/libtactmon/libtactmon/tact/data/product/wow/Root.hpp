@@ -4,6 +4,7 @@
 #include "libtactmon/tact/data/product/Product.hpp"
 
 #include <cstdint>
+#include <functional>
 #include <optional>
 #include <string_view>
 #include <vector>
@@ -50,8 +51,38 @@ namespace libtactmon::tact::data::product::wow {
             ptPT = 0x00010000,
         };
 
+        enum class ChangeType : uint8_t {
+            Added,
+            Removed,
+            Modified
+        };
+
+        /**
+         * Describes a file that differs between two root manifests.
+         */
+        struct Change {
+            ChangeType Type;
+            uint32_t FileDataID = 0;
+
+            tact::CKey const* PreviousContentKey = nullptr; //< Null if the file was added.
+            tact::CKey const* CurrentContentKey = nullptr;  //< Null if the file was removed.
+        };
+
         static std::optional<Root> Parse(io::IReadableStream& stream, std::size_t contentKeySize);
 
+        /**
+         * Computes the differences between two root manifests in a single merge pass over both of them.
+         *
+         * Memory usage is bounded by the amount of blocks in each manifest; the content keys exposed through
+         * @p handler point into the manifests, which must outlive this call.
+         *
+         * @param[in] previous The older root manifest.
+         * @param[in] current  The newer root manifest.
+         * @param[in] handler  A callable invoked, in ascending file data ID order, for every file that was added, removed,
+         *                     or whose content changed.
+         */
+        static void Diff(Root const& previous, Root const& current, std::function<void(Change const&)> const& handler);
+
     private:
         Root() = default;
 
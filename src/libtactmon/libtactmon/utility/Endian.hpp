@@ -1,8 +1,10 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <bit>
 #include <concepts>
+#include <cstring>
 
 namespace libtactmon::utility {
     template <typename To, typename From, typename = std::enable_if_t<sizeof(To) == sizeof(From)>>
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace libtactmon::utility {
+    /**
+     * Normalizes a character of a game file path: paths are case-insensitive and use either separator.
+     */
+    constexpr char normalize_path_character(char c) noexcept {
+        if (c == '\\')
+            return '/';
+
+        if (c >= 'A' && c <= 'Z')
+            return static_cast<char>(c - 'A' + 'a');
+
+        return c;
+    }
+
+    /**
+     * Determines if two game file paths designate the same file.
+     */
+    constexpr bool path_equals(std::string_view left, std::string_view right) noexcept {
+        if (left.size() != right.size())
+            return false;
+
+        for (std::size_t i = 0; i < left.size(); ++i)
+            if (normalize_path_character(left[i]) != normalize_path_character(right[i]))
+                return false;
+
+        return true;
+    }
+
+    /**
+     * Hashes a game file path (64-bit FNV-1a over its normalized characters).
+     */
+    constexpr uint64_t path_hash(std::string_view path, uint64_t seed = 0) noexcept {
+        uint64_t hash = 0xCBF29CE484222325uLL ^ seed;
+        for (char c : path) {
+            hash ^= static_cast<uint8_t>(normalize_path_character(c));
+            hash *= 0x100000001B3uLL;
+        }
+        return hash;
+    }
+}
@@ -0,0 +1,60 @@
+#include "libtactmon/utility/SingleFlight.hpp"
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+namespace libtactmon::utility {
+    template <typename Handler>
+    struct SingleFlight::HandlerWaiter final : Waiter {
+        explicit HandlerWaiter(Handler handler) : _handler(std::move(handler)) { }
+
+        void Resume() override {
+            // Completes on the handler's associated executor.
+            boost::asio::post(std::move(_handler));
+        }
+
+    private:
+        Handler _handler;
+    };
+
+    /* static */ SingleFlight& SingleFlight::Default() {
+        static SingleFlight instance;
+        return instance;
+    }
+
+    void SingleFlight::Complete(std::string_view key, std::type_index type, std::shared_ptr<Flight> const& flight) {
+        std::vector<std::unique_ptr<Waiter>> waiters;
+
+        {
+            std::lock_guard<std::mutex> guard { _lock };
+
+            auto itr = _flights.find(FlightKey { std::string { key }, type });
+            if (itr != _flights.end() && itr->second == flight)
+                _flights.erase(itr);
+
+            flight->Done = true;
+            waiters = std::move(flight->Waiters);
+        }
+
+        for (std::unique_ptr<Waiter>& waiter : waiters)
+            waiter->Resume();
+    }
+
+    boost::asio::awaitable<void> SingleFlight::Wait(std::shared_ptr<Flight> flight) {
+        auto initiation = [this, flight = std::move(flight)](auto handler) {
+            std::unique_lock<std::mutex> guard { _lock };
+
+            if (flight->Done) {
+                guard.unlock();
+
+                boost::asio::post(std::move(handler));
+                return;
+            }
+
+            flight->Waiters.push_back(std::make_unique<HandlerWaiter<decltype(handler)>>(std::move(handler)));
+        };
+
+        return boost::asio::async_initiate<decltype(boost::asio::use_awaitable) const&, void()>(std::move(initiation), boost::asio::use_awaitable);
+    }
+}
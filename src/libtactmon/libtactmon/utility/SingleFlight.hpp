@@ -0,0 +1,190 @@
+#pragma once
+
+#include "libtactmon/detail/Export.hpp"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeindex>
+#include <utility>
+#include <vector>
+
+#include <boost/asio/awaitable.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/thread/future.hpp>
+
+namespace libtactmon::utility {
+    /**
+     * Coalesces concurrent computations of the same value. The first caller to request a given key runs the computation;
+     * callers that request the same key while it is in flight wait for it and share its result instead of running their
+     * own. Once the computation completes, the key is forgotten: the next request runs it again.
+     *
+     * Computations for the same key but with different result types are distinct. Results are copied to every caller,
+     * and must thus be copyable.
+     */
+    struct LIBTACTMON_API SingleFlight final {
+        SingleFlight() = default;
+
+        SingleFlight(SingleFlight const&) = delete;
+        SingleFlight& operator = (SingleFlight const&) = delete;
+
+        /**
+         * Returns the process-wide instance.
+         */
+        static SingleFlight& Default();
+
+        /**
+         * Runs a computation, unless one is already in flight for the same key.
+         *
+         * @param[in] key      Identifies the computation.
+         * @param[in] producer A callable returning the value. Only invoked if no computation is in flight, on the calling
+         *                     thread, in which case the returned future is ready.
+         *
+         * @returns A future holding the value. If @p producer throws, so does @c get().
+         */
+        template <typename Producer>
+        auto Run(std::string_view key, Producer producer) -> boost::shared_future<std::invoke_result_t<Producer&>> {
+            using ResultType = std::invoke_result_t<Producer&>;
+
+            auto [flight, leader] = Join<ResultType>(key);
+            if (leader) {
+                LeaderGuard<ResultType> guard { *this, key, flight };
+                try {
+                    guard.SetValue(producer());
+                } catch (...) {
+                    guard.SetException(boost::current_exception());
+                }
+            }
+
+            return flight->Future;
+        }
+
+        /**
+         * Runs an asynchronous computation, unless one is already in flight for the same key. Waiting for a computation
+         * in flight does not block the calling thread.
+         *
+         * @param[in] key      Identifies the computation.
+         * @param[in] producer A callable returning an awaitable for the value. Only invoked if no computation is in flight.
+         *
+         * @returns The value. If the computation's leader is destroyed before producing it, throws
+         *          @c boost::broken_promise.
+         */
+        template <typename Producer>
+        auto RunAsync(std::string key, Producer producer) -> std::invoke_result_t<Producer&> {
+            using ResultType = typename std::invoke_result_t<Producer&>::value_type;
+
+            auto [flight, leader] = Join<ResultType>(key);
+            if (leader) {
+                // Settles the computation even if this coroutine is destroyed while suspended.
+                LeaderGuard<ResultType> guard { *this, key, flight };
+                try {
+                    guard.SetValue(co_await producer());
+                } catch (...) {
+                    guard.SetException(boost::current_exception());
+                }
+            }
+            else {
+                co_await Wait(flight);
+            }
+
+            co_return flight->Future.get();
+        }
+
+    private:
+        struct Waiter {
+            virtual ~Waiter() = default;
+
+            virtual void Resume() = 0;
+        };
+
+        template <typename Handler> struct HandlerWaiter;
+
+        struct Flight {
+            virtual ~Flight() = default;
+
+            bool Done = false;
+
+            //! Coroutines waiting for the computation to complete.
+            std::vector<std::unique_ptr<Waiter>> Waiters;
+        };
+
+        template <typename T>
+        struct TypedFlight final : Flight {
+            boost::promise<T> Promise;
+            boost::shared_future<T> Future = Promise.get_future().share();
+        };
+
+        /**
+         * Returns the computation in flight for a key, creating it if needed. The second member of the pair is true if
+         * the computation was created, in which case the caller is in charge of running it.
+         */
+        template <typename T>
+        std::pair<std::shared_ptr<TypedFlight<T>>, bool> Join(std::string_view key) {
+            std::lock_guard<std::mutex> guard { _lock };
+
+            std::shared_ptr<Flight>& flight = _flights[FlightKey { std::string { key }, typeid(T) }];
+            if (flight != nullptr)
+                return { std::static_pointer_cast<TypedFlight<T>>(flight), false };
+
+            auto typedFlight = std::make_shared<TypedFlight<T>>();
+            flight = typedFlight;
+            return { std::move(typedFlight), true };
+        }
+
+        /**
+         * Settles a computation on behalf of its leader. If the leader goes away without setting a value or an exception,
+         * the computation fails with @c boost::broken_promise, so that callers waiting for it are not left hanging. The
+         * computation is completed once the guard is destroyed.
+         */
+        template <typename T>
+        struct LeaderGuard final {
+            LeaderGuard(SingleFlight& owner, std::string_view key, std::shared_ptr<TypedFlight<T>> flight)
+                : _owner(owner), _key(key), _flight(std::move(flight))
+            { }
+
+            ~LeaderGuard() {
+                if (!_settled)
+                    _flight->Promise.set_exception(boost::copy_exception(boost::broken_promise { }));
+
+                _owner.Complete(_key, typeid(T), _flight);
+            }
+
+            LeaderGuard(LeaderGuard const&) = delete;
+            LeaderGuard& operator = (LeaderGuard const&) = delete;
+
+            void SetValue(T value) {
+                _flight->Promise.set_value(std::move(value));
+                _settled = true;
+            }
+
+            void SetException(boost::exception_ptr exception) {
+                _flight->Promise.set_exception(std::move(exception));
+                _settled = true;
+            }
+
+        private:
+            SingleFlight& _owner;
+            std::string_view _key;
+            std::shared_ptr<TypedFlight<T>> _flight;
+            bool _settled = false;
+        };
+
+        /**
+         * Forgets a computation once its value was set, and resumes coroutines waiting for it.
+         */
+        void Complete(std::string_view key, std::type_index type, std::shared_ptr<Flight> const& flight);
+
+        /**
+         * Completes once the value of a computation was set.
+         */
+        boost::asio::awaitable<void> Wait(std::shared_ptr<Flight> flight);
+
+        using FlightKey = std::pair<std::string, std::type_index>;
+
+        std::mutex _lock;
+        std::map<FlightKey, std::shared_ptr<Flight>> _flights;
+    };
+}
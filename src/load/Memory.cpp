@@ -0,0 +1,57 @@
+#include "Memory.hpp"
+
+#if defined(_WIN32)
+# include <Windows.h>
+# include <Psapi.h>
+#else
+# include <sys/resource.h>
+# include <unistd.h>
+#endif
+
+#if defined(__linux__)
+# include <fstream>
+#endif
+
+namespace load {
+    uint64_t ResidentSetSize() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters { };
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return 0;
+
+        return counters.WorkingSetSize;
+#elif defined(__linux__)
+        // Sizes are given in pages: total program size, then resident set size.
+        std::ifstream statm { "/proc/self/statm" };
+
+        uint64_t size = 0;
+        uint64_t resident = 0;
+        if (!(statm >> size >> resident))
+            return 0;
+
+        return resident * static_cast<uint64_t>(sysconf(_SC_PAGESIZE));
+#else
+        return 0;
+#endif
+    }
+
+    uint64_t PeakResidentSetSize() {
+#if defined(_WIN32)
+        PROCESS_MEMORY_COUNTERS counters { };
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+            return 0;
+
+        return counters.PeakWorkingSetSize;
+#else
+        rusage usage { };
+        if (getrusage(RUSAGE_SELF, &usage) != 0)
+            return 0;
+
+# if defined(__APPLE__)
+        return static_cast<uint64_t>(usage.ru_maxrss);
+# else
+        return static_cast<uint64_t>(usage.ru_maxrss) * 1024;
+# endif
+#endif
+    }
+}
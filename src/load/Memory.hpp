@@ -0,0 +1,15 @@
+#pragma once
+
+#include <cstdint>
+
+namespace load {
+    /**
+     * Returns the resident set size of the process, in bytes, or zero if it cannot be determined on this platform.
+     */
+    uint64_t ResidentSetSize();
+
+    /**
+     * Returns the peak resident set size of the process, in bytes.
+     */
+    uint64_t PeakResidentSetSize();
+}
@@ -0,0 +1,370 @@
+#include "Memory.hpp"
+#include "Trace.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include <boost/asio/thread_pool.hpp>
+#include <boost/program_options.hpp>
+
+#include <fmt/format.h>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include <libtactmon/ribbit/types/CDNs.hpp>
+#include <libtactmon/tact/BLTE.hpp>
+#include <libtactmon/tact/Cache.hpp>
+#include <libtactmon/tact/CKey.hpp>
+#include <libtactmon/tact/EKey.hpp>
+#include <libtactmon/tact/data/product/wow/Product.hpp>
+
+namespace po = boost::program_options;
+namespace fs = std::filesystem;
+
+using Clock = std::chrono::steady_clock;
+using Product = libtactmon::tact::data::product::wow::Product;
+
+namespace {
+    enum class LookupKind : std::size_t { FileDataID, Path, ContentKey, EncodingKey };
+
+    constexpr const std::array<std::string_view, 4> LookupNames = { "fdid", "path", "ckey", "ekey" };
+
+    /**
+     * A lookup, as written by tactmon-mkfixtures: "<kind> <value>".
+     */
+    struct Lookup {
+        LookupKind Kind;
+
+        uint32_t FileDataID = 0;
+        std::string Path;
+        std::optional<libtactmon::tact::CKey> ContentKey;
+        std::optional<libtactmon::tact::EKey> EncodingKey;
+    };
+
+    std::optional<Lookup> ParseLookup(std::string_view line) {
+        std::size_t separator = line.find(' ');
+        if (separator == std::string_view::npos)
+            return std::nullopt;
+
+        std::string_view kind = line.substr(0, separator);
+        std::string_view value = line.substr(separator + 1);
+
+        if (kind == "fdid") {
+            Lookup lookup { .Kind = LookupKind::FileDataID };
+            auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), lookup.FileDataID);
+            if (ec != std::errc { } || end != value.data() + value.size())
+                return std::nullopt;
+
+            return lookup;
+        }
+
+        if (kind == "path")
+            return Lookup { .Kind = LookupKind::Path, .Path = std::string { value } };
+
+        if (kind == "ckey") {
+            libtactmon::tact::CKey contentKey;
+            if (!libtactmon::tact::CKey::TryParse(value, contentKey))
+                return std::nullopt;
+
+            return Lookup { .Kind = LookupKind::ContentKey, .ContentKey = std::move(contentKey) };
+        }
+
+        if (kind == "ekey") {
+            libtactmon::tact::EKey encodingKey;
+            if (!libtactmon::tact::EKey::TryParse(value, encodingKey))
+                return std::nullopt;
+
+            return Lookup { .Kind = LookupKind::EncodingKey, .EncodingKey = std::move(encodingKey) };
+        }
+
+        return std::nullopt;
+    }
+
+    std::optional<std::vector<Lookup>> LoadLookups(fs::path const& path, spdlog::logger& logger) {
+        std::ifstream stream { path };
+        if (!stream) {
+            logger.error("Unable to open lookups file '{}'.", path.string());
+            return std::nullopt;
+        }
+
+        std::vector<Lookup> lookups;
+
+        std::string line;
+        for (std::size_t lineNumber = 1; std::getline(stream, line); ++lineNumber) {
+            if (!line.empty() && line.back() == '\r')
+                line.pop_back();
+
+            if (line.empty() || line.starts_with('#'))
+                continue;
+
+            std::optional<Lookup> lookup = ParseLookup(line);
+            if (!lookup.has_value()) {
+                logger.error("{}:{}: malformed lookup '{}'.", path.string(), lineNumber, line);
+                return std::nullopt;
+            }
+
+            lookups.push_back(std::move(*lookup));
+        }
+
+        return lookups;
+    }
+
+    /**
+     * Locates a file: encoding keys are located in archives, other lookups through the manifests of the product.
+     */
+    bool Locate(Product const& product, Lookup const& lookup) {
+        switch (lookup.Kind) {
+            case LookupKind::FileDataID:  return product.FindFile(lookup.FileDataID).has_value();
+            case LookupKind::Path:        return product.FindFile(std::string_view { lookup.Path }).has_value();
+            case LookupKind::ContentKey:  return static_cast<Product::Base const&>(product).FindFile(*lookup.ContentKey).has_value();
+            case LookupKind::EncodingKey: return product.FindArchive(*lookup.EncodingKey).has_value();
+        }
+
+        return false;
+    }
+
+    /**
+     * Opens and decodes a file. Encoding keys can only be located, so they are never opened.
+     */
+    std::optional<bool> Open(Product const& product, Lookup const& lookup) {
+        switch (lookup.Kind) {
+            case LookupKind::FileDataID:  return product.OpenFile(lookup.FileDataID).has_value();
+            case LookupKind::Path:        return product.OpenFile(std::string_view { lookup.Path }).has_value();
+            case LookupKind::ContentKey:  return product.OpenFile(*lookup.ContentKey).has_value();
+            case LookupKind::EncodingKey: return std::nullopt;
+        }
+
+        return std::nullopt;
+    }
+
+    struct LookupStatistics {
+        std::size_t Count = 0;
+        std::size_t Found = 0;
+        Clock::duration Elapsed { };
+    };
+
+    double Milliseconds(Clock::duration duration) {
+        return std::chrono::duration<double, std::milli>(duration).count();
+    }
+
+    double Microseconds(Clock::duration duration) {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    }
+
+    double Mebibytes(uint64_t size) {
+        return static_cast<double>(size) / (1024.0 * 1024.0);
+    }
+}
+
+int main(int argc, char** argv) {
+    po::options_description desc("Options");
+    desc.add_options()
+        ("help,h", "This help prompt.")
+
+        ("cache",         po::value<std::string>()->required(),           "Directory of the local cache the product is loaded from.")
+        ("build-config",  po::value<std::string>()->required(),           "Name of the build configuration.")
+        ("cdn-config",    po::value<std::string>()->required(),           "Name of the CDN configuration.")
+        ("product",       po::value<std::string>()->default_value("wow"), "Name of the product.")
+        ("cdn-path",      po::value<std::string>(),                       "Path of the product's files in the cache. Defaults to tpr/<product>.")
+        ("thread-count",  po::value<uint16_t>()->default_value(static_cast<uint16_t>(std::max(1u, std::thread::hardware_concurrency()))),
+                                                                          "Amount of threads archive indices are parsed on.")
+
+        ("lookups",       po::value<std::string>(),                       "File of lookups to run once the product is loaded, one per line: "
+                                                                          "'fdid <id>', 'path <path>', 'ckey <hex>' or 'ekey <hex>'.")
+        ("repeat",        po::value<std::size_t>()->default_value(1),     "Amount of times lookups are run.")
+        ("open",                                                          "Also open and decode the files looked up by FDID, path or content key.")
+        ("install-tags",  po::value<std::string>(),                       "Comma-separated install tags (e.g. 'Windows,x86_64,enUS'); the files of the "
+                                                                          "install manifest they select are opened in a single batch.")
+
+        ("trace",         po::value<std::string>(),                       "File a Chrome trace of the run is written to.")
+        ("verbose,v",                                                     "Log the progress of the product.")
+        ;
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        if (vm.count("help") != 0) {
+            std::cout << desc << '\n';
+            return EXIT_SUCCESS;
+        }
+
+        po::notify(vm);
+    } catch (po::error const& ex) {
+        std::cerr << ex.what() << '\n';
+        std::cout << desc << '\n';
+
+        return EXIT_FAILURE;
+    }
+
+    auto logger = spdlog::stdout_color_mt("load");
+
+    std::string productName = vm["product"].as<std::string>();
+
+    std::vector<Lookup> lookups;
+    if (vm.count("lookups") != 0) {
+        std::optional<std::vector<Lookup>> parsedLookups = LoadLookups(vm["lookups"].as<std::string>(), *logger);
+        if (!parsedLookups.has_value())
+            return EXIT_FAILURE;
+
+        lookups = std::move(*parsedLookups);
+    }
+
+    load::Trace trace;
+
+    boost::asio::thread_pool threadPool { vm["thread-count"].as<uint16_t>() };
+    libtactmon::tact::Cache localCache { fs::path { vm["cache"].as<std::string>() } };
+
+    Product product { productName, localCache, threadPool.get_executor(), vm.count("verbose") != 0 ? logger : nullptr };
+
+    // A CDN without hosts: every file is resolved from the local cache, and nothing is downloaded.
+    libtactmon::ribbit::types::cdns::Record cdn;
+    cdn.Name = "us";
+    cdn.Path = vm.count("cdn-path") != 0 ? vm["cdn-path"].as<std::string>() : fmt::format("tpr/{}", productName);
+    product.SetCDNs({ std::move(cdn) });
+
+    fmt::print("{:<16} {:>12} {:>12}\n", "Stage", "Time (ms)", "RSS (MiB)");
+
+    product.SetStageHandler([&](std::string_view stage, Clock::time_point start, Clock::time_point end) {
+        uint64_t residentSetSize = load::ResidentSetSize();
+        fmt::print("{:<16} {:>12.3f} {:>12.1f}\n", stage, Milliseconds(end - start), Mebibytes(residentSetSize));
+
+        trace.Complete(stage, "load", start, end);
+        trace.Counter("rss", end, residentSetSize);
+    });
+
+    Clock::time_point loadStart = Clock::now();
+    bool loaded = product.Load(vm["build-config"].as<std::string>(), vm["cdn-config"].as<std::string>());
+    Clock::time_point loadEnd = Clock::now();
+
+    trace.Complete("Load", "load", loadStart, loadEnd);
+    fmt::print("{:<16} {:>12.3f} {:>12.1f}\n", "total", Milliseconds(loadEnd - loadStart), Mebibytes(load::ResidentSetSize()));
+
+    bool succeeded = loaded;
+    if (!loaded)
+        logger->error("Unable to load build configuration '{}' from '{}'.", vm["build-config"].as<std::string>(), vm["cache"].as<std::string>());
+
+    if (loaded && !lookups.empty()) {
+        std::array<LookupStatistics, LookupNames.size()> located { };
+        std::array<LookupStatistics, LookupNames.size()> opened { };
+
+        std::size_t repeatCount = vm["repeat"].as<std::size_t>();
+        for (std::size_t i = 0; i < repeatCount; ++i) {
+            Clock::time_point passStart = Clock::now();
+            for (Lookup const& lookup : lookups) {
+                LookupStatistics& statistics = located[static_cast<std::size_t>(lookup.Kind)];
+
+                Clock::time_point start = Clock::now();
+                bool found = Locate(product, lookup);
+                statistics.Elapsed += Clock::now() - start;
+
+                ++statistics.Count;
+                if (found)
+                    ++statistics.Found;
+            }
+
+            trace.Complete("lookups", "lookups", passStart, Clock::now());
+            trace.Counter("rss", Clock::now(), load::ResidentSetSize());
+
+            if (vm.count("open") == 0)
+                continue;
+
+            passStart = Clock::now();
+            for (Lookup const& lookup : lookups) {
+                LookupStatistics& statistics = opened[static_cast<std::size_t>(lookup.Kind)];
+
+                Clock::time_point start = Clock::now();
+                std::optional<bool> found = Open(product, lookup);
+                statistics.Elapsed += Clock::now() - start;
+
+                if (!found.has_value())
+                    continue;
+
+                ++statistics.Count;
+                if (*found)
+                    ++statistics.Found;
+            }
+
+            trace.Complete("open", "lookups", passStart, Clock::now());
+            trace.Counter("rss", Clock::now(), load::ResidentSetSize());
+        }
+
+        fmt::print("\n{:<16} {:>8} {:>8} {:>12}\n", "Lookup", "Count", "Found", "Avg (us)");
+
+        auto report = [&](std::string_view operation, std::array<LookupStatistics, LookupNames.size()> const& statistics) {
+            for (std::size_t kind = 0; kind < statistics.size(); ++kind) {
+                LookupStatistics const& entry = statistics[kind];
+                if (entry.Count == 0)
+                    continue;
+
+                fmt::print("{:<16} {:>8} {:>8} {:>12.3f}\n", fmt::format("{} {}", operation, LookupNames[kind]),
+                    entry.Count, entry.Found, Microseconds(entry.Elapsed) / static_cast<double>(entry.Count));
+
+                if (entry.Found != entry.Count)
+                    succeeded = false;
+            }
+        };
+
+        report("find", located);
+        report("open", opened);
+    }
+
+    if (loaded && vm.count("install-tags") != 0) {
+        std::string const& tagList = vm["install-tags"].as<std::string>();
+
+        std::vector<std::string_view> tagNames;
+        for (std::size_t start = 0; start <= tagList.size(); ) {
+            std::size_t end = std::min(tagList.find(',', start), tagList.size());
+            if (end != start)
+                tagNames.push_back(std::string_view { tagList }.substr(start, end - start));
+
+            start = end + 1;
+        }
+
+        std::vector<libtactmon::tact::CKey> contentKeys;
+        bool selected = product.install().has_value() && product.install()->ForEachFile(tagNames, [&](std::string_view, libtactmon::tact::CKey const& contentKey, std::size_t) {
+            contentKeys.push_back(contentKey);
+        });
+
+        if (!selected) {
+            logger->error("Unable to select install files tagged '{}'.", tagList);
+            succeeded = false;
+        } else {
+            // The calling thread is not one of the product's, as OpenFiles requires.
+            Clock::time_point start = Clock::now();
+            std::vector<std::optional<libtactmon::tact::BLTE>> files = product.OpenFiles(contentKeys);
+            Clock::time_point end = Clock::now();
+
+            trace.Complete("install", "lookups", start, end);
+
+            std::size_t found = std::count_if(files.begin(), files.end(), [](auto const& file) { return file.has_value(); });
+            fmt::print("\n{:<16} {:>8} {:>8} {:>12}\n", "Install set", "Count", "Found", "Time (ms)");
+            fmt::print("{:<16} {:>8} {:>8} {:>12.3f}\n", "open", files.size(), found, Milliseconds(end - start));
+
+            if (found != files.size())
+                succeeded = false;
+        }
+    }
+
+    fmt::print("\nPeak RSS: {:.1f} MiB\n", Mebibytes(load::PeakResidentSetSize()));
+
+    if (vm.count("trace") != 0 && !trace.Write(vm["trace"].as<std::string>())) {
+        logger->error("Unable to write trace to '{}'.", vm["trace"].as<std::string>());
+        succeeded = false;
+    }
+
+    return succeeded ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,33 @@
+#include "Trace.hpp"
+
+#include <fstream>
+
+#include <fmt/format.h>
+
+namespace load {
+    void Trace::Complete(std::string_view name, std::string_view category, Clock::time_point start, Clock::time_point end) {
+        _events.push_back(fmt::format(R"({{"name":"{}","cat":"{}","ph":"X","ts":{},"dur":{},"pid":1,"tid":1}})",
+            name, category, Timestamp(start), Timestamp(end) - Timestamp(start)));
+    }
+
+    void Trace::Counter(std::string_view name, Clock::time_point at, uint64_t value) {
+        _events.push_back(fmt::format(R"({{"name":"{0}","ph":"C","ts":{1},"pid":1,"args":{{"{0}":{2}}}}})",
+            name, Timestamp(at), value));
+    }
+
+    bool Trace::Write(std::filesystem::path const& path) const {
+        std::ofstream stream { path, std::ios::binary | std::ios::trunc };
+
+        stream << R"({"displayTimeUnit":"ms","traceEvents":[)";
+        for (std::size_t i = 0; i < _events.size(); ++i)
+            stream << (i == 0 ? "\n" : ",\n") << _events[i];
+        stream << "\n]}\n";
+
+        return static_cast<bool>(stream);
+    }
+
+    int64_t Trace::Timestamp(Clock::time_point at) const {
+        // Timestamps are in microseconds.
+        return std::chrono::duration_cast<std::chrono::microseconds>(at - _origin).count();
+    }
+}
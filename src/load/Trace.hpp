@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace load {
+    /**
+     * Collects events in the Chrome trace event format, which chrome://tracing and Perfetto display as a timeline.
+     *
+     * Names are written as is; they must not need escaping.
+     */
+    struct Trace final {
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * Records an operation that ran between two points in time.
+         */
+        void Complete(std::string_view name, std::string_view category, Clock::time_point start, Clock::time_point end);
+
+        /**
+         * Records the value of a counter at a point in time.
+         */
+        void Counter(std::string_view name, Clock::time_point at, uint64_t value);
+
+        /**
+         * Writes every recorded event to a JSON file.
+         *
+         * @returns false if the file could not be written.
+         */
+        bool Write(std::filesystem::path const& path) const;
+
+    private:
+        int64_t Timestamp(Clock::time_point at) const;
+
+        Clock::time_point _origin = Clock::now();
+        std::vector<std::string> _events;
+    };
+}
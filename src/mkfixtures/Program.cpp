@@ -0,0 +1,135 @@
+#include "fixtures/Generator.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <optional>
+#include <string>
+
+#include <boost/program_options.hpp>
+
+#include <spdlog/sinks/stdout_color_sinks.h>
+#include <spdlog/spdlog.h>
+
+#include <libtactmon/tact/Cache.hpp>
+
+namespace po = boost::program_options;
+namespace fs = std::filesystem;
+
+namespace {
+    std::optional<fixtures::ChunkMode> ParseChunkMode(std::string const& value) {
+        if (value == "none")
+            return fixtures::ChunkMode::None;
+        if (value == "zlib")
+            return fixtures::ChunkMode::Zlib;
+        if (value == "frame")
+            return fixtures::ChunkMode::Frame;
+        if (value == "mixed")
+            return fixtures::ChunkMode::Mixed;
+
+        return std::nullopt;
+    }
+}
+
+int main(int argc, char** argv) {
+    po::options_description desc("Options");
+    desc.add_options()
+        ("help,h", "This help prompt.")
+
+        ("root",              po::value<std::string>()->required(),            "Directory the build is written to, laid out like tactmon's cache.")
+        ("product",           po::value<std::string>()->default_value("wow"),  "Name of the product; files are written under tpr/<product>.")
+        ("build-id",          po::value<uint32_t>()->default_value(1),         "Build ID advertised by the Ribbit versions table.")
+        ("seed",              po::value<uint64_t>()->default_value(0),         "Seed of the generator; the same options always produce the same build.")
+
+        ("files",             po::value<std::size_t>()->default_value(10'000), "Amount of files listed by the encoding and root manifests.")
+        ("materialized",      po::value<std::size_t>()->default_value(1'000), "Amount of files whose contents are written to disk. Other files are listed, "
+                                                                               "but cannot be opened.")
+        ("loose",             po::value<std::size_t>()->default_value(16),     "Amount of materialized files stored outside of archives.")
+        ("archives",          po::value<std::size_t>()->default_value(16),     "Amount of archives, and archive indices.")
+        ("install-files",     po::value<std::size_t>()->default_value(100),    "Amount of files listed by the install manifest.")
+        ("named-ratio",       po::value<double>()->default_value(0.75),        "Proportion of the files of the root manifest that have a name hash.")
+        ("min-size",          po::value<std::size_t>()->default_value(64),     "Minimum size of a file, in bytes.")
+        ("max-size",          po::value<std::size_t>()->default_value(65'536), "Maximum size of a file, in bytes.")
+        ("root-block-size",   po::value<std::size_t>()->default_value(0),      "Maximum amount of files in a root block; zero is unbounded.")
+        ("encoding-page-size", po::value<uint16_t>()->default_value(4),        "Size of the pages of the encoding manifest, in kilobytes.")
+
+        ("chunk-size",        po::value<std::size_t>()->default_value(16'384), "Size of the BLTE chunks of files, before encoding.")
+        ("chunk-mode",        po::value<std::string>()->default_value("mixed"), "Encoding of the BLTE chunks of files: none, zlib, frame, or mixed.")
+        ("compression-level", po::value<int>()->default_value(6),              "Compression level of deflated chunks.")
+
+        ("lookups",           po::value<std::string>(),                        "File that a sample of materialized files is written to, one lookup per line.")
+        ("lookup-count",      po::value<std::size_t>()->default_value(100),    "Amount of files sampled.")
+        ;
+
+    po::variables_map vm;
+    try {
+        po::store(po::parse_command_line(argc, argv, desc), vm);
+        if (vm.count("help") != 0) {
+            std::cout << desc << '\n';
+            return EXIT_SUCCESS;
+        }
+
+        po::notify(vm);
+    } catch (po::error const& ex) {
+        std::cerr << ex.what() << '\n';
+        std::cout << desc << '\n';
+
+        return EXIT_FAILURE;
+    }
+
+    auto logger = spdlog::stdout_color_mt("mkfixtures");
+
+    std::optional<fixtures::ChunkMode> chunkMode = ParseChunkMode(vm["chunk-mode"].as<std::string>());
+    if (!chunkMode.has_value()) {
+        logger->error("Unknown chunk mode '{}'.", vm["chunk-mode"].as<std::string>());
+        return EXIT_FAILURE;
+    }
+
+    fixtures::Generator::Options options {
+        .Product = vm["product"].as<std::string>(),
+        .BuildID = vm["build-id"].as<uint32_t>(),
+        .Seed = vm["seed"].as<uint64_t>(),
+        .FileCount = vm["files"].as<std::size_t>(),
+        .MaterializedFileCount = vm["materialized"].as<std::size_t>(),
+        .LooseFileCount = vm["loose"].as<std::size_t>(),
+        .ArchiveCount = vm["archives"].as<std::size_t>(),
+        .InstallFileCount = vm["install-files"].as<std::size_t>(),
+        .NamedRatio = vm["named-ratio"].as<double>(),
+        .MinFileSize = vm["min-size"].as<std::size_t>(),
+        .MaxFileSize = vm["max-size"].as<std::size_t>(),
+        .RootBlockSize = vm["root-block-size"].as<std::size_t>(),
+        .EncodingPageSizeKB = vm["encoding-page-size"].as<uint16_t>(),
+        .LookupCount = vm["lookup-count"].as<std::size_t>(),
+    };
+    options.Files.ChunkSize = vm["chunk-size"].as<std::size_t>();
+    options.Files.Mode = *chunkMode;
+    options.Files.CompressionLevel = vm["compression-level"].as<int>();
+
+    libtactmon::tact::Cache cache { fs::path { vm["root"].as<std::string>() } };
+
+    auto start = std::chrono::steady_clock::now();
+    std::optional<fixtures::Generator::Result> result = fixtures::Generator::Generate(cache, options, *logger);
+    if (!result.has_value())
+        return EXIT_FAILURE;
+
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    logger->info("Wrote {} files ({} bytes) in {:.3} seconds.", result->FileCount, result->ByteCount, elapsed.count());
+    logger->info("Build configuration: {}", result->BuildConfig);
+    logger->info("CDN configuration: {}", result->CDNConfig);
+
+    if (vm.count("lookups") != 0) {
+        std::ofstream lookups { vm["lookups"].as<std::string>() };
+        for (std::string const& lookup : result->Lookups)
+            lookups << lookup << '\n';
+
+        if (!lookups) {
+            logger->error("Unable to write lookups to '{}'.", vm["lookups"].as<std::string>());
+            return EXIT_FAILURE;
+        }
+    }
+
+    return EXIT_SUCCESS;
+}
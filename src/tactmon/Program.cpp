@@ -18,10 +18,14 @@
 #include <csignal>
 #include <filesystem>
 #include <memory>
+#include <optional>
+#include <span>
+#include <string>
 #include <string_view>
 #include <thread>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <assert.hpp>
 
@@ -36,7 +40,10 @@
 #include <fmt/format.h>
 #include <fmt/ranges.h>
 
+#include <libtactmon/net/HostOverrides.hpp>
 #include <libtactmon/ribbit/Commands.hpp>
+#include <libtactmon/ribbit/MultiRegion.hpp>
+#include <libtactmon/ribbit/ResponseCache.hpp>
 #include <libtactmon/ribbit/types/Versions.hpp>
 #include <libtactmon/tact/data/product/wow/Product.hpp>
 
@@ -74,6 +81,10 @@ int main(int argc, char** argv) {
         ("http-document-root",   po::value<std::string>()->required(),       "A document root that will be used when generating download links to files.")
 
         ("thread-count",         po::value<uint16_t>()->default_value(std::thread::hardware_concurrency() * 2), "Amount of general purpose threads.")
+
+        ("host-override",        po::value<std::vector<std::string>>()->composing(), "Redirects connections to Blizzard services, as "
+                                                                             "'host:port=target:port' (host and port may be '*'). "
+                                                                             "May be repeated.")
         ;
 
     try {
@@ -93,6 +104,14 @@ int main(int argc, char** argv) {
 }
 
 void Execute(boost::program_options::variables_map vm) {
+    // 0. Redirect Blizzard services if asked to (typically to tactmon-fakecdn).
+    if (vm.count("host-override") != 0) {
+        for (std::string const& rule : vm["host-override"].as<std::vector<std::string>>()) {
+            if (!libtactmon::net::HostOverrides::Default().Parse(rule))
+                throw po::error(fmt::format("invalid host override '{}'", rule));
+        }
+    }
+
     // 1. General application context.
     utility::ThreadPool threadPool { vm["thread-count"].as<uint16_t>() };
     for (std::size_t i = 0; i < threadPool.size(); ++i)
@@ -115,14 +134,39 @@ void Execute(boost::program_options::variables_map vm) {
     libtactmon::tact::Cache localCache { cacheRoot };
     backend::ProductCache productCache { threadPool.executor() };
 
+    // Community listfile, used to resolve paths that are unknown to the install manifest. Prefer the persisted index over
+    // the CSV, and persist the latter once it has been indexed.
+    namespace wow = tact::data::product::wow;
+    std::shared_ptr<const wow::Listfile> listfile = [&localCache]() -> std::shared_ptr<const wow::Listfile> {
+        std::optional<wow::Listfile> listfile = localCache.Resolve("listfile.idx", [](libtactmon::io::FileStream& fstream) {
+            return wow::Listfile::Load(fstream);
+        });
+
+        if (!listfile.has_value()) {
+            listfile = localCache.Resolve("listfile.csv", [](libtactmon::io::FileStream& fstream) {
+                return wow::Listfile::Parse(fstream);
+            });
+
+            if (listfile.has_value())
+                listfile->Save(localCache.GetAbsolutePath("listfile.idx"));
+        }
+
+        if (!listfile.has_value())
+            return nullptr;
+
+        return std::make_shared<const wow::Listfile>(std::move(*listfile));
+    }();
+    productCache.SetListfile(listfile);
+
     constexpr static const std::string_view WOW_PRODUCTS[] = { "wow", "wow_beta", "wow_classic", "wow_classic_beta", "wow_classic_ptr" };
     for (std::string_view gameProduct : WOW_PRODUCTS) {
-        productCache.RegisterFactory(std::string { gameProduct }, [&localCache, gameProduct, &threadPool]() -> backend::Product {
-            return backend::Product {
-                std::make_shared<libtactmon::tact::data::product::wow::Product>(
-                    gameProduct, localCache, threadPool.executor(), utility::logging::GetAsyncLogger(gameProduct)
-                )
-            };
+        productCache.RegisterFactory(std::string { gameProduct }, [&localCache, gameProduct, &threadPool, listfile]() -> backend::Product {
+            auto product = std::make_shared<libtactmon::tact::data::product::wow::Product>(
+                gameProduct, localCache, threadPool.executor(), utility::logging::GetAsyncLogger(gameProduct)
+            );
+            product->SetListfile(listfile);
+
+            return backend::Product { product };
         });
     }
 
@@ -171,8 +215,11 @@ void Execute(boost::program_options::variables_map vm) {
         if (!productCache.IsAwareOf(productName))
             return;
 
-        auto versions = ribbit::Versions<>::Execute(threadPool.executor(), nullptr, ribbit::Region::US, productName);
-        auto cdns = ribbit::CDNs<>::Execute(threadPool.executor(), nullptr, ribbit::Region::US, productName);
+        // Each region is authoritative for its own builds.
+        auto versions = ribbit::Merge(std::span<const ribbit::RegionalResponse<ribbit::types::Versions>> {
+            ribbit::ExecuteAll<ribbit::Versions<>>(ribbit::AllRegions, ribbit::DefaultTimeout, nullptr, productName)
+        });
+        auto cdns = ribbit::ResponseCache::Default().Execute<ribbit::CDNs<>>(threadPool.executor(), nullptr, ribbit::Region::US, productName);
         if (!versions.has_value() || !cdns.has_value())
             return;
 
@@ -14,6 +14,8 @@
 #include <boost/asio/high_resolution_timer.hpp>
 #include <boost/container/stable_vector.hpp>
 
+#include <libtactmon/tact/data/product/wow/Listfile.hpp>
+
 namespace backend {
     using namespace std::chrono_literals;
 
@@ -57,6 +59,17 @@ namespace backend {
 
         bool IsAwareOf(std::string const& productName) const;
 
+        /**
+         * Sets the community listfile shared by World of Warcraft products. It is used to suggest file paths, and does not
+         * depend on any build being loaded.
+         */
+        void SetListfile(std::shared_ptr<const libtactmon::tact::data::product::wow::Listfile> listfile) { _listfile = std::move(listfile); }
+
+        /**
+         * Returns the community listfile, if any.
+         */
+        [[nodiscard]] std::shared_ptr<const libtactmon::tact::data::product::wow::Listfile> const& listfile() const { return _listfile; }
+
     private:
         void RemoveExpiredEntries();
 
@@ -70,5 +83,6 @@ namespace backend {
         boost::asio::high_resolution_timer _cacheExpiryTimer; //< Executes every minute.
         std::list<std::shared_ptr<Record>> _products; //< Currently managed products
         std::unordered_map<std::string, std::function<Product()>> _productFactories; //< Functions that instanciate product managers.
+        std::shared_ptr<const libtactmon::tact::data::product::wow::Listfile> _listfile;
     };
 }
@@ -3,14 +3,22 @@
 
 #include <chrono>
 #include <optional>
+#include <span>
+#include <utility>
+
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+#include <boost/asio/use_awaitable.hpp>
 
 #include <libtactmon/ribbit/Commands.hpp>
+#include <libtactmon/ribbit/MultiRegion.hpp>
+#include <libtactmon/ribbit/ResponseCache.hpp>
 #include <libtactmon/ribbit/types/Summary.hpp>
 
 namespace ribbit = libtactmon::ribbit;
 
 namespace backend {
-    RibbitMonitor::RibbitMonitor(boost::asio::any_io_executor executor, backend::Database& db) : _database(db), _executor(std::move(executor)), _timer(executor)
+    RibbitMonitor::RibbitMonitor(boost::asio::any_io_executor executor, backend::Database& db) : _database(db), _executor(std::move(executor)), _timer(_executor)
     {
     }
 
@@ -22,7 +30,8 @@ namespace backend {
 
         _timer.expires_at(std::chrono::high_resolution_clock::now() + 60s);
         _timer.async_wait([=](boost::system::error_code ec) {
-            this->OnUpdate(ec);
+            if (ec == boost::asio::error::operation_aborted)
+                return;
 
             this->BeginUpdate();
         });
@@ -32,11 +41,22 @@ namespace backend {
         if (ec == boost::asio::error::operation_aborted)
             return;
 
-        auto summary = ribbit::Summary<>::Execute(_executor, nullptr, ribbit::Region::US);
-        if (!summary.has_value())
-            return;
+        // Every region is polled at once; a round takes at most the timeout of a single request.
+        boost::asio::co_spawn(_executor, [this]() -> boost::asio::awaitable<void> {
+            auto responses = co_await ribbit::ExecuteAllAsync<ribbit::Summary<>>(ribbit::AllRegions, ribbit::DefaultTimeout, nullptr);
+            for (ribbit::RegionalResponse<ribbit::types::Summary> const& response : responses) {
+                if (response.Value.has_value())
+                    ribbit::ResponseCache::Default().Update(response.Origin, *response.Value);
+            }
+
+            std::optional<ribbit::types::Summary> summary = ribbit::Merge(std::span<const ribbit::RegionalResponse<ribbit::types::Summary>> { responses });
+            if (summary.has_value())
+                ProcessSummary(*summary);
+        }, boost::asio::detached);
+    }
 
-        for (ribbit::types::summary::Record const& record : summary.value()) {
+    void RibbitMonitor::ProcessSummary(ribbit::types::Summary const& summary) {
+        for (ribbit::types::summary::Record const& record : summary) {
             if (!record.Flags.empty())
                 continue;
 
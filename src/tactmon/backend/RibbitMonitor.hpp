@@ -14,6 +14,8 @@
 #include <boost/asio/io_service.hpp>
 #include <boost/system/error_code.hpp>
 
+#include <libtactmon/ribbit/types/Summary.hpp>
+
 namespace backend {
     struct RibbitMonitor final {
         enum class ProductState : uint8_t {
@@ -31,6 +33,7 @@ namespace backend {
 
     private:
         void OnUpdate(boost::system::error_code ec);
+        void ProcessSummary(libtactmon::ribbit::types::Summary const& summary);
         void NotifyProductUpdate(std::string const& productName, uint32_t sequenceID) const;
         void NotifyProductDeleted(std::string const& productName, uint32_t sequenceID) const;
 
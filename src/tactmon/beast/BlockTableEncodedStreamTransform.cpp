@@ -77,13 +77,15 @@ namespace boost::beast::user {
                         return size;
 
                     ChunkInfo& chunkInfo = _chunks[_step - Step::DataBlocks];
-                    if (!_ms.CanRead(chunkInfo.compressedSize))
+                    if (!_ms.CanRead(chunkInfo.compressedSize + 1))
                         return size;
 
-                    // Compute chunk MD5 and validate
+                    // Compute chunk MD5 (over the encoding mode and the payload) and validate
                     libtactmon::crypto::MD5::Digest chunkDigest = [&]() {
                         libtactmon::crypto::MD5 chunkEngine;
-                        chunkEngine.UpdateData(_ms.Data().subspan(0, chunkInfo.compressedSize));
+                        _ms.ForEachSegment(chunkInfo.compressedSize + 1, [&](std::span<const std::byte> segment) {
+                            chunkEngine.UpdateData(segment);
+                        });
                         chunkEngine.Finalize();
 
                         return chunkEngine.GetDigest();
@@ -100,7 +102,9 @@ namespace boost::beast::user {
                     {
                         case 'N':
                         {
-                            _handler(_ms.Data<uint8_t>().subspan(0, chunkInfo.compressedSize));
+                            _ms.ForEachSegment(chunkInfo.compressedSize, [&](std::span<const std::byte> segment) {
+                                _handler(std::span { reinterpret_cast<uint8_t const*>(segment.data()), segment.size() });
+                            });
                             _ms.SkipRead(chunkInfo.compressedSize);
                             break;
                         }
@@ -119,23 +123,27 @@ namespace boost::beast::user {
                                 return size;
                             }
 
-                            strm.avail_in = chunkInfo.compressedSize;
-                            strm.next_in = const_cast<uint8_t*>(_ms.Data<uint8_t>().data());
-
+                            // The compressed data may span several pages; feed them to zlib one at a time.
                             std::array<uint8_t, 8192> decompressedBuffer;
-                            while (ret != Z_STREAM_END && strm.avail_in != 0) {
-                                strm.avail_out = decompressedBuffer.size();
-                                strm.next_out = decompressedBuffer.data();
+                            _ms.ForEachSegment(chunkInfo.compressedSize, [&](std::span<const std::byte> segment) {
+                                strm.avail_in = static_cast<uInt>(segment.size());
+                                strm.next_in = reinterpret_cast<Bytef*>(const_cast<std::byte*>(segment.data()));
 
-                                ret = inflate(&strm, Z_NO_FLUSH);
-                                if (ret < 0) {
-                                    ret = inflateEnd(&strm);
+                                while (ret != Z_STREAM_END && ret >= 0 && strm.avail_in != 0) {
+                                    strm.avail_out = decompressedBuffer.size();
+                                    strm.next_out = decompressedBuffer.data();
 
-                                    ec = boost::beast::http::error::bad_alloc;
-                                    return size;
+                                    ret = inflate(&strm, Z_NO_FLUSH);
+                                    if (ret >= 0)
+                                        _handler(std::span<uint8_t const> { decompressedBuffer.data(), decompressedBuffer.size() - strm.avail_out });
                                 }
+                            });
+
+                            if (ret < 0) {
+                                inflateEnd(&strm);
 
-                                _handler(std::span<uint8_t const> { decompressedBuffer.data(), decompressedBuffer.size() - strm.avail_out });
+                                ec = boost::beast::http::error::bad_alloc;
+                                return size;
                             }
 
                             ret = inflateEnd(&strm);
@@ -147,7 +155,10 @@ namespace boost::beast::user {
                             // Nested BLTE stream
                             // Forward the output handler, but ignore the input feedback, since it's already handled by the block content parser.
                             BlockTableEncodedStreamTransform nestedReader { _handler, [](std::size_t) { } };
-                            nestedReader.Parse(_ms.Data<uint8_t>().data(), chunkInfo.compressedSize, ec);
+                            _ms.ForEachSegment(chunkInfo.compressedSize, [&](std::span<const std::byte> segment) {
+                                if (!ec.failed())
+                                    nestedReader.Parse(reinterpret_cast<uint8_t const*>(segment.data()), segment.size(), ec);
+                            });
                             _ms.SkipRead(chunkInfo.compressedSize);
                             break;
                         }
@@ -159,7 +170,8 @@ namespace boost::beast::user {
                         }
                     }
 
-                    // Move to the next block.
+                    // Move to the next block, handing the pages of this one back to the pool.
+                    _ms.Compact();
                     _step = static_cast<Step>(static_cast<uint32_t>(_step) + 1);
                     break;
                 }
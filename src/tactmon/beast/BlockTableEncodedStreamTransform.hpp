@@ -10,7 +10,7 @@
 #include <boost/beast/core/error.hpp>
 
 #include <libtactmon/crypto/Hash.hpp>
-#include <libtactmon/io/MemoryStream.hpp>
+#include <libtactmon/io/PagedMemoryStream.hpp>
 
 namespace boost::beast::user {
     struct BlockTableEncodedStreamTransform final : std::enable_shared_from_this<BlockTableEncodedStreamTransform> {
@@ -47,7 +47,7 @@ namespace boost::beast::user {
         uint32_t _headerSize = 0;
         OutputHandler _handler;
         InputFeedback _feedback;
-        libtactmon::io::GrowableMemoryStream _ms;
+        libtactmon::io::PagedMemoryStream _ms;
         libtactmon::crypto::MD5 _engine;
     };
 }
@@ -24,7 +24,9 @@ namespace frontend::commands {
                 .set_auto_complete(false)
             ).add_option(dpp::command_option(dpp::command_option_type::co_string, "version", "The version of the game for which you want to download a file.", true)
                 .set_auto_complete(true)
-            ).add_option(dpp::command_option(dpp::command_option_type::co_string, "file", "Complete path to the file you want to download.", true));
+            ).add_option(dpp::command_option(dpp::command_option_type::co_string, "file", "Complete path to the file you want to download.", true)
+                .set_auto_complete(true)
+            );
     }
 
     bool DownloadCommand::Matches(dpp::interaction const& evnt) const {
@@ -13,6 +13,10 @@ namespace product = entity::product;
 namespace tracked_file = entity::tracked_file;
 
 namespace frontend::commands {
+    // Discord rejects autocompletion replies with more choices than this, or with longer choices.
+    constexpr static const std::size_t MaxAutoCompleteChoices = 25;
+    constexpr static const std::size_t MaxAutoCompleteChoiceLength = 100;
+
     bool ICommand::OnSlashCommand(dpp::slashcommand_t const& evnt, frontend::Discord& cluster) {
         if (!Matches(evnt.command))
             return false;
@@ -80,6 +84,9 @@ namespace frontend::commands {
         while (drillDown && !eopts.empty()) {
             dpp::command_data_option current = eopts.front();
 
+            // Record the sub-command leading to the focused option, so that handlers can tell them apart.
+            context.values.emplace(current.name, dpp::command_value { });
+
             for (const auto& eopt : current.options) {
                 if (eopt.focused) {
                     focusedName = eopt.name;
@@ -171,7 +178,31 @@ namespace frontend::commands {
             return true;
         }
 
-        if (name == "filepath" && context.has("add")) {
+        // Paths are suggested from the community listfile; they are normalized (lowercase, forward slashes), which every
+        // path lookup accepts.
+        if ((name == "filepath" && context.has("add")) || name == "file") {
+            std::string optionValue = std::get<std::string>(value);
+            std::shared_ptr<const libtactmon::tact::data::product::wow::Listfile> const& listfile = cluster.productManager.listfile();
+            if (optionValue.empty() || listfile == nullptr)
+                return false;
+
+            std::size_t suggestionCount = 0;
+            dpp::interaction_response interactionResponse{ dpp::ir_autocomplete_reply };
+            listfile->ForEachFile(optionValue, [&](std::string_view filePath, uint32_t) {
+                if (filePath.size() > MaxAutoCompleteChoiceLength)
+                    return true;
+
+                ++suggestionCount;
+                interactionResponse.add_autocomplete_choice(dpp::command_option_choice(std::string { filePath }, std::string { filePath }));
+                return suggestionCount < MaxAutoCompleteChoices;
+            });
+
+            cluster.bot.interaction_response_create_sync(context.evnt.command.id, context.evnt.command.token, interactionResponse);
+            return true;
+        }
+
+        // Only tracked files can be removed.
+        if (name == "filepath" && context.has("remove")) {
             std::string optionValue = std::get<std::string>(value);
             if (optionValue.empty())
                 return false;
@@ -195,7 +226,7 @@ namespace frontend::commands {
 
                     ++suggestionCount;
                     interactionResponse.add_autocomplete_choice(dpp::command_option_choice(displayName, filePath));
-                    if (suggestionCount >= 100)
+                    if (suggestionCount >= MaxAutoCompleteChoices)
                         break;
                 }
             });
@@ -20,7 +20,7 @@ namespace frontend::commands {
                     .add_option(
                         dpp::command_option(dpp::co_sub_command, "add", "Tracks a specific file for a given product.")
                             .add_option(dpp::command_option(dpp::co_string, "product", "The name of the product.", true).set_auto_complete(true))
-                            .add_option(dpp::command_option(dpp::co_string, "filepath", "Absolute path to the file.", true))
+                            .add_option(dpp::command_option(dpp::co_string, "filepath", "Absolute path to the file.", true).set_auto_complete(true))
                             .add_option(dpp::command_option(dpp::co_string, "displayname", "Name to display for this file.", false))
                     )
                     .add_option(
@@ -2,7 +2,9 @@
 #include "net/Session.hpp"
 #include "utility/ThreadPool.hpp"
 
+#include <array>
 #include <chrono>
+#include <ranges>
 #include <string>
 #include <string_view>
 
@@ -14,7 +16,9 @@
 #include <boost/thread/future.hpp>
 
 #include <libtactmon/detail/Tokenizer.hpp>
+#include <libtactmon/net/HostOverrides.hpp>
 #include <libtactmon/ribbit/Commands.hpp>
+#include <libtactmon/ribbit/ResponseCache.hpp>
 #include <libtactmon/ribbit/types/CDNs.hpp>
 
 using namespace std::chrono_literals;
@@ -88,11 +92,17 @@ namespace net {
         if (request.get().target().find('\\') != std::string::npos)
             return writeError(http::status::bad_request, "Don't try to exploit me");
 
-        std::vector<std::string_view> tokens = libtactmon::detail::Tokenize(std::string_view { request.get().target() }, '/', false);
-        if (!tokens.empty())
-            tokens.erase(tokens.begin());
+        // /<product>/<archive>/<offset>/<length>/<size>/<file name>
+        std::array<std::string_view, 6> tokens;
+        std::size_t tokenCount = 0;
+        for (std::string_view token : libtactmon::detail::Split(std::string_view { request.get().target() }, '/', false) | std::views::drop(1)) {
+            if (tokenCount < tokens.size())
+                tokens[tokenCount] = token;
 
-        if (tokens.size() != 6)
+            ++tokenCount;
+        }
+
+        if (tokenCount != tokens.size())
             return writeError(http::status::bad_request, "Malformed request");
 
         FileQueryParams params;
@@ -115,7 +125,7 @@ namespace net {
 
         params.FileName = tokens[5];
 
-        auto cdns = ribbit::CDNs<>::Execute(_stream.get_executor(), nullptr, ribbit::Region::US, params.Product);
+        auto cdns = ribbit::ResponseCache::Default().Execute<ribbit::CDNs<>>(_stream.get_executor(), nullptr, ribbit::Region::US, params.Product);
         if (!cdns.has_value()) {
             return writeError(http::status::not_found,
                 "Unable to resolve CDN configuration.\r\n"
@@ -156,7 +166,8 @@ namespace net {
 
         for (auto& [cdn, remotePath] : availableRemoteArchives) {
             beast::tcp_stream remoteStream { _stream.get_executor() };
-            remoteStream.connect(resolver.resolve(cdn, "80"), ec);
+            libtactmon::net::Endpoint endpoint = libtactmon::net::HostOverrides::Default().Resolve(cdn, "80");
+            remoteStream.connect(resolver.resolve(endpoint.Host, endpoint.Service), ec);
             if (ec.failed())
                 continue;
 
@@ -218,7 +229,8 @@ namespace net {
 
                     boost::asio::ip::tcp::resolver resolver(strand);
                     beast::tcp_stream remoteStream(strand);
-                    remoteStream.connect(resolver.resolve(host, "80"), ec);
+                    libtactmon::net::Endpoint endpoint = libtactmon::net::HostOverrides::Default().Resolve(host, "80");
+                    remoteStream.connect(resolver.resolve(endpoint.Host, endpoint.Service), ec);
                     if (ec.failed())
                         return std::nullopt;
 